@@ -17,6 +17,9 @@
 
 #include <application_thread.h>
 #include <state_notifier.h>
+#if defined(CONFIG_SIDEWALK_DFU_ADV_SET)
+#include <nordic_dfu.h>
+#endif
 
 static struct k_thread application_thread;
 
@@ -57,6 +60,10 @@ static void sidewalk_app_entry(void *ctx, void *unused, void *unused2)
 		application_state_error(&global_state_notifier, true);
 		return;
 	}
+#if defined(CONFIG_SIDEWALK_DFU_ADV_SET)
+	/* Bluetooth is enabled by sid_start, the DFU service advertises next to Sidewalk. */
+	(void)nordic_dfu_ble_adv_start();
+#endif
 #if defined(CONFIG_SIDEWALK_CLI)
 	CLI_init(application_ctx->handle);
 #endif
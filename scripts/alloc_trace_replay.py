@@ -0,0 +1,272 @@
+# Copyright (c) 2023 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""Replay a Sidewalk allocation trace against candidate heap sizes and allocator policies.
+
+The trace is the output of the "sid_memory trace dump" shell command (CONFIG_SIDEWALK_ALLOC_TRACE),
+other lines of the captured log are ignored. For each traced pool the script reports the peak of
+live data, the minimum heap size that serves every allocation and the fragmentation at that size.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+POOL_NAMES = {0: "hal", 1: "ace_generic", 2: "ace_network", 3: "ace_test"}
+RECORD_RE = re.compile(r"at,(\d+),(\d+),([af]),(\d+),(\d+),(0x[0-9a-fA-F]+)")
+SLAB_CLASSES = [16, 32, 64, 128, 256]
+
+
+def round_up(value, align):
+    return (value + align - 1) // align * align
+
+
+def parse_trace(lines):
+    """Return records per pool as lists of (op, block id, size) and a parse report."""
+    pools = {}
+    live = {}
+    next_id = 0
+    last_seq = None
+    report = {"records": 0, "gaps": 0, "unmatched_frees": 0, "failed_allocs": 0}
+
+    for line in lines:
+        match = RECORD_RE.search(line)
+        if not match:
+            continue
+        seq, _, op, pool, size, ptr = match.groups()
+        seq, pool, size, ptr = int(seq), int(pool), int(size), int(ptr, 16)
+        report["records"] += 1
+        if last_seq is not None and seq != last_seq + 1 and seq != 0:
+            report["gaps"] += 1
+        last_seq = seq
+
+        events = pools.setdefault(pool, [])
+        if op == "a":
+            if ptr == 0:
+                report["failed_allocs"] += 1
+            # Failed allocations are replayed too, the heap should have served them.
+            events.append(("a", next_id, size))
+            if ptr:
+                live[(pool, ptr)] = next_id
+            else:
+                events.append(("f", next_id, 0))
+            next_id += 1
+        else:
+            block = live.pop((pool, ptr), None)
+            if block is None:
+                # Allocated before the trace started or the record was overwritten.
+                report["unmatched_frees"] += 1
+                continue
+            events.append(("f", block, 0))
+
+    return pools, report
+
+
+class FitHeap:
+    """Linear heap with a sorted free list, first fit or best fit."""
+
+    def __init__(self, capacity, best_fit):
+        self.free = [(0, capacity)] if capacity > 0 else []
+        self.best_fit = best_fit
+        self.high_water = 0
+
+    def alloc(self, size):
+        candidates = [i for i, (_, length) in enumerate(self.free) if length >= size]
+        if not candidates:
+            return None
+        if self.best_fit:
+            index = min(candidates, key=lambda i: self.free[i][1])
+        else:
+            index = candidates[0]
+        offset, length = self.free[index]
+        if length == size:
+            del self.free[index]
+        else:
+            self.free[index] = (offset + size, length - size)
+        self.high_water = max(self.high_water, offset + size)
+        return offset
+
+    def release(self, offset, size):
+        self.free.append((offset, size))
+        self.free.sort()
+        merged = []
+        for start, length in self.free:
+            if merged and merged[-1][0] + merged[-1][1] == start:
+                merged[-1] = (merged[-1][0], merged[-1][1] + length)
+            else:
+                merged.append((start, length))
+        self.free = merged
+
+    def fragmentation(self):
+        total = sum(length for _, length in self.free)
+        largest = max((length for _, length in self.free), default=0)
+        return 1.0 - largest / total if total else 0.0
+
+
+def block_size(size, args):
+    return round_up(size + args.overhead, args.align)
+
+
+def replay_fit(events, capacity, best_fit, args):
+    heap = FitHeap(capacity - args.heap_overhead, best_fit)
+    blocks = {}
+    failures = 0
+    worst_fragmentation = 0.0
+
+    for op, block, size in events:
+        if op == "a":
+            length = block_size(size, args)
+            offset = heap.alloc(length)
+            if offset is None:
+                failures += 1
+                worst_fragmentation = max(worst_fragmentation, heap.fragmentation())
+            else:
+                blocks[block] = (offset, length)
+        elif block in blocks:
+            heap.release(*blocks.pop(block))
+
+    return {"failures": failures, "high_water": heap.high_water,
+            "fragmentation_on_failure": round(worst_fragmentation, 3)}
+
+
+def live_peaks(events, args):
+    live = {}
+    requested = rounded = peak_requested = peak_rounded = 0
+
+    for op, block, size in events:
+        if op == "a":
+            live[block] = size
+            requested += size
+            rounded += block_size(size, args)
+        elif block in live:
+            size = live.pop(block)
+            requested -= size
+            rounded -= block_size(size, args)
+        peak_requested = max(peak_requested, requested)
+        peak_rounded = max(peak_rounded, rounded)
+
+    return peak_requested, peak_rounded
+
+
+def min_safe_size(events, best_fit, args, low):
+    high = max(low, 1)
+    while replay_fit(events, high, best_fit, args)["failures"]:
+        high *= 2
+    # Assumes that a larger heap does not fail where a smaller one succeeds.
+    while low < high:
+        mid = (low + high) // 2
+        if replay_fit(events, mid, best_fit, args)["failures"]:
+            low = mid + 1
+        else:
+            high = mid
+    return round_up(high, args.align)
+
+
+def slab_blocks(events):
+    """Peak number of blocks per class, no spilling to larger classes."""
+    live = {}
+    used = {size: 0 for size in SLAB_CLASSES}
+    peak = dict(used)
+    fallback = peak_fallback = 0
+
+    for op, block, size in events:
+        if op == "a":
+            cls = next((c for c in SLAB_CLASSES if size <= c), None)
+            live[block] = (cls, size)
+            if cls:
+                used[cls] += 1
+                peak[cls] = max(peak[cls], used[cls])
+            else:
+                fallback += size
+                peak_fallback = max(peak_fallback, fallback)
+        elif block in live:
+            cls, size = live.pop(block)
+            if cls:
+                used[cls] -= 1
+            else:
+                fallback -= size
+
+    return {"blocks": peak, "bytes": sum(c * n for c, n in peak.items()),
+            "fallback_bytes": peak_fallback}
+
+
+def analyze(pools, args):
+    results = {}
+    for pool, events in sorted(pools.items()):
+        peak_requested, peak_rounded = live_peaks(events, args)
+        result = {"allocations": sum(1 for e in events if e[0] == "a"),
+                  "peak_live_bytes": peak_requested, "peak_block_bytes": peak_rounded,
+                  "policies": {}}
+        for policy in args.policies:
+            if policy == "slab":
+                result["policies"][policy] = slab_blocks(events)
+                continue
+            best_fit = policy == "best-fit"
+            safe = min_safe_size(events, best_fit, args, peak_rounded + args.heap_overhead)
+            usable = safe - args.heap_overhead
+            policy_result = {"min_safe_size": safe,
+                             "fragmentation": round(1.0 - peak_rounded / usable, 3)
+                             if usable else 0.0,
+                             "candidates": {}}
+            for size in args.sizes:
+                policy_result["candidates"][size] = replay_fit(events, size, best_fit, args)
+            result["policies"][policy] = policy_result
+        results[POOL_NAMES.get(pool, str(pool))] = result
+    return results
+
+
+def print_results(results, report):
+    print(f"records {report['records']}, gaps {report['gaps']}, "
+          f"unmatched frees {report['unmatched_frees']}, "
+          f"failed allocations {report['failed_allocs']}")
+    for pool, result in results.items():
+        print(f"\n{pool}: {result['allocations']} allocations, "
+              f"peak live {result['peak_live_bytes']} B, "
+              f"peak with block overhead {result['peak_block_bytes']} B")
+        for policy, data in result["policies"].items():
+            if policy == "slab":
+                blocks = ", ".join(f"{c}:{n}" for c, n in data["blocks"].items())
+                print(f"  slab: blocks {blocks} ({data['bytes']} B), "
+                      f"fallback {data['fallback_bytes']} B")
+                continue
+            print(f"  {policy}: min safe size {data['min_safe_size']} B, "
+                  f"fragmentation {data['fragmentation']:.1%}")
+            for size, candidate in data["candidates"].items():
+                print(f"    {size} B: {candidate['failures']} failures, "
+                      f"high water {candidate['high_water']} B, "
+                      f"fragmentation on failure {candidate['fragmentation_on_failure']:.1%}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("trace", nargs="?", type=argparse.FileType("r"), default=sys.stdin,
+                        help="captured shell output, stdin by default")
+    parser.add_argument("--sizes", default="",
+                        help="comma separated candidate heap sizes to evaluate")
+    parser.add_argument("--policies", default="first-fit,best-fit,slab",
+                        help="comma separated policies: first-fit, best-fit, slab")
+    parser.add_argument("--align", type=int, default=8, help="block alignment in bytes")
+    parser.add_argument("--overhead", type=int, default=4, help="header bytes per block")
+    parser.add_argument("--heap-overhead", type=int, default=0,
+                        help="bytes of the heap used by allocator metadata")
+    parser.add_argument("--json", action="store_true", help="print the results as JSON")
+    args = parser.parse_args()
+    args.sizes = [int(size) for size in args.sizes.split(",") if size]
+    args.policies = [policy for policy in args.policies.split(",") if policy]
+
+    pools, report = parse_trace(args.trace)
+    results = analyze(pools, args)
+
+    if args.json:
+        print(json.dumps({"trace": report, "pools": results}, indent=2))
+    else:
+        print_results(results, report)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
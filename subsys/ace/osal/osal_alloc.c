@@ -4,68 +4,174 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 #include <osal_alloc.h>
+#include <osal_alloc_stats.h>
+#include <sid_alloc_trace.h>
+#include <errno.h>
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/sys_heap.h>
+#include <version.h>
+
+/* The sys_heap internals moved out of lib/os in Zephyr 3.4. */
+#if defined(CONFIG_SIDEWALK_HEAP_LARGEST_FREE_WALK) && ZEPHYR_VERSION_CODE < ZEPHYR_VERSION(3, 4, 0)
+#define HEAP_WALK 1
+/* sys_heap internals, used to find the largest free chunk. */
+#include <heap.h>
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(ace, CONFIG_SIDEWALK_LOG_LEVEL);
 
+struct heap_ctx {
+	struct k_heap *heap;
+	size_t size;
+	struct sid_memory_stats_counters stats;
+};
+
 K_HEAP_DEFINE(sid_heap, CONFIG_SIDEWALK_HEAP_SIZE);
+static struct heap_ctx sid_heap_ctx = { .heap = &sid_heap, .size = CONFIG_SIDEWALK_HEAP_SIZE };
+
+#if CONFIG_SIDEWALK_HEAP_NETWORK_SIZE > 0
+K_HEAP_DEFINE(sid_net_heap, CONFIG_SIDEWALK_HEAP_NETWORK_SIZE);
+static struct heap_ctx sid_net_heap_ctx = { .heap = &sid_net_heap,
+					    .size = CONFIG_SIDEWALK_HEAP_NETWORK_SIZE };
+#define NET_HEAP_CTX (&sid_net_heap_ctx)
+#else
+#define NET_HEAP_CTX (&sid_heap_ctx)
+#endif /* CONFIG_SIDEWALK_HEAP_NETWORK_SIZE > 0 */
 
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-#define HEAP_USAGE_WARNING_THRESHOLD (7 * CONFIG_SIDEWALK_HEAP_SIZE / 10)
+#define HEAP_USAGE_WARNING_PERCENT (70)
 
 static void heap_alloc_stats(struct sys_heap *p_heap, size_t mem_to_alloc)
 {
 	struct sys_memory_stats stat;
+	size_t heap_size;
 
 	sys_heap_runtime_stats_get(p_heap, &stat);
+	heap_size = stat.allocated_bytes + stat.free_bytes;
 	if (mem_to_alloc > stat.free_bytes) {
 		LOG_ERR("Not heap left. Alloc size: %u, free: %u", mem_to_alloc, stat.free_bytes);
 	}
 
-	if (stat.max_allocated_bytes > HEAP_USAGE_WARNING_THRESHOLD) {
+	if (stat.max_allocated_bytes > HEAP_USAGE_WARNING_PERCENT * heap_size / 100) {
 		LOG_WRN("Max heap usage %u", stat.max_allocated_bytes);
 	}
 
-	if (CONFIG_SIDEWALK_HEAP_SIZE > 0) {
+	if (heap_size > 0) {
 		size_t usage = stat.allocated_bytes + mem_to_alloc;
-		LOG_DBG("heap usage %4u [%2d%%]", usage, (100 * usage / CONFIG_SIDEWALK_HEAP_SIZE));
+		LOG_DBG("heap usage %4u [%2d%%]", usage, (100 * usage / heap_size));
 	}
 }
 
 #endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
 
+static void *heap_alloc(size_t size, void *ctx)
+{
+	struct heap_ctx *heap_ctx = ctx;
+	void *p;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	heap_alloc_stats(&heap_ctx->heap->heap, size);
+#endif
+
+	p = k_heap_alloc(heap_ctx->heap, size, K_NO_WAIT);
+	if (p) {
+		sid_memory_stats_alloc(&heap_ctx->stats,
+				       sys_heap_usable_size(&heap_ctx->heap->heap, p));
+	} else {
+		sid_memory_stats_fail(&heap_ctx->stats);
+	}
+
+	return p;
+}
+
+static void heap_free(void *p, void *ctx)
+{
+	struct heap_ctx *heap_ctx = ctx;
+
+	if (p) {
+		sid_memory_stats_free(&heap_ctx->stats,
+				      sys_heap_usable_size(&heap_ctx->heap->heap, p));
+	}
+	k_heap_free(heap_ctx->heap, p);
+}
+
+#define HEAP_ALLOCATOR(_type, _heap)                                                               \
+	[_type] = { .buf_type = _type, .alloc = heap_alloc, .free = heap_free, .ctx = _heap }
+
+/* Network buffers are short-lived, a separate heap keeps them from fragmenting the generic one. */
+#define DEFAULT_ALLOCATORS                                                                         \
+	{                                                                                          \
+		HEAP_ALLOCATOR(ACE_ALLOC_BUFFER_GENERIC, &sid_heap_ctx),                           \
+		HEAP_ALLOCATOR(ACE_ALLOC_BUFFER_NETWORK, NET_HEAP_CTX),                            \
+		HEAP_ALLOCATOR(ACE_ALLOC_BUFFER_TEST, &sid_heap_ctx),                              \
+	}
+
+static const aceAlloc_allocator_t default_allocators[ACE_ALLOC_BUFFER_MAX] = DEFAULT_ALLOCATORS;
+static aceAlloc_allocator_t allocators_used[ACE_ALLOC_BUFFER_MAX] = DEFAULT_ALLOCATORS;
+
+static const aceAlloc_allocator_t *allocator_get(aceAlloc_bufferType_t buf_type)
+{
+	if ((unsigned int)buf_type >= ACE_ALLOC_BUFFER_MAX) {
+		return NULL;
+	}
+
+	return &allocators_used[buf_type];
+}
+
 ace_status_t aceAlloc_init(void)
 {
+	memcpy(allocators_used, default_allocators, sizeof(allocators_used));
+
 	return ACE_STATUS_OK;
 }
 
 ace_status_t aceAlloc_initWithAllocator(aceAlloc_allocator_t *allocators, size_t count)
 {
-	ARG_UNUSED(allocators);
-	ARG_UNUSED(count);
+	if (!allocators || !count) {
+		return aceAlloc_init();
+	}
 
-	return ACE_STATUS_NOT_SUPPORTED;
+	for (size_t i = 0; i < count; i++) {
+		if ((unsigned int)allocators[i].buf_type >= ACE_ALLOC_BUFFER_MAX ||
+		    !allocators[i].alloc || !allocators[i].free) {
+			return ACE_STATUS_BAD_PARAM;
+		}
+	}
+
+	/* Buffer types without an allocator keep the default one. */
+	(void)aceAlloc_init();
+	for (size_t i = 0; i < count; i++) {
+		allocators_used[allocators[i].buf_type] = allocators[i];
+	}
+
+	return ACE_STATUS_OK;
 }
 
 ace_status_t aceAlloc_deInit(void)
 {
-	return ACE_STATUS_OK;
+	return aceAlloc_init();
 }
 
 void *aceAlloc_alloc(aceModules_moduleId_t module_id, aceAlloc_bufferType_t buf_type, size_t size)
 {
+	const aceAlloc_allocator_t *allocator = allocator_get(buf_type);
+	void *p;
+
 	ARG_UNUSED(module_id);
-	ARG_UNUSED(buf_type);
 
-#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-	heap_alloc_stats(&sid_heap.heap, size);
-#endif
+	if (!allocator) {
+		return NULL;
+	}
+
+	p = allocator->alloc(size, allocator->ctx);
+	sid_alloc_trace_alloc(SID_ALLOC_TRACE_POOL_ACE_GENERIC + buf_type, p, size);
 
-	return k_heap_alloc(&sid_heap, size, K_NO_WAIT);
+	return p;
 }
 
 void *aceAlloc_calloc(aceModules_moduleId_t module_id, aceAlloc_bufferType_t buf_type, size_t nmemb,
@@ -88,8 +194,80 @@ void *aceAlloc_calloc(aceModules_moduleId_t module_id, aceAlloc_bufferType_t buf
 
 void aceAlloc_free(aceModules_moduleId_t module_id, aceAlloc_bufferType_t buf_type, void *p)
 {
+	const aceAlloc_allocator_t *allocator = allocator_get(buf_type);
+
 	ARG_UNUSED(module_id);
-	ARG_UNUSED(buf_type);
 
-	k_heap_free(&sid_heap, p);
+	if (!allocator || !p) {
+		return;
+	}
+
+	sid_alloc_trace_free(SID_ALLOC_TRACE_POOL_ACE_GENERIC + buf_type, p);
+	allocator->free(p, allocator->ctx);
+}
+
+#if defined(HEAP_WALK)
+/* Walks the heap chunks under the heap lock, nothing is allocated. */
+static size_t heap_largest_free(struct k_heap *heap, size_t size)
+{
+	struct z_heap *h = heap->heap.heap;
+	k_spinlock_key_t key = k_spin_lock(&heap->lock);
+	size_t largest = 0;
+
+	ARG_UNUSED(size);
+
+	for (chunkid_t c = right_chunk(h, 0); c < h->end_chunk; c = right_chunk(h, c)) {
+		if (!chunk_used(h, c)) {
+			largest = MAX(largest, chunksz_to_bytes(h, chunk_size(h, c)) -
+						       chunk_header_bytes(h));
+		}
+	}
+	k_spin_unlock(&heap->lock, key);
+
+	return largest;
+}
+#else
+static void *heap_probe_alloc(void *ctx, size_t size)
+{
+	return sys_heap_alloc(&((struct k_heap *)ctx)->heap, size);
+}
+
+static void heap_probe_free(void *ctx, void *ptr)
+{
+	sys_heap_free(&((struct k_heap *)ctx)->heap, ptr);
+}
+
+/* Probes the heap under the heap lock, so no other user sees the test allocations. */
+static size_t heap_largest_free(struct k_heap *heap, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&heap->lock);
+	size_t largest = sid_memory_stats_largest_free(heap_probe_alloc, heap_probe_free, heap,
+						       size);
+
+	k_spin_unlock(&heap->lock, key);
+
+	return largest;
+}
+#endif /* HEAP_WALK */
+
+int sid_ace_alloc_stats_get(aceAlloc_bufferType_t buf_type, struct sid_memory_stats *stats)
+{
+	const aceAlloc_allocator_t *allocator = allocator_get(buf_type);
+	struct heap_ctx *heap_ctx;
+
+	if (!allocator || !stats) {
+		return -EINVAL;
+	}
+
+	/* Custom allocators keep their own statistics. */
+	if (allocator->alloc != heap_alloc) {
+		return -ENOTSUP;
+	}
+
+	heap_ctx = allocator->ctx;
+	stats->size = heap_ctx->size;
+	sid_memory_stats_copy(&heap_ctx->stats, stats);
+	stats->largest_free = heap_largest_free(heap_ctx->heap, heap_ctx->size);
+
+	return 0;
 }
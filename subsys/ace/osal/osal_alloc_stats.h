@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file osal_alloc_stats.h
+ *  @brief Statistics of the ACE OSAL allocator heaps.
+ */
+
+#ifndef OSAL_ALLOC_STATS_H
+#define OSAL_ALLOC_STATS_H
+
+#include <osal_alloc.h>
+#include <sid_memory_stats.h>
+
+/**
+ * @brief Get statistics of the heap serving a buffer type.
+ *
+ * Buffer types sharing a heap report the same statistics.
+ *
+ * @param buf_type buffer type.
+ * @param stats [out] heap statistics.
+ * @return 0 on success, -EINVAL for invalid arguments,
+ *         -ENOTSUP if the buffer type uses a custom allocator.
+ */
+int sid_ace_alloc_stats_get(aceAlloc_bufferType_t buf_type, struct sid_memory_stats *stats);
+
+#endif /* OSAL_ALLOC_STATS_H */
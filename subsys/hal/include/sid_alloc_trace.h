@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_alloc_trace.h
+ *  @brief Allocation trace of the Sidewalk heaps.
+ *
+ * Allocations and frees of sid_hal_malloc() and aceAlloc are recorded into a RAM ring.
+ * The records are replayed on the host by scripts/alloc_trace_replay.py to size the heaps.
+ */
+
+#ifndef SID_ALLOC_TRACE_H
+#define SID_ALLOC_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Traced memory, ACE pools follow the aceAlloc buffer type order. */
+enum sid_alloc_trace_pool {
+	SID_ALLOC_TRACE_POOL_HAL = 0,
+	SID_ALLOC_TRACE_POOL_ACE_GENERIC,
+	SID_ALLOC_TRACE_POOL_ACE_NETWORK,
+	SID_ALLOC_TRACE_POOL_ACE_TEST,
+};
+
+enum sid_alloc_trace_op {
+	SID_ALLOC_TRACE_OP_ALLOC = 0,
+	SID_ALLOC_TRACE_OP_FREE,
+};
+
+struct sid_alloc_trace_record {
+	/** Sequence number, a gap means records were overwritten. */
+	uint32_t seq;
+	/** Cycle counter timestamp in microseconds. */
+	uint32_t timestamp_us;
+	/** Block address, 0 for a failed allocation. */
+	uint32_t ptr;
+	/** Requested size, 0 for free. */
+	uint32_t size;
+	uint8_t op;
+	uint8_t pool;
+};
+
+#if defined(CONFIG_SIDEWALK_ALLOC_TRACE)
+/**
+ * @brief Record an allocation.
+ *
+ * @param pool traced memory.
+ * @param ptr allocated block, NULL if the allocation failed.
+ * @param size requested size.
+ */
+void sid_alloc_trace_alloc(enum sid_alloc_trace_pool pool, const void *ptr, size_t size);
+
+/**
+ * @brief Record a free.
+ *
+ * @param pool traced memory.
+ * @param ptr freed block.
+ */
+void sid_alloc_trace_free(enum sid_alloc_trace_pool pool, const void *ptr);
+
+/**
+ * @brief Read and remove the oldest records.
+ *
+ * @param records [out] buffer for the records.
+ * @param max number of records fitting in the buffer.
+ * @return number of records read.
+ */
+size_t sid_alloc_trace_read(struct sid_alloc_trace_record *records, size_t max);
+
+/**
+ * @brief Get number of records overwritten before they were read.
+ *
+ * @return number of lost records.
+ */
+uint32_t sid_alloc_trace_dropped(void);
+
+/**
+ * @brief Remove all records and restart the sequence numbers.
+ */
+void sid_alloc_trace_reset(void);
+#else
+static inline void sid_alloc_trace_alloc(enum sid_alloc_trace_pool pool, const void *ptr,
+					 size_t size)
+{
+}
+
+static inline void sid_alloc_trace_free(enum sid_alloc_trace_pool pool, const void *ptr)
+{
+}
+#endif /* CONFIG_SIDEWALK_ALLOC_TRACE */
+
+#endif /* SID_ALLOC_TRACE_H */
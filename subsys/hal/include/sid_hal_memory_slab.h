@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_hal_memory_slab.h
+ *  @brief Size-class slab allocator behind sid_hal_malloc().
+ */
+
+#ifndef SID_HAL_MEMORY_SLAB_H
+#define SID_HAL_MEMORY_SLAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Number of size classes. */
+#define SID_HAL_MEMORY_SLAB_CLASSES (5)
+
+struct sid_hal_memory_slab_stats {
+	/** Block size in bytes. */
+	size_t block_size;
+	/** Number of blocks. */
+	uint32_t blocks;
+	/** Blocks in use. */
+	uint32_t used;
+	/** Maximum number of blocks in use. */
+	uint32_t peak;
+	/** Requests of this class served by a larger class. */
+	uint32_t spilled;
+	/** Requests of this class that failed. */
+	uint32_t failed;
+};
+
+/**
+ * @brief Get statistics of one size class.
+ *
+ * @param index class index, from 0 to SID_HAL_MEMORY_SLAB_CLASSES - 1, smallest first.
+ * @param stats [out] class statistics.
+ * @return 0 on success, -EINVAL for invalid arguments.
+ */
+int sid_hal_memory_slab_stats_get(size_t index, struct sid_hal_memory_slab_stats *stats);
+
+/**
+ * @brief Get number of requests served by the fallback pool.
+ *
+ * @return number of allocations larger than the largest class.
+ */
+uint32_t sid_hal_memory_slab_fallback_count(void);
+
+#endif /* SID_HAL_MEMORY_SLAB_H */
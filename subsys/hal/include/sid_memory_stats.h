@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_memory_stats.h
+ *  @brief Counters of the Sidewalk heaps and the HAL memory pool.
+ *
+ * The counters are updated with a few atomic operations per allocation. The largest free
+ * block is only computed when the statistics are read.
+ */
+
+#ifndef SID_MEMORY_STATS_H
+#define SID_MEMORY_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/atomic.h>
+
+struct sid_memory_stats {
+	/** Capacity in bytes. */
+	size_t size;
+	/** Bytes in use, including allocator rounding.
+	 *  Not tracked by the HAL memory pool without SIDEWALK_HAL_MEMORY_POOL_STATS.
+	 */
+	size_t current_bytes;
+	/** Maximum of current_bytes. */
+	size_t peak_bytes;
+	/** Successful allocations. */
+	uint32_t alloc_count;
+	/** Failed allocations. */
+	uint32_t failed_count;
+	/** Largest block that can be allocated. */
+	size_t largest_free;
+};
+
+struct sid_memory_stats_counters {
+	atomic_t current_bytes;
+	atomic_t peak_bytes;
+	atomic_t alloc_count;
+	atomic_t failed_count;
+};
+
+static inline void sid_memory_stats_alloc(struct sid_memory_stats_counters *counters, size_t bytes)
+{
+	atomic_val_t current = atomic_add(&counters->current_bytes, (atomic_val_t)bytes) + bytes;
+	atomic_val_t peak;
+
+	atomic_inc(&counters->alloc_count);
+	do {
+		peak = atomic_get(&counters->peak_bytes);
+		if (current <= peak) {
+			break;
+		}
+	} while (!atomic_cas(&counters->peak_bytes, peak, current));
+}
+
+static inline void sid_memory_stats_fail(struct sid_memory_stats_counters *counters)
+{
+	atomic_inc(&counters->failed_count);
+}
+
+static inline void sid_memory_stats_free(struct sid_memory_stats_counters *counters, size_t bytes)
+{
+	atomic_sub(&counters->current_bytes, (atomic_val_t)bytes);
+}
+
+static inline void sid_memory_stats_copy(struct sid_memory_stats_counters *counters,
+					 struct sid_memory_stats *stats)
+{
+	stats->current_bytes = (size_t)atomic_get(&counters->current_bytes);
+	stats->peak_bytes = (size_t)atomic_get(&counters->peak_bytes);
+	stats->alloc_count = (uint32_t)atomic_get(&counters->alloc_count);
+	stats->failed_count = (uint32_t)atomic_get(&counters->failed_count);
+}
+
+/**
+ * @brief Find the largest block an allocator can serve by probing it.
+ *
+ * Binary search with test allocations, meant for statistics queries of allocators which do not
+ * expose their free blocks. The caller holds the allocator lock for the whole search, so the
+ * test allocations are never seen by other users.
+ *
+ * @param alloc_fn allocation function.
+ * @param free_fn free function.
+ * @param ctx allocator context.
+ * @param limit upper bound of the search.
+ * @return size of the largest block that could be allocated.
+ */
+static inline size_t sid_memory_stats_largest_free(void *(*alloc_fn)(void *ctx, size_t size),
+						   void (*free_fn)(void *ctx, void *ptr), void *ctx,
+						   size_t limit)
+{
+	size_t low = 0;
+	size_t high = limit;
+
+	while (low < high) {
+		size_t mid = low + (high - low + 1) / 2;
+		void *ptr = alloc_fn(ctx, mid);
+
+		if (ptr) {
+			free_fn(ctx, ptr);
+			low = mid;
+		} else {
+			high = mid - 1;
+		}
+	}
+
+	return low;
+}
+
+/**
+ * @brief Get statistics of the memory behind sid_hal_malloc().
+ *
+ * @param stats [out] statistics.
+ * @return 0 on success, -EINVAL for invalid arguments.
+ */
+int sid_hal_memory_stats_get(struct sid_memory_stats *stats);
+
+#endif /* SID_MEMORY_STATS_H */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file alloc_trace.c
+ *  @brief Allocation trace of the Sidewalk heaps.
+ *
+ * The ring keeps the newest records, the oldest one is overwritten when it is full.
+ */
+
+#include <sid_alloc_trace.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+
+#define TRACE_RECORDS (CONFIG_SIDEWALK_ALLOC_TRACE_RECORDS)
+
+static struct sid_alloc_trace_record ring[TRACE_RECORDS];
+static uint32_t head;
+static uint32_t count;
+static uint32_t seq;
+static uint32_t dropped;
+static struct k_spinlock lock;
+
+static void record_put(uint8_t op, uint8_t pool, const void *ptr, size_t size)
+{
+	uint32_t timestamp_us = k_cyc_to_us_floor32(k_cycle_get_32());
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct sid_alloc_trace_record *record = &ring[(head + count) % TRACE_RECORDS];
+
+	if (count == TRACE_RECORDS) {
+		head = (head + 1) % TRACE_RECORDS;
+		dropped++;
+	} else {
+		count++;
+	}
+
+	record->seq = seq++;
+	record->timestamp_us = timestamp_us;
+	record->ptr = (uint32_t)(uintptr_t)ptr;
+	record->size = (uint32_t)size;
+	record->op = op;
+	record->pool = pool;
+	k_spin_unlock(&lock, key);
+}
+
+void sid_alloc_trace_alloc(enum sid_alloc_trace_pool pool, const void *ptr, size_t size)
+{
+	record_put(SID_ALLOC_TRACE_OP_ALLOC, pool, ptr, size);
+}
+
+void sid_alloc_trace_free(enum sid_alloc_trace_pool pool, const void *ptr)
+{
+	if (ptr) {
+		record_put(SID_ALLOC_TRACE_OP_FREE, pool, ptr, 0);
+	}
+}
+
+size_t sid_alloc_trace_read(struct sid_alloc_trace_record *records, size_t max)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	size_t read = 0;
+
+	while (read < max && count) {
+		records[read++] = ring[head];
+		head = (head + 1) % TRACE_RECORDS;
+		count--;
+	}
+	k_spin_unlock(&lock, key);
+
+	return read;
+}
+
+uint32_t sid_alloc_trace_dropped(void)
+{
+	return dropped;
+}
+
+void sid_alloc_trace_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	head = 0;
+	count = 0;
+	seq = 0;
+	dropped = 0;
+	k_spin_unlock(&lock, key);
+}
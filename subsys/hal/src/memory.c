@@ -16,8 +16,13 @@
 #include <sid_hal_memory_ifc.h>
 #include <sid_pal_critical_region_ifc.h>
 #include <sid_memory_pool.h>
+#include <sid_memory_stats.h>
+#include <sid_alloc_trace.h>
 #include <sid_pal_log_ifc.h>
 
+#include <errno.h>
+#include <stdint.h>
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(hal_memory, CONFIG_SIDEWALK_LOG_LEVEL);
 
@@ -32,6 +37,20 @@ LOG_MODULE_REGISTER(hal_memory, CONFIG_SIDEWALK_LOG_LEVEL);
 static uint8_t mem_pool[SID_HAL_PROTOCOL_MEMORY_SZ] __attribute__((aligned));
 struct sid_memory_pool *mem_pool_handle = NULL;
 
+static struct sid_memory_stats_counters mem_stats;
+
+#if defined(CONFIG_SIDEWALK_HAL_MEMORY_POOL_STATS)
+/* Size of the block in front of each allocation, keeps the pool pointer alignment. */
+typedef union {
+    size_t size;
+    void *align;
+} mem_hdr_t;
+
+#define MEM_HDR_SIZE sizeof(mem_hdr_t)
+#else
+#define MEM_HDR_SIZE 0
+#endif /* CONFIG_SIDEWALK_HAL_MEMORY_POOL_STATS */
+
 void *sid_hal_malloc(size_t size)
 {
     if (mem_pool_handle == NULL) {
@@ -43,9 +62,25 @@ void *sid_hal_malloc(size_t size)
         }
     }
     void *ptr = NULL;
-    sid_pal_enter_critical_region();
-    ptr = sid_memory_pool_allocate(mem_pool_handle, size);
-    sid_pal_exit_critical_region();
+    if (size <= SIZE_MAX - MEM_HDR_SIZE) {
+        sid_pal_enter_critical_region();
+        ptr = sid_memory_pool_allocate(mem_pool_handle, size + MEM_HDR_SIZE);
+        sid_pal_exit_critical_region();
+    }
+    if (!ptr) {
+        sid_memory_stats_fail(&mem_stats);
+        sid_alloc_trace_alloc(SID_ALLOC_TRACE_POOL_HAL, NULL, size);
+        return NULL;
+    }
+#if defined(CONFIG_SIDEWALK_HAL_MEMORY_POOL_STATS)
+    mem_hdr_t *hdr = ptr;
+    hdr->size = size + MEM_HDR_SIZE;
+    sid_memory_stats_alloc(&mem_stats, hdr->size);
+    ptr = hdr + 1;
+#else
+    sid_memory_stats_alloc(&mem_stats, 0);
+#endif /* CONFIG_SIDEWALK_HAL_MEMORY_POOL_STATS */
+    sid_alloc_trace_alloc(SID_ALLOC_TRACE_POOL_HAL, ptr, size);
     return ptr;
 }
 
@@ -54,7 +89,42 @@ void sid_hal_free(void *ptr)
     if (!ptr) {
         return;
     }
+    sid_alloc_trace_free(SID_ALLOC_TRACE_POOL_HAL, ptr);
+#if defined(CONFIG_SIDEWALK_HAL_MEMORY_POOL_STATS)
+    mem_hdr_t *hdr = (mem_hdr_t *)ptr - 1;
+    sid_memory_stats_free(&mem_stats, hdr->size);
+    ptr = hdr;
+#endif /* CONFIG_SIDEWALK_HAL_MEMORY_POOL_STATS */
     sid_pal_enter_critical_region();
     sid_memory_pool_free(mem_pool_handle, ptr);
     sid_pal_exit_critical_region();
 }
+
+static void *pool_probe_alloc(void *ctx, size_t size)
+{
+    return sid_memory_pool_allocate(ctx, size);
+}
+
+static void pool_probe_free(void *ctx, void *ptr)
+{
+    sid_memory_pool_free(ctx, ptr);
+}
+
+int sid_hal_memory_stats_get(struct sid_memory_stats *stats)
+{
+    if (!stats) {
+        return -EINVAL;
+    }
+    stats->size = sizeof(mem_pool);
+    sid_memory_stats_copy(&mem_stats, stats);
+    stats->largest_free = 0;
+    if (mem_pool_handle) {
+        /* The pool is opaque, it is probed in one critical region so no user sees the probes. */
+        sid_pal_enter_critical_region();
+        size_t largest = sid_memory_stats_largest_free(pool_probe_alloc, pool_probe_free,
+                                                       mem_pool_handle, sizeof(mem_pool));
+        sid_pal_exit_critical_region();
+        stats->largest_free = (largest > MEM_HDR_SIZE) ? largest - MEM_HDR_SIZE : 0;
+    }
+    return 0;
+}
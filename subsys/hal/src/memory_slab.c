@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file memory_slab.c
+ *  @brief Size-class slab allocator behind sid_hal_malloc().
+ *
+ * Each class is a static array of equal blocks with an intrusive freelist.
+ * The freelists are built at boot, so the allocation path only takes the class spinlock
+ * for one pop or push.
+ */
+
+#include <sid_hal_memory_ifc.h>
+#include <sid_hal_memory_slab.h>
+#include <sid_pal_critical_region_ifc.h>
+#include <sid_memory_pool.h>
+#include <sid_memory_stats.h>
+#include <sid_alloc_trace.h>
+
+#include <errno.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(hal_memory, CONFIG_SIDEWALK_LOG_LEVEL);
+
+#define BLOCK_ALIGN (8)
+#define CLASS_SIZE_MIN (16)
+#define CLASS_SIZE_MAX (256)
+#define FALLBACK_SIZE (CONFIG_SIDEWALK_HAL_MEMORY_SLAB_FALLBACK_SIZE)
+
+#define SLAB_BUF(size) slab_buf_##size
+#define SLAB_BUF_DEFINE(size)                                                                      \
+	static uint8_t SLAB_BUF(size)[CONFIG_SIDEWALK_HAL_MEMORY_SLAB_##size##_BLOCKS * size]      \
+		__aligned(BLOCK_ALIGN)
+
+#define SLAB_CLASS(size)                                                                           \
+	{                                                                                          \
+		.start = SLAB_BUF(size), .end = SLAB_BUF(size) + sizeof(SLAB_BUF(size)),           \
+		.block_size = size, .blocks = CONFIG_SIDEWALK_HAL_MEMORY_SLAB_##size##_BLOCKS,     \
+	}
+
+struct slab_block {
+	struct slab_block *next;
+};
+
+struct slab_class {
+	uint8_t *const start;
+	uint8_t *const end;
+	const size_t block_size;
+	const uint32_t blocks;
+	struct slab_block *free_list;
+	uint32_t used;
+	uint32_t peak;
+	atomic_t spilled;
+	atomic_t failed;
+	struct k_spinlock lock;
+};
+
+SLAB_BUF_DEFINE(16);
+SLAB_BUF_DEFINE(32);
+SLAB_BUF_DEFINE(64);
+SLAB_BUF_DEFINE(128);
+SLAB_BUF_DEFINE(256);
+
+static struct slab_class classes[SID_HAL_MEMORY_SLAB_CLASSES] = {
+	SLAB_CLASS(16), SLAB_CLASS(32), SLAB_CLASS(64), SLAB_CLASS(128), SLAB_CLASS(256),
+};
+
+static atomic_t fallback_count;
+
+static struct sid_memory_stats_counters mem_stats;
+
+/* Fallback blocks carry their size, class blocks are sized by the class. */
+struct fallback_hdr {
+	size_t size;
+} __aligned(BLOCK_ALIGN);
+
+#define FALLBACK_HDR_SIZE sizeof(struct fallback_hdr)
+
+#if FALLBACK_SIZE > 0
+static uint8_t fallback_buf[FALLBACK_SIZE] __aligned(BLOCK_ALIGN);
+static struct sid_memory_pool *fallback_pool;
+#endif /* FALLBACK_SIZE > 0 */
+
+static inline size_t class_index(size_t size)
+{
+	if (size <= CLASS_SIZE_MIN) {
+		return 0;
+	}
+
+	/* Power of two classes: 17..32 -> 1, 33..64 -> 2, ... */
+	return (32 - __builtin_clz((uint32_t)(size - 1))) - 4;
+}
+
+static void *block_get(struct slab_class *cls)
+{
+	struct slab_block *block;
+	k_spinlock_key_t key = k_spin_lock(&cls->lock);
+
+	block = cls->free_list;
+	if (block) {
+		cls->free_list = block->next;
+		cls->used++;
+		if (cls->used > cls->peak) {
+			cls->peak = cls->used;
+		}
+	}
+	k_spin_unlock(&cls->lock, key);
+
+	return block;
+}
+
+static void block_put(struct slab_class *cls, void *ptr)
+{
+	struct slab_block *block = ptr;
+	k_spinlock_key_t key;
+
+	__ASSERT(((uint8_t *)ptr - cls->start) % cls->block_size == 0, "Invalid block %p", ptr);
+
+	key = k_spin_lock(&cls->lock);
+	block->next = cls->free_list;
+	cls->free_list = block;
+	cls->used--;
+	k_spin_unlock(&cls->lock, key);
+}
+
+static void *fallback_alloc(size_t size)
+{
+	struct fallback_hdr *hdr;
+	void *ptr = NULL;
+
+#if FALLBACK_SIZE > 0
+	if (fallback_pool && size <= FALLBACK_SIZE) {
+		sid_pal_enter_critical_region();
+		ptr = sid_memory_pool_allocate(fallback_pool, size + FALLBACK_HDR_SIZE);
+		sid_pal_exit_critical_region();
+	}
+#endif /* FALLBACK_SIZE > 0 */
+
+	if (!ptr) {
+		sid_memory_stats_fail(&mem_stats);
+		LOG_WRN("No memory for %zu bytes", size);
+		return NULL;
+	}
+
+	atomic_inc(&fallback_count);
+	hdr = ptr;
+	hdr->size = size + FALLBACK_HDR_SIZE;
+	sid_memory_stats_alloc(&mem_stats, hdr->size);
+
+	return hdr + 1;
+}
+
+static void fallback_free(void *ptr)
+{
+#if FALLBACK_SIZE > 0
+	struct fallback_hdr *hdr = (struct fallback_hdr *)ptr - 1;
+
+	sid_memory_stats_free(&mem_stats, hdr->size);
+	sid_pal_enter_critical_region();
+	sid_memory_pool_free(fallback_pool, hdr);
+	sid_pal_exit_critical_region();
+#else
+	__ASSERT(false, "Block %p not allocated by sid_hal_malloc", ptr);
+#endif /* FALLBACK_SIZE > 0 */
+}
+
+static void *slab_alloc(size_t size)
+{
+	size_t first;
+
+	if (size > CLASS_SIZE_MAX) {
+		return fallback_alloc(size);
+	}
+
+	first = class_index(size);
+	for (size_t i = first; i < ARRAY_SIZE(classes); i++) {
+		void *ptr = block_get(&classes[i]);
+
+		if (ptr) {
+			if (i != first) {
+				atomic_inc(&classes[first].spilled);
+			}
+			sid_memory_stats_alloc(&mem_stats, classes[i].block_size);
+			return ptr;
+		}
+	}
+
+	atomic_inc(&classes[first].failed);
+	sid_memory_stats_fail(&mem_stats);
+	LOG_WRN("No memory for %zu bytes", size);
+
+	return NULL;
+}
+
+void *sid_hal_malloc(size_t size)
+{
+	void *ptr = slab_alloc(size);
+
+	sid_alloc_trace_alloc(SID_ALLOC_TRACE_POOL_HAL, ptr, size);
+
+	return ptr;
+}
+
+void sid_hal_free(void *ptr)
+{
+	if (!ptr) {
+		return;
+	}
+
+	sid_alloc_trace_free(SID_ALLOC_TRACE_POOL_HAL, ptr);
+
+	for (size_t i = 0; i < ARRAY_SIZE(classes); i++) {
+		if ((uint8_t *)ptr >= classes[i].start && (uint8_t *)ptr < classes[i].end) {
+			block_put(&classes[i], ptr);
+			sid_memory_stats_free(&mem_stats, classes[i].block_size);
+			return;
+		}
+	}
+
+	fallback_free(ptr);
+}
+
+int sid_hal_memory_slab_stats_get(size_t index, struct sid_hal_memory_slab_stats *stats)
+{
+	struct slab_class *cls;
+	k_spinlock_key_t key;
+
+	if (index >= ARRAY_SIZE(classes) || !stats) {
+		return -EINVAL;
+	}
+
+	cls = &classes[index];
+	key = k_spin_lock(&cls->lock);
+	stats->block_size = cls->block_size;
+	stats->blocks = cls->blocks;
+	stats->used = cls->used;
+	stats->peak = cls->peak;
+	k_spin_unlock(&cls->lock, key);
+	stats->spilled = (uint32_t)atomic_get(&cls->spilled);
+	stats->failed = (uint32_t)atomic_get(&cls->failed);
+
+	return 0;
+}
+
+uint32_t sid_hal_memory_slab_fallback_count(void)
+{
+	return (uint32_t)atomic_get(&fallback_count);
+}
+
+#if FALLBACK_SIZE > 0
+static void *fallback_probe_alloc(void *ctx, size_t size)
+{
+	return sid_memory_pool_allocate(ctx, size);
+}
+
+static void fallback_probe_free(void *ctx, void *ptr)
+{
+	sid_memory_pool_free(ctx, ptr);
+}
+#endif /* FALLBACK_SIZE > 0 */
+
+int sid_hal_memory_stats_get(struct sid_memory_stats *stats)
+{
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	stats->size = FALLBACK_SIZE;
+	stats->largest_free = 0;
+	for (size_t i = 0; i < ARRAY_SIZE(classes); i++) {
+		stats->size += classes[i].end - classes[i].start;
+		if (classes[i].free_list) {
+			stats->largest_free = classes[i].block_size;
+		}
+	}
+	sid_memory_stats_copy(&mem_stats, stats);
+
+#if FALLBACK_SIZE > 0
+	if (fallback_pool) {
+		size_t largest;
+
+		/* The pool is opaque, it is probed in one critical region. */
+		sid_pal_enter_critical_region();
+		largest = sid_memory_stats_largest_free(fallback_probe_alloc, fallback_probe_free,
+							fallback_pool, FALLBACK_SIZE);
+		sid_pal_exit_critical_region();
+
+		if (largest > FALLBACK_HDR_SIZE) {
+			stats->largest_free = MAX(stats->largest_free, largest - FALLBACK_HDR_SIZE);
+		}
+	}
+#endif /* FALLBACK_SIZE > 0 */
+
+	return 0;
+}
+
+static int memory_slab_init(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(classes); i++) {
+		struct slab_class *cls = &classes[i];
+
+		cls->free_list = NULL;
+		for (uint32_t n = cls->blocks; n > 0; n--) {
+			struct slab_block *block =
+				(struct slab_block *)(cls->start + (n - 1) * cls->block_size);
+
+			block->next = cls->free_list;
+			cls->free_list = block;
+		}
+	}
+
+#if FALLBACK_SIZE > 0
+	struct sid_memory_pool_config config = { .buffer = fallback_buf,
+						 .size = sizeof(fallback_buf) };
+
+	if (SID_ERROR_NONE != sid_memory_pool_init(&fallback_pool, &config)) {
+		LOG_ERR("Fallback pool init failed");
+		fallback_pool = NULL;
+	}
+#endif /* FALLBACK_SIZE > 0 */
+
+	return 0;
+}
+
+SYS_INIT(memory_slab_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <sid_memory_stats.h>
+#include <sid_alloc_trace.h>
+#if defined(CONFIG_SIDEWALK_ACE_OSAL_ZEPHYR)
+#include <osal_alloc_stats.h>
+#endif /* CONFIG_SIDEWALK_ACE_OSAL_ZEPHYR */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+static void stats_print(const struct shell *shell, const char *name,
+			const struct sid_memory_stats *stats)
+{
+	shell_print(shell, "%-12s %6zu %6zu %6zu %8u %6u %8zu", name, stats->size,
+		    stats->current_bytes, stats->peak_bytes, stats->alloc_count, stats->failed_count,
+		    stats->largest_free);
+}
+
+static int cmd_memory_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	struct sid_memory_stats stats;
+
+	shell_print(shell, "%-12s %6s %6s %6s %8s %6s %8s", "memory", "size", "used", "peak",
+		    "allocs", "failed", "largest");
+
+	if (!sid_hal_memory_stats_get(&stats)) {
+		stats_print(shell, "hal", &stats);
+	}
+
+#if defined(CONFIG_SIDEWALK_ACE_OSAL_ZEPHYR)
+	if (!sid_ace_alloc_stats_get(ACE_ALLOC_BUFFER_GENERIC, &stats)) {
+		stats_print(shell, "ace_generic", &stats);
+	}
+	if (CONFIG_SIDEWALK_HEAP_NETWORK_SIZE > 0 &&
+	    !sid_ace_alloc_stats_get(ACE_ALLOC_BUFFER_NETWORK, &stats)) {
+		stats_print(shell, "ace_network", &stats);
+	}
+#endif /* CONFIG_SIDEWALK_ACE_OSAL_ZEPHYR */
+
+	return 0;
+}
+
+#if defined(CONFIG_SIDEWALK_ALLOC_TRACE)
+#define TRACE_DUMP_CHUNK (8)
+
+static int cmd_trace_dump(const struct shell *shell, size_t argc, char **argv)
+{
+	struct sid_alloc_trace_record records[TRACE_DUMP_CHUNK];
+	size_t read;
+
+	/* Format parsed by scripts/alloc_trace_replay.py. */
+	shell_print(shell, "at,seq,timestamp_us,op,pool,size,ptr");
+	do {
+		read = sid_alloc_trace_read(records, ARRAY_SIZE(records));
+		for (size_t i = 0; i < read; i++) {
+			shell_print(shell, "at,%u,%u,%c,%u,%u,0x%08x", records[i].seq,
+				    records[i].timestamp_us,
+				    (records[i].op == SID_ALLOC_TRACE_OP_ALLOC) ? 'a' : 'f',
+				    records[i].pool, records[i].size, records[i].ptr);
+		}
+	} while (read == ARRAY_SIZE(records));
+	shell_print(shell, "dropped %u", sid_alloc_trace_dropped());
+
+	return 0;
+}
+
+static int cmd_trace_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	sid_alloc_trace_reset();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_sid_memory_trace,
+			       SHELL_CMD_ARG(dump, NULL, "print and remove recorded allocations",
+					     cmd_trace_dump, 1, 0),
+			       SHELL_CMD_ARG(reset, NULL, "remove recorded allocations",
+					     cmd_trace_reset, 1, 0),
+			       SHELL_SUBCMD_SET_END);
+#endif /* CONFIG_SIDEWALK_ALLOC_TRACE */
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_sid_memory,
+	SHELL_CMD_ARG(stats, NULL, "print Sidewalk memory statistics", cmd_memory_stats, 1, 0),
+	IF_ENABLED(CONFIG_SIDEWALK_ALLOC_TRACE,
+		   (SHELL_CMD(trace, &sub_sid_memory_trace, "allocation trace", NULL),))
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(sid_memory, &sub_sid_memory, "Sidewalk memory", NULL);
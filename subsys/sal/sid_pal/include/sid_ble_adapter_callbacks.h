@@ -13,6 +13,9 @@
 
 #include <sid_error.h>
 #include <sid_pal_ble_adapter_ifc.h>
+#include <sid_ble_connection.h>
+
+typedef void (*sid_ble_link_params_callback_t)(const sid_ble_link_params_t *params);
 
 /**
  * @brief Set a callback for notification sent.
@@ -113,4 +116,19 @@ sid_error_t sid_ble_adapter_adv_start_cb_set(sid_pal_ble_adv_start_callback_t cb
  */
 void sid_ble_adapter_adv_started(void);
 
+/**
+ * @brief Set a callback for link parameters negotiated after connection.
+ *
+ * @param cb a callback to function which should be call.
+ * @return SID_ERROR_NONE when success, error code otherwise.
+ */
+sid_error_t sid_ble_adapter_link_params_cb_set(sid_ble_link_params_callback_t cb);
+
+/**
+ * @brief Execute callback after link parameters negotiation finished.
+ *
+ * @param params negotiated link parameters.
+ */
+void sid_ble_adapter_link_params_changed(const sid_ble_link_params_t *params);
+
 #endif /* SID_PAL_BLE_ADAPTER_CALLBACKS_H */
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_adv_policy.h
+ *  @brief Adaptive fast advertising window.
+ *
+ * The policy learns when connections arrive after advertising start and sizes the fast
+ * advertising window to cover them. Time is passed by the caller in milliseconds, so the
+ * same code runs in the advertising module and in the simulation of tests/benchmark.
+ */
+
+#ifndef SID_BLE_ADV_POLICY_H
+#define SID_BLE_ADV_POLICY_H
+
+#include <stdint.h>
+
+struct sid_ble_adv_policy_stats {
+	/** Advertising starts. */
+	uint32_t sessions;
+	/** Sessions which ended with a connection. */
+	uint32_t connections;
+	/** Connections during the fast window or a burst. */
+	uint32_t fast_connections;
+	/** Advertising data updates. */
+	uint32_t data_updates;
+	/** Bursts started and bursts refused by the duty cycle budget. */
+	uint32_t bursts;
+	uint32_t bursts_suppressed;
+	/** Smoothed time-to-connect and its mean deviation. */
+	uint32_t ttc_avg_ms;
+	uint32_t ttc_dev_ms;
+	/** Smoothed share of sessions ending with a connection within the longest window,
+	 *  in per mille.
+	 */
+	uint32_t hit_rate;
+	/** Smoothed interval between advertising data updates. */
+	uint32_t update_interval_ms;
+	/** Fast window of the last start. */
+	uint32_t fast_window_ms;
+};
+
+/**
+ * @brief Forget the statistics.
+ */
+void sid_ble_adv_policy_reset(void);
+
+/**
+ * @brief Advertising started.
+ *
+ * @param now_ms current time.
+ * @return duration of the fast advertising in ms.
+ */
+uint32_t sid_ble_adv_policy_start(uint32_t now_ms);
+
+/**
+ * @brief Advertising stopped by a connection.
+ *
+ * @param now_ms current time.
+ */
+void sid_ble_adv_policy_connected(uint32_t now_ms);
+
+/**
+ * @brief Advertising stopped without a connection.
+ *
+ * @param now_ms current time.
+ */
+void sid_ble_adv_policy_stopped(uint32_t now_ms);
+
+/**
+ * @brief Advertising data updated.
+ *
+ * @param now_ms current time.
+ * @return duration of a fast advertising burst in ms, zero when no burst is started.
+ */
+uint32_t sid_ble_adv_policy_data_updated(uint32_t now_ms);
+
+/**
+ * @brief Get the policy statistics.
+ *
+ * @param stats [out] statistics.
+ */
+void sid_ble_adv_policy_stats_get(struct sid_ble_adv_policy_stats *stats);
+
+#endif /* SID_BLE_ADV_POLICY_H */
@@ -23,6 +23,13 @@ int sid_ble_advert_start(void);
  */
 int sid_ble_advert_stop(void);
 
+/**
+ * @brief Stop Bluetooth advertising and release advertising sets.
+ *
+ * Called before Bluetooth is disabled, the host forgets its advertising sets then.
+ */
+void sid_ble_advert_deinit(void);
+
 /**
  * @brief Update advertising data.
  *
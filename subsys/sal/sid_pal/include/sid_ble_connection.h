@@ -8,6 +8,14 @@
 #define NRF_BLE_CONNECTION_H
 
 #include <zephyr/bluetooth/conn.h>
+#include <stdbool.h>
+
+/** Number of connections tracked, a slot per connection of the host. */
+#if defined(CONFIG_BT_MAX_CONN)
+#define SID_BLE_CONN_MAX (CONFIG_BT_MAX_CONN)
+#else
+#define SID_BLE_CONN_MAX (1)
+#endif /* CONFIG_BT_MAX_CONN */
 
 /**
  * @brief Struct with bluetooth connection paramters.
@@ -15,15 +23,35 @@
 typedef struct {
 	struct bt_conn *conn;
 	uint8_t addr[BT_ADDR_SIZE];
+	/** ATT MTU of the connection. */
+	uint16_t mtu;
 } sid_ble_conn_params_t;
 
+/**
+ * @brief Link layer parameters of a connection.
+ */
+typedef struct {
+	/** Connection interval in 1.25 ms units. */
+	uint16_t interval;
+	uint16_t latency;
+	/** Supervision timeout in 10 ms units. */
+	uint16_t timeout;
+	uint16_t mtu;
+	/** Maximum link layer payload in octets. */
+	uint16_t tx_max_len;
+	uint16_t rx_max_len;
+	/** PHY as BT_GAP_LE_PHY_*. */
+	uint8_t tx_phy;
+	uint8_t rx_phy;
+} sid_ble_link_params_t;
+
 /**
  * @brief Initialize ble connection module.
  */
 void sid_ble_conn_init(void);
 
 /**
- * @brief Disconnect from a remote device or cancel pending connection.
+ * @brief Disconnect the active connection.
  *
  * @return Zero on success or (negative) error code on failure.
  */
@@ -35,10 +63,43 @@ int sid_ble_conn_disconnect(void);
 void sid_ble_conn_deinit(void);
 
 /**
- * @brief The function returns current connection paramters.
+ * @brief The function returns parameters of the active connection.
+ *
+ * The active connection is the one the Sidewalk data is sent to. It is the peer which wrote
+ * to a Sidewalk service most recently, or the first peer connected when none has written yet.
  *
  * @return connection paramters as defined in @ref sid_ble_conn_params_t.
  */
 const sid_ble_conn_params_t *sid_ble_conn_params_get(void);
 
+/**
+ * @brief Take a reference to the active connection.
+ *
+ * It does not lock, the send path calls it for every send. The connection stays valid after
+ * a concurrent disconnection until the reference is released with bt_conn_unref().
+ *
+ * @return active connection, NULL if there is none or the module is not initialized.
+ */
+struct bt_conn *sid_ble_conn_active_ref(void);
+
+/**
+ * @brief Find parameters of a connection.
+ *
+ * @param conn connection object.
+ * @return connection paramters, NULL if the connection is not tracked.
+ */
+const sid_ble_conn_params_t *sid_ble_conn_params_find(const struct bt_conn *conn);
+
+/**
+ * @brief Mark the connection as the active one, Sidewalk data was received from it.
+ *
+ * An other connection takes over when the active one is closed or did not receive data for
+ * CONFIG_SIDEWALK_BLE_CONN_SWITCH_HOLDOFF_MS. The MTU of the connection is reported to the
+ * Sidewalk stack when the active connection changes.
+ *
+ * @param conn connection object.
+ * @return true when the data is for the active connection, false when it is to be dropped.
+ */
+bool sid_ble_conn_rx(struct bt_conn *conn);
+
 #endif /* NRF_BLE_CONNECTION_H */
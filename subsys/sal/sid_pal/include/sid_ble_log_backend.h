@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_log_backend.h
+ *  @brief Log backend streaming over the Bluetooth low energy logging service.
+ *
+ * Each notification of LOG_SID_BT_CHARACTERISTIC_NOTIFY carries one or more records:
+ * | length (1 byte) | type (1 byte) | payload (length bytes) |
+ */
+
+#ifndef SID_BLE_LOG_BACKEND_H
+#define SID_BLE_LOG_BACKEND_H
+
+#include <stdint.h>
+
+/** Record header size. */
+#define SID_BLE_LOG_RECORD_HDR_SIZE (2)
+
+/** Log message, payload is formatted by the backend log format (text or dictionary). */
+#define SID_BLE_LOG_RECORD_MSG (0x01)
+/** Messages lost since the previous report, payload is uint16_t little endian count. */
+#define SID_BLE_LOG_RECORD_DROPPED (0x02)
+
+/**
+ * @brief Get number of messages dropped and not yet reported to the peer.
+ *
+ * The counter saturates at UINT16_MAX.
+ *
+ * @return number of dropped messages.
+ */
+uint32_t sid_ble_log_backend_dropped(void);
+
+#endif /* SID_BLE_LOG_BACKEND_H */
@@ -19,6 +19,9 @@
 	BT_UUID_DECLARE_128(LOG_EXAMPLE_CHARACTERISTIC_UUID_VAL_WRITE)
 #define LOG_SID_BT_CHARACTERISTIC_NOTIFY                                                           \
 	BT_UUID_DECLARE_128(LOG_EXAMPLE_CHARACTERISTIC_UUID_VAL_NOTIFY)
+/* Log level control, value: severity (1 byte) followed by module name, empty name for protocol. */
+#define LOG_SID_BT_CHARACTERISTIC_CONTROL                                                          \
+	BT_UUID_DECLARE_128(LOG_EXAMPLE_CHARACTERISTIC_UUID_VAL_CONTROL)
 
 /**
  * @brief Get the logging service object.
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_rx.h
+ *  @brief Deferred delivery of received Sidewalk data.
+ *
+ * The service write handlers put the data into a ring on the Bluetooth RX thread, the
+ * Sidewalk BLE RX thread passes it to the protocol. Without CONFIG_SIDEWALK_BLE_RX_DEFERRED
+ * the data is passed to the protocol directly.
+ */
+
+#ifndef SID_BLE_RX_H
+#define SID_BLE_RX_H
+
+#include <sid_ble_adapter_callbacks.h>
+
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/sys/util.h>
+#include <stdint.h>
+
+#if defined(CONFIG_SIDEWALK_BLE_RX_DEFERRED)
+/** Record header size in the ring, records are aligned to it. */
+#define SID_BLE_RX_RECORD_HDR_SIZE (IS_ENABLED(CONFIG_SIDEWALK_BLE_TRACE) ? 8 : 4)
+/** Longest write the ring takes. */
+#define SID_BLE_RX_WRITE_MAX                                                                       \
+	(ROUND_DOWN(CONFIG_SIDEWALK_BLE_RX_RING_SIZE, SID_BLE_RX_RECORD_HDR_SIZE) -                \
+	 SID_BLE_RX_RECORD_HDR_SIZE)
+#endif /* CONFIG_SIDEWALK_BLE_RX_DEFERRED */
+
+/**
+ * @brief Ring space callback, called on the Sidewalk BLE RX thread.
+ */
+typedef void (*sid_ble_rx_space_cb_t)(void);
+
+struct sid_ble_rx_stats {
+	/** Writes put into the ring. */
+	uint32_t received;
+	/** Writes passed to the protocol. */
+	uint32_t delivered;
+	/** Writes which found the ring above the high watermark. */
+	uint32_t throttled;
+	/** Writes dropped, the ring was above the high watermark or full or the write was too
+	 *  long.
+	 */
+	uint32_t dropped;
+	/** Writes of a disconnected peer or of a stopped adapter which were not delivered. */
+	uint32_t flushed;
+	/** Highest ring fill in bytes. */
+	uint32_t peak_fill;
+};
+
+#if defined(CONFIG_SIDEWALK_BLE_RX_DEFERRED)
+/**
+ * @brief Remove undelivered data and reset the statistics.
+ */
+void sid_ble_rx_init(void);
+
+/**
+ * @brief Remove undelivered data.
+ */
+void sid_ble_rx_deinit(void);
+
+/**
+ * @brief Queue received data for the protocol.
+ *
+ * The call does not wait, a write which takes the ring above the high watermark is
+ * dropped unless the ring is empty.
+ *
+ * @param conn connection the data came from.
+ * @param id service identifier.
+ * @param data received data, copied.
+ * @param length data length.
+ * @return Zero on success, -ENOBUFS when the ring is above the high watermark or full, -EMSGSIZE when the data is
+ * longer than the ring allows.
+ */
+int sid_ble_rx_put(struct bt_conn *conn, sid_ble_cfg_service_identifier_t id, const uint8_t *data,
+		   uint16_t length);
+
+/**
+ * @brief Queue received data for the protocol from a flow controlled transport.
+ *
+ * Like sid_ble_rx_put, but data which does not fit is not dropped. The caller holds it back
+ * and puts it again when space_cb is called, which happens once when the next record is
+ * released. Only one callback is kept, the last one set.
+ *
+ * @param conn connection the data came from.
+ * @param id service identifier.
+ * @param data received data, copied.
+ * @param length data length.
+ * @param space_cb called when the ring may have space again.
+ * @return Zero on success, -EAGAIN when the ring is above the high watermark or full,
+ * -EMSGSIZE when the data is longer than the ring allows, -EINVAL without space_cb.
+ */
+int sid_ble_rx_try_put(struct bt_conn *conn, sid_ble_cfg_service_identifier_t id,
+		       const uint8_t *data, uint16_t length, sid_ble_rx_space_cb_t space_cb);
+
+/**
+ * @brief Remove undelivered data of a connection.
+ *
+ * @param conn disconnected connection.
+ */
+void sid_ble_rx_conn_flush(struct bt_conn *conn);
+
+/**
+ * @brief Get the receive statistics.
+ *
+ * @param stats [out] statistics.
+ */
+void sid_ble_rx_stats_get(struct sid_ble_rx_stats *stats);
+#else
+static inline void sid_ble_rx_init(void)
+{
+}
+
+static inline void sid_ble_rx_deinit(void)
+{
+}
+
+static inline int sid_ble_rx_put(struct bt_conn *conn, sid_ble_cfg_service_identifier_t id,
+				 const uint8_t *data, uint16_t length)
+{
+	sid_ble_adapter_data_write(id, (uint8_t *)data, length);
+	return 0;
+}
+
+static inline int sid_ble_rx_try_put(struct bt_conn *conn, sid_ble_cfg_service_identifier_t id,
+				     const uint8_t *data, uint16_t length,
+				     sid_ble_rx_space_cb_t space_cb)
+{
+	sid_ble_adapter_data_write(id, (uint8_t *)data, length);
+	return 0;
+}
+
+static inline void sid_ble_rx_conn_flush(struct bt_conn *conn)
+{
+}
+#endif /* CONFIG_SIDEWALK_BLE_RX_DEFERRED */
+
+#endif /* SID_BLE_RX_H */
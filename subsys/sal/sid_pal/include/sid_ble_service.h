@@ -11,16 +11,26 @@
 #ifndef SID_PAL_BLE_SERVICE_H
 #define SID_PAL_BLE_SERVICE_H
 
+#include <sid_ble_config_ifc.h>
+
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/gatt.h>
 
 typedef struct {
 	struct bt_conn *conn;
-	struct bt_uuid *uuid;
-	struct bt_gatt_service_static *service;
+	sid_ble_cfg_service_identifier_t id;
 } sid_ble_srv_params_t;
 
+/**
+ * @brief Find the notify characteristics of the enabled Sidewalk services.
+ *
+ * The attributes are cached, sending data does not search the GATT database.
+ *
+ * @return 0 in case of success, -ENOENT if a characteristic is not found.
+ */
+int sid_ble_service_init(void);
+
 /**
  * @brief Send data over BLE.
  *
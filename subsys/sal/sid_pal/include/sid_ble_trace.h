@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_trace.h
+ *  @brief Latency tracepoints of the Sidewalk BLE adapter.
+ *
+ * Without CONFIG_SIDEWALK_BLE_TRACE the tracepoints compile out.
+ */
+
+#ifndef SID_BLE_TRACE_H
+#define SID_BLE_TRACE_H
+
+#include <zephyr/bluetooth/conn.h>
+#include <stdint.h>
+
+/** Number of latency histogram buckets, bucket n counts latencies in [2^n, 2^(n+1)) us. */
+#define SID_BLE_TRACE_HIST_BUCKETS (16)
+/** Number of notifications per connection event buckets, the last one counts the rest. */
+#define SID_BLE_TRACE_EVENT_BUCKETS (8)
+
+enum sid_ble_trace_latency {
+	/** From a write to the Sidewalk services to the protocol data callback. */
+	SID_BLE_TRACE_RX_DISPATCH,
+	/** From a notification or vendor SDU submit to its completion. */
+	SID_BLE_TRACE_TX_SENT,
+	SID_BLE_TRACE_LATENCY_COUNT,
+};
+
+/** Transports of the sent packets, the packets of each one complete in order. */
+enum sid_ble_trace_transport {
+	/** Notifications of the Sidewalk services. */
+	SID_BLE_TRACE_GATT,
+	/** SDUs of the vendor L2CAP channel. */
+	SID_BLE_TRACE_L2CAP,
+	SID_BLE_TRACE_TRANSPORT_COUNT,
+};
+
+struct sid_ble_trace_latency_stats {
+	uint32_t count;
+	uint64_t total_us;
+	uint32_t max_us;
+	uint32_t hist[SID_BLE_TRACE_HIST_BUCKETS];
+};
+
+struct sid_ble_trace_stats {
+	struct sid_ble_trace_latency_stats latency[SID_BLE_TRACE_LATENCY_COUNT];
+	/** Connection events with completed notifications. */
+	uint32_t events;
+	/** Bucket n counts connection events with n + 1 completed notifications. */
+	uint32_t notify_per_event[SID_BLE_TRACE_EVENT_BUCKETS];
+};
+
+#if defined(CONFIG_SIDEWALK_BLE_TRACE)
+/**
+ * @brief A write to a Sidewalk service arrived, called on the Bluetooth RX thread.
+ */
+void sid_ble_trace_rx_write(void);
+
+/**
+ * @brief Get the timestamp of the last write.
+ *
+ * @return timestamp to pass to sid_ble_trace_rx_deliver.
+ */
+uint32_t sid_ble_trace_rx_stamp(void);
+
+/**
+ * @brief A deferred write is about to be passed to the protocol.
+ *
+ * @param stamp timestamp of the write.
+ */
+void sid_ble_trace_rx_deliver(uint32_t stamp);
+
+/**
+ * @brief The protocol data callback is called.
+ */
+void sid_ble_trace_rx_dispatch(void);
+
+/**
+ * @brief A notification or a vendor L2CAP SDU is submitted.
+ *
+ * @param conn connection of the packet.
+ * @param transport transport of the packet.
+ */
+void sid_ble_trace_tx_submit(struct bt_conn *conn, enum sid_ble_trace_transport transport);
+
+/**
+ * @brief The last submitted packet of the transport failed.
+ *
+ * @param conn connection of the packet.
+ * @param transport transport of the packet.
+ */
+void sid_ble_trace_tx_cancel(struct bt_conn *conn, enum sid_ble_trace_transport transport);
+
+/**
+ * @brief A packet completed, packets of a connection and transport complete in order.
+ *
+ * @param conn connection of the packet.
+ * @param transport transport of the packet.
+ */
+void sid_ble_trace_tx_sent(struct bt_conn *conn, enum sid_ble_trace_transport transport);
+
+/**
+ * @brief Forget packets in flight of a connection.
+ *
+ * @param conn disconnected connection.
+ */
+void sid_ble_trace_conn_reset(struct bt_conn *conn);
+
+/**
+ * @brief Get a consistent copy of the histograms.
+ *
+ * @param stats [out] histograms.
+ */
+void sid_ble_trace_snapshot(struct sid_ble_trace_stats *stats);
+
+/**
+ * @brief Clear the histograms.
+ */
+void sid_ble_trace_reset(void);
+
+/**
+ * @brief Get printable name of the latency.
+ *
+ * @param latency latency.
+ * @return latency name or "unknown".
+ */
+const char *sid_ble_trace_latency_name(enum sid_ble_trace_latency latency);
+#else
+static inline void sid_ble_trace_rx_write(void)
+{
+}
+
+static inline uint32_t sid_ble_trace_rx_stamp(void)
+{
+	return 0;
+}
+
+static inline void sid_ble_trace_rx_deliver(uint32_t stamp)
+{
+}
+
+static inline void sid_ble_trace_rx_dispatch(void)
+{
+}
+
+static inline void sid_ble_trace_tx_submit(struct bt_conn *conn,
+					   enum sid_ble_trace_transport transport)
+{
+}
+
+static inline void sid_ble_trace_tx_cancel(struct bt_conn *conn,
+					   enum sid_ble_trace_transport transport)
+{
+}
+
+static inline void sid_ble_trace_tx_sent(struct bt_conn *conn,
+					 enum sid_ble_trace_transport transport)
+{
+}
+
+static inline void sid_ble_trace_conn_reset(struct bt_conn *conn)
+{
+}
+#endif /* CONFIG_SIDEWALK_BLE_TRACE */
+
+#endif /* SID_BLE_TRACE_H */
@@ -41,6 +41,10 @@
 	0x9A, 0x8B, 0x7C, 0x6D, 0x5E, 0x4F, 0x01, 0x02, 0x03, 0x04, 0xF5, 0xE6, 0xD7, 0xC8, 0xB9,  \
 		0xA0
 
+#define LOG_EXAMPLE_CHARACTERISTIC_UUID_VAL_CONTROL                                                \
+	0xCC, 0x2B, 0x3C, 0x0D, 0x0E, 0x0F, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,  \
+		0x00
+
 /** Company Identifiers (see Bluetooth Assigned Numbers) */
 #define BT_COMP_ID_AMA 0x0171
 
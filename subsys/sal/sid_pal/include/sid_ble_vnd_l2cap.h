@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_vnd_l2cap.h
+ *  @brief Vendor data over an L2CAP connection-oriented channel.
+ *
+ * The peer opens the channel on CONFIG_SIDEWALK_BLE_VND_L2CAP_PSM. While it is connected the
+ * VENDOR_SERVICE data goes over the channel instead of the vendor service notifications.
+ * Without CONFIG_SIDEWALK_BLE_VND_L2CAP the vendor data always uses GATT.
+ */
+
+#ifndef SID_BLE_VND_L2CAP_H
+#define SID_BLE_VND_L2CAP_H
+
+#include <zephyr/bluetooth/conn.h>
+#include <errno.h>
+#include <stdint.h>
+
+#if defined(CONFIG_SIDEWALK_BLE_VND_L2CAP)
+/**
+ * @brief Register the L2CAP server of the vendor channel.
+ *
+ * @return 0 in case of success, negative value otherwise.
+ */
+int sid_ble_vnd_l2cap_init(void);
+
+/**
+ * @brief Send vendor data as one SDU.
+ *
+ * The SDU is segmented to the MPS of the peer and sent with its credits. The protocol is
+ * told the data is sent at once while TX buffers are left, otherwise when an SDU completes.
+ *
+ * @param conn connection.
+ * @param data data to send, copied.
+ * @param length data length.
+ * @return 0 in case of success, -ENOTCONN when the channel is not connected, -EMSGSIZE when
+ * the data is longer than the channel MTU, -EBUSY when no TX buffer is left.
+ */
+int sid_ble_vnd_l2cap_send(struct bt_conn *conn, const uint8_t *data, uint16_t length);
+#else
+static inline int sid_ble_vnd_l2cap_init(void)
+{
+	return 0;
+}
+
+static inline int sid_ble_vnd_l2cap_send(struct bt_conn *conn, const uint8_t *data,
+					 uint16_t length)
+{
+	return -ENOTCONN;
+}
+#endif /* CONFIG_SIDEWALK_BLE_VND_L2CAP */
+
+#endif /* SID_BLE_VND_L2CAP_H */
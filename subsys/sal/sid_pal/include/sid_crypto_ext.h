@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SID_CRYPTO_EXT_H
+#define SID_CRYPTO_EXT_H
+
+#include <sid_pal_crypto_ifc.h>
+
+#include <stdint.h>
+
+/** Number of latency histogram buckets, bucket n counts calls that took [2^n, 2^(n+1)) us. */
+#define SID_CRYPTO_STATS_HIST_BUCKETS (16)
+
+enum sid_crypto_stats_op {
+	SID_CRYPTO_STATS_OP_HASH,
+	SID_CRYPTO_STATS_OP_HMAC,
+	SID_CRYPTO_STATS_OP_AES_CTR,
+	SID_CRYPTO_STATS_OP_AES_CMAC,
+	SID_CRYPTO_STATS_OP_AEAD_GCM,
+	SID_CRYPTO_STATS_OP_AEAD_CCM,
+	SID_CRYPTO_STATS_OP_EDDSA,
+	SID_CRYPTO_STATS_OP_ECDSA,
+	SID_CRYPTO_STATS_OP_ECDH,
+	SID_CRYPTO_STATS_OP_KEY_GEN,
+	SID_CRYPTO_STATS_OP_COUNT,
+};
+
+struct sid_crypto_op_stats {
+	uint32_t calls;
+	uint32_t errors;
+	uint64_t bytes;
+	uint64_t time_total_us;
+	uint32_t time_max_us;
+	uint32_t hist[SID_CRYPTO_STATS_HIST_BUCKETS];
+};
+
+struct sid_crypto_stats {
+	struct sid_crypto_op_stats op[SID_CRYPTO_STATS_OP_COUNT];
+};
+
+/**
+ * @brief Verify a set of signatures (e.g. certificate chain) in one call.
+ *
+ * Signatures are verified in order and verification stops on the first failure.
+ * Public keys are kept in the verification key cache, so keys repeated in the chain
+ * are imported only once.
+ *
+ * @param params - array of signature parameters, mode of each entry must be SID_PAL_CRYPTO_VERIFY.
+ * @param count - number of entries in params.
+ * @param failed_index - index of the entry which failed verification (can be NULL).
+ *
+ * @return SID_ERROR_NONE when all signatures are valid, otherwise error code of the first failure.
+ */
+sid_error_t sid_pal_crypto_ecc_dsa_verify_chain(sid_pal_dsa_params_t *params, size_t count,
+						size_t *failed_index);
+
+/**
+ * @brief Get a consistent copy of the crypto performance counters.
+ *
+ * @param stats - destination for the counters.
+ *
+ * @return SID_ERROR_NOSUPPORT when CONFIG_SIDEWALK_CRYPTO_STATS is disabled.
+ */
+sid_error_t sid_crypto_stats_snapshot(struct sid_crypto_stats *stats);
+
+/**
+ * @brief Clear all crypto performance counters.
+ */
+void sid_crypto_stats_reset(void);
+
+/**
+ * @brief Get printable name of the crypto operation.
+ *
+ * @param op - operation.
+ *
+ * @return operation name or "unknown".
+ */
+const char *sid_crypto_stats_op_name(enum sid_crypto_stats_op op);
+
+#endif /* SID_CRYPTO_EXT_H */
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SID_LOG_CONTROL_H
+#define SID_LOG_CONTROL_H
+
+#include <sid_error.h>
+#include <sid_pal_log_ifc.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Module of the Sidewalk protocol logs (SID_PAL_LOG macros). */
+#define SID_LOG_CONTROL_PROTOCOL_MODULE "sidewalk"
+
+/** Maximum module name length, without null terminator. */
+#define SID_LOG_CONTROL_MODULE_NAME_MAX (23)
+
+/**
+ * @brief Restore log levels stored in the KV storage.
+ *
+ * Has to be called after sid_pal_storage_kv_init.
+ *
+ * @return SID_ERROR_NONE on success, or when no levels are stored.
+ */
+sid_error_t sid_log_control_init(void);
+
+/**
+ * @brief Set runtime log level of the module.
+ *
+ * The protocol module controls the SID_PAL_LOG macros, other modules are Zephyr log sources
+ * (requires CONFIG_LOG_RUNTIME_FILTERING). Logs above the compiled log level stay disabled.
+ *
+ * @param module - module name.
+ * @param level - new log level.
+ * @param persist - store the level in the KV storage.
+ *
+ * @return SID_ERROR_NONE on success.
+ *	   SID_ERROR_NOT_FOUND if the module does not exist.
+ *	   SID_ERROR_NOSUPPORT for Zephyr modules without runtime filtering.
+ *	   SID_ERROR_OUT_OF_RESOURCES if no more levels can be stored.
+ */
+sid_error_t sid_log_control_set_level(const char *module, sid_pal_log_severity_t level,
+				      bool persist);
+
+/**
+ * @brief Set runtime log level of the module and store it from the system work queue.
+ *
+ * The level is applied at once, the KV storage write is deferred, so it can be called where
+ * waiting for flash is not allowed, like the Bluetooth RX thread. Storage errors are logged.
+ *
+ * @param module - module name.
+ * @param level - new log level.
+ *
+ * @return Same as sid_log_control_set_level.
+ */
+sid_error_t sid_log_control_set_level_deferred(const char *module, sid_pal_log_severity_t level);
+
+/**
+ * @brief Get runtime log level of the module.
+ *
+ * @param module - module name.
+ * @param level - current log level.
+ *
+ * @return SID_ERROR_NONE on success.
+ */
+sid_error_t sid_log_control_get_level(const char *module, sid_pal_log_severity_t *level);
+
+/**
+ * @brief Get name and level of the n-th stored module level.
+ *
+ * @param index - entry index.
+ * @param module - buffer of SID_LOG_CONTROL_MODULE_NAME_MAX + 1 bytes for the module name.
+ * @param level - stored log level.
+ *
+ * @return SID_ERROR_NONE on success, SID_ERROR_NOT_FOUND if there is no such entry.
+ */
+sid_error_t sid_log_control_get_stored(size_t index, char *module, sid_pal_log_severity_t *level);
+
+/**
+ * @brief Restore compiled log levels of the protocol and stored modules, erase stored levels.
+ *
+ * @return SID_ERROR_NONE on success.
+ */
+sid_error_t sid_log_control_reset(void);
+
+#endif /* SID_LOG_CONTROL_H */
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SID_LOG_EXT_H
+#define SID_LOG_EXT_H
+
+#include <stdint.h>
+
+/**
+ * @brief Wait until the log thread processes all buffered messages.
+ *
+ * The caller sleeps until the log thread signals that the buffer is empty,
+ * sid_pal_log_flush calls it with CONFIG_SIDEWALK_LOG_FLUSH_TIMEOUT_MS.
+ *
+ * @param timeout_ms - maximum time to wait.
+ *
+ * @return 0 when all messages are processed.
+ *	   -EAGAIN on timeout.
+ *	   -EWOULDBLOCK when called from an interrupt with messages pending.
+ */
+int sid_log_flush_wait(int32_t timeout_ms);
+
+/**
+ * @brief Process all buffered messages synchronously and switch logging to panic mode.
+ *
+ * For fatal paths only, logging stays in panic (blocking) mode until reset.
+ */
+void sid_log_panic_flush(void);
+
+#endif /* SID_LOG_EXT_H */
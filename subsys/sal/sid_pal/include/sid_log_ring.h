@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SID_LOG_RING_H
+#define SID_LOG_RING_H
+
+#include <sid_pal_log_ifc.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Binary log record stored in the log ring.
+ *
+ * The message is kept as a cbprintf package (format string pointer and raw arguments),
+ * it can be formatted with @ref sid_log_ring_format.
+ */
+struct sid_log_record {
+	uint32_t seq;
+	uint32_t timestamp_ms;
+	sid_pal_log_severity_t severity;
+	const uint8_t *package;
+	size_t package_len;
+};
+
+/**
+ * @brief Called for each record during drain.
+ *
+ * The record is valid only during the callback.
+ *
+ * @param record - log record.
+ * @param ctx - user context.
+ *
+ * @return true if the record was consumed, false to stop the drain and keep the record.
+ */
+typedef bool (*sid_log_ring_drain_cb_t)(const struct sid_log_record *record, void *ctx);
+
+/**
+ * @brief Store log message in the ring, the oldest record is overwritten when the ring is full.
+ *
+ * Lock-free, can be called from any context. The record is dropped and counted when another
+ * writer still owns the same slot.
+ *
+ * @param severity - log severity.
+ * @param fmt - format string.
+ * @param args - format arguments.
+ */
+void sid_log_ring_put(sid_pal_log_severity_t severity, const char *fmt, va_list args);
+
+/**
+ * @brief Pass stored records to the callback, from the oldest one.
+ *
+ * Only one reader is supported at a time.
+ *
+ * @param cb - record callback.
+ * @param ctx - user context passed to the callback.
+ * @param max_records - maximum number of records to consume, SIZE_MAX for all.
+ *
+ * @return number of consumed records.
+ */
+size_t sid_log_ring_drain(sid_log_ring_drain_cb_t cb, void *ctx, size_t max_records);
+
+/**
+ * @brief Format log record into string.
+ *
+ * @param record - log record.
+ * @param buf - output buffer, the string is always null terminated.
+ * @param size - size of the output buffer.
+ *
+ * @return length of the string in buf.
+ */
+size_t sid_log_ring_format(const struct sid_log_record *record, char *buf, size_t size);
+
+/**
+ * @brief Get number of records lost since the last reset.
+ *
+ * @return records overwritten before they were drained or too long to be stored.
+ */
+uint32_t sid_log_ring_dropped(void);
+
+/**
+ * @brief Discard all stored records and clear the drop counter.
+ */
+void sid_log_ring_reset(void);
+
+#endif /* SID_LOG_RING_H */
@@ -20,6 +20,9 @@
 #include <sid_pal_storage_kv_ifc.h>
 #include <sid_pal_mfg_store_ifc.h>
 #include <sid_pal_temperature_ifc.h>
+#if defined(CONFIG_SIDEWALK_LOG_CONTROL)
+#include <sid_log_control.h>
+#endif /* CONFIG_SIDEWALK_LOG_CONTROL */
 
 LOG_MODULE_REGISTER(sid_board_init, CONFIG_SIDEWALK_LOG_LEVEL);
 
@@ -35,6 +38,13 @@ sid_error_t application_pal_init(void)
 		return ret_code;
 	}
 
+#if defined(CONFIG_SIDEWALK_LOG_CONTROL)
+	ret_code = sid_log_control_init();
+	if (ret_code) {
+		LOG_WRN("Sidewalk log levels not restored, err: %d", ret_code);
+	}
+#endif /* CONFIG_SIDEWALK_LOG_CONTROL */
+
 	ret_code = sid_pal_crypto_init();
 	if (ret_code) {
 		LOG_ERR("Sidewalk Init Crypto HAL, err: %d", ret_code);
@@ -11,8 +11,15 @@
 #include <sid_pal_assert_ifc.h>
 #include <zephyr/sys/__assert.h>
 
+#if defined(CONFIG_SIDEWALK_LOG)
+#include <sid_log_ext.h>
+#endif /* CONFIG_SIDEWALK_LOG */
+
 void sid_pal_assert(int line, const char *file)
 {
+#if defined(CONFIG_SIDEWALK_LOG)
+	sid_log_panic_flush();
+#endif /* CONFIG_SIDEWALK_LOG */
 #if defined(CONFIG_ASSERT)
 #if defined(CONFIG_ASSERT_NO_FILE_INFO)
 	ARG_UNUSED(line);
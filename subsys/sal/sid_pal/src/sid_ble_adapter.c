@@ -10,16 +10,11 @@
 
 #include <sid_pal_ble_adapter_ifc.h>
 #include <sid_ble_service.h>
-#include <sid_ble_ama_service.h>
-#if defined(CONFIG_SIDEWALK_VENDOR_SERVICE)
-#include <sid_ble_vnd_service.h>
-#endif /* CONFIG_SIDEWALK_VENDOR_SERVICE */
-#if defined(CONFIG_SIDEWALK_LOGGING_SERVICE)
-#include <sid_ble_log_service.h>
-#endif /* CONFIG_SIDEWALK_LOGGING_SERVICE */
 #include <sid_ble_adapter_callbacks.h>
 #include <sid_ble_advert.h>
 #include <sid_ble_connection.h>
+#include <sid_ble_rx.h>
+#include <sid_ble_vnd_l2cap.h>
 
 #if defined(CONFIG_MAC_ADDRESS_TYPE_PUBLIC)
 #include <zephyr/bluetooth/controller.h>
@@ -92,7 +87,20 @@ static sid_error_t ble_adapter_init(const sid_ble_config_t *cfg)
 		return SID_ERROR_INVALID_ARGS;
 	}
 
+	err_code = sid_ble_service_init();
+	if (err_code) {
+		LOG_ERR("BLE service init failed (err %d)", err_code);
+		return SID_ERROR_GENERIC;
+	}
+
+	err_code = sid_ble_vnd_l2cap_init();
+	if (err_code) {
+		LOG_ERR("Vendor L2CAP channel init failed (err %d)", err_code);
+		return SID_ERROR_GENERIC;
+	}
+
 	sid_ble_conn_init();
+	sid_ble_rx_init();
 
 	return SID_ERROR_NONE;
 }
@@ -153,32 +161,35 @@ static sid_error_t ble_adapter_send_data(sid_ble_cfg_service_identifier_t id, ui
 	sid_ble_srv_params_t srv_params = {};
 
 	switch (id) {
-	case AMA_SERVICE: {
-		srv_params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
-		srv_params.service = (struct bt_gatt_service_static *)sid_ble_get_ama_service();
-		break;
-	}
+	case AMA_SERVICE:
 #if defined(CONFIG_SIDEWALK_VENDOR_SERVICE)
-	case VENDOR_SERVICE: {
-		srv_params.uuid = VND_SID_BT_CHARACTERISTIC_NOTIFY;
-		srv_params.service = (struct bt_gatt_service_static *)sid_ble_get_vnd_service();
-		break;
-	}
+	case VENDOR_SERVICE:
 #endif /* CONFIG_SIDEWALK_VENDOR_SERVICE */
 #if defined(CONFIG_SIDEWALK_LOGGING_SERVICE)
-	case LOGGING_SERVICE: {
-		srv_params.uuid = LOG_SID_BT_CHARACTERISTIC_NOTIFY;
-		srv_params.service = (struct bt_gatt_service_static *)sid_ble_get_log_service();
-		break;
-	}
+	case LOGGING_SERVICE:
 #endif /* CONFIG_SIDEWALK_LOGGING_SERVICE */
+		break;
 	default:
 		return SID_ERROR_NOSUPPORT;
 	}
 
-	srv_params.conn = sid_ble_conn_params_get()->conn;
+	/* The reference keeps the connection valid if it is disconnected during the send. */
+	srv_params.id = id;
+	srv_params.conn = sid_ble_conn_active_ref();
+	if (!srv_params.conn) {
+		return SID_ERROR_GENERIC;
+	}
+
+	int err_code = -ENOTCONN;
+
+	if (VENDOR_SERVICE == id) {
+		err_code = sid_ble_vnd_l2cap_send(srv_params.conn, data, length);
+	}
+	if (-ENOTCONN == err_code) {
+		err_code = sid_ble_send_data(&srv_params, data, length);
+	}
+	bt_conn_unref(srv_params.conn);
 
-	int err_code = sid_ble_send_data(&srv_params, data, length);
 	if (-EINVAL == err_code) {
 		return SID_ERROR_INVALID_ARGS;
 	} else if (0 > err_code) {
@@ -246,6 +257,8 @@ static sid_error_t ble_adapter_deinit(void)
 {
 	LOG_DBG("Sidewalk -> BLE");
 	sid_ble_conn_deinit();
+	sid_ble_rx_deinit();
+	sid_ble_advert_deinit();
 
 	int err = bt_disable();
 
@@ -9,6 +9,7 @@
  */
 
 #include <sid_ble_adapter_callbacks.h>
+#include <sid_ble_trace.h>
 
 #include <zephyr/types.h>
 #include <zephyr/logging/log.h>
@@ -29,6 +30,7 @@ static sid_pal_ble_indication_callback_t notify_sent_cb;
 static sid_pal_ble_connection_callback_t connection_cb;
 static sid_pal_ble_mtu_callback_t mtu_changed_cb;
 static sid_pal_ble_adv_start_callback_t adv_start_cb;
+static sid_ble_link_params_callback_t link_params_cb;
 
 sid_error_t sid_ble_adapter_notification_cb_set(sid_pal_ble_indication_callback_t cb)
 {
@@ -54,6 +56,7 @@ void sid_ble_adapter_data_write(sid_ble_cfg_service_identifier_t id, uint8_t *da
 {
 	LOG_DBG("BLE -> Sidewalk");
 	if (data_cb) {
+		sid_ble_trace_rx_dispatch();
 		data_cb(id, data, length);
 	}
 }
@@ -122,3 +125,17 @@ void sid_ble_adapter_adv_started(void)
 		adv_start_cb();
 	}
 }
+
+sid_error_t sid_ble_adapter_link_params_cb_set(sid_ble_link_params_callback_t cb)
+{
+	CALLBACK_SET(link_params_cb, cb);
+	return SID_ERROR_NONE;
+}
+
+void sid_ble_adapter_link_params_changed(const sid_ble_link_params_t *params)
+{
+	LOG_DBG("BLE -> Sidewalk");
+	if (link_params_cb) {
+		link_params_cb(params);
+	}
+}
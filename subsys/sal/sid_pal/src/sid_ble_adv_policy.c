@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_adv_policy.c
+ *  @brief Adaptive fast advertising window.
+ *
+ * The window covers the smoothed time-to-connect plus four mean deviations, as the
+ * retransmission timeout of RFC 6298, and shrinks with the share of sessions which end
+ * with a connection the window can serve. Without samples the window is
+ * SIDEWALK_BLE_ADV_INT_TRANSITION.
+ */
+
+#include <sid_ble_adv_policy.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#define FAST_MIN_MS (CONFIG_SIDEWALK_BLE_ADV_POLICY_FAST_MIN * MSEC_PER_SEC)
+#define FAST_MAX_MS (CONFIG_SIDEWALK_BLE_ADV_POLICY_FAST_MAX * MSEC_PER_SEC)
+#define FAST_DEFAULT_MS (CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION * MSEC_PER_SEC)
+#define BURST_MS (CONFIG_SIDEWALK_BLE_ADV_POLICY_BURST)
+/* Slow advertising time which pays for one burst. */
+#define BURST_PERIOD_MS (BURST_MS * 100 / CONFIG_SIDEWALK_BLE_ADV_POLICY_BURST_DUTY)
+
+#define HIT_RATE_MAX (1000)
+/* A device nobody connects to still advertises fast for an eighth of the window. */
+#define HIT_RATE_FLOOR (125)
+
+BUILD_ASSERT(CONFIG_SIDEWALK_BLE_ADV_POLICY_FAST_MIN <= CONFIG_SIDEWALK_BLE_ADV_POLICY_FAST_MAX,
+	     "SIDEWALK_BLE_ADV_POLICY_FAST_MIN is larger than SIDEWALK_BLE_ADV_POLICY_FAST_MAX");
+
+static struct {
+	bool advertising;
+	bool ttc_valid;
+	bool update_valid;
+	/* The fast advertising is a burst, not the window after start. */
+	bool burst;
+	uint32_t start_ms;
+	/* End of the fast window or of the burst. */
+	uint32_t fast_end_ms;
+	uint32_t burst_next_ms;
+	uint32_t update_last_ms;
+	struct sid_ble_adv_policy_stats stats;
+} policy = {
+	.stats.hit_rate = HIT_RATE_MAX,
+};
+
+static struct k_spinlock lock;
+
+static bool time_before(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) < 0;
+}
+
+/* Exponentially weighted moving average with weight 1/2^shift. */
+static uint32_t ewma(uint32_t avg, uint32_t sample, uint8_t shift)
+{
+	return (uint32_t)((int32_t)avg + (((int32_t)sample - (int32_t)avg) >> shift));
+}
+
+static uint32_t fast_window_get(void)
+{
+	uint64_t window = FAST_DEFAULT_MS;
+
+	if (policy.ttc_valid) {
+		window = policy.stats.ttc_avg_ms + 4 * policy.stats.ttc_dev_ms;
+	}
+	window = window * MAX(policy.stats.hit_rate, HIT_RATE_FLOOR) / HIT_RATE_MAX;
+
+	return CLAMP(window, FAST_MIN_MS, FAST_MAX_MS);
+}
+
+static void ttc_sample(uint32_t ttc_ms)
+{
+	if (!policy.ttc_valid) {
+		policy.stats.ttc_avg_ms = ttc_ms;
+		policy.stats.ttc_dev_ms = ttc_ms / 2;
+		policy.ttc_valid = true;
+		return;
+	}
+
+	uint32_t dev = (ttc_ms > policy.stats.ttc_avg_ms) ? ttc_ms - policy.stats.ttc_avg_ms :
+							       policy.stats.ttc_avg_ms - ttc_ms;
+
+	policy.stats.ttc_dev_ms = ewma(policy.stats.ttc_dev_ms, dev, 2);
+	policy.stats.ttc_avg_ms = ewma(policy.stats.ttc_avg_ms, ttc_ms, 3);
+}
+
+void sid_ble_adv_policy_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(&policy, 0, sizeof(policy));
+	policy.stats.hit_rate = HIT_RATE_MAX;
+	k_spin_unlock(&lock, key);
+}
+
+uint32_t sid_ble_adv_policy_start(uint32_t now_ms)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t window = fast_window_get();
+
+	policy.advertising = true;
+	policy.start_ms = now_ms;
+	policy.fast_end_ms = now_ms + window;
+	policy.burst_next_ms = policy.fast_end_ms;
+	policy.burst = false;
+	policy.stats.sessions++;
+	policy.stats.fast_window_ms = window;
+	k_spin_unlock(&lock, key);
+
+	return window;
+}
+
+void sid_ble_adv_policy_connected(uint32_t now_ms)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (policy.advertising) {
+		uint32_t ttc_ms = now_ms - policy.start_ms;
+		bool fast = !time_before(policy.fast_end_ms, now_ms);
+
+		policy.stats.connections++;
+		if (fast) {
+			policy.stats.fast_connections++;
+		}
+		/* Connections in a burst follow the update, not the start. Late connections are
+		 * misses, they come in slow advertising anyway.
+		 */
+		if (!(fast && policy.burst)) {
+			if (ttc_ms <= FAST_MAX_MS) {
+				ttc_sample(ttc_ms);
+			}
+			policy.stats.hit_rate = ewma(policy.stats.hit_rate,
+						     (ttc_ms <= FAST_MAX_MS) ? HIT_RATE_MAX : 0, 3);
+		}
+		policy.advertising = false;
+	}
+	k_spin_unlock(&lock, key);
+}
+
+void sid_ble_adv_policy_stopped(uint32_t now_ms)
+{
+	ARG_UNUSED(now_ms);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (policy.advertising) {
+		policy.stats.hit_rate = ewma(policy.stats.hit_rate, 0, 3);
+		policy.advertising = false;
+	}
+	k_spin_unlock(&lock, key);
+}
+
+uint32_t sid_ble_adv_policy_data_updated(uint32_t now_ms)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t burst_ms = 0;
+
+	policy.stats.data_updates++;
+	if (policy.update_valid) {
+		policy.stats.update_interval_ms =
+			ewma(policy.stats.update_interval_ms, now_ms - policy.update_last_ms, 3);
+	}
+	policy.update_last_ms = now_ms;
+	policy.update_valid = true;
+
+	/* Bursts only in slow advertising. */
+	if (BURST_MS && policy.advertising && time_before(policy.fast_end_ms, now_ms)) {
+		if (time_before(now_ms, policy.burst_next_ms)) {
+			policy.stats.bursts_suppressed++;
+		} else {
+			burst_ms = BURST_MS;
+			policy.fast_end_ms = now_ms + BURST_MS;
+			policy.burst_next_ms = now_ms + BURST_PERIOD_MS;
+			policy.burst = true;
+			policy.stats.bursts++;
+		}
+	}
+	k_spin_unlock(&lock, key);
+
+	return burst_ms;
+}
+
+void sid_ble_adv_policy_stats_get(struct sid_ble_adv_policy_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = policy.stats;
+	k_spin_unlock(&lock, key);
+}
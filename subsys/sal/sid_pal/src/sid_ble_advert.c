@@ -8,10 +8,14 @@
 #include <zephyr/sys/util.h>
 #include <sid_ble_advert.h>
 #include <sid_ble_uuid.h>
+#if defined(CONFIG_SIDEWALK_BLE_ADV_POLICY)
+#include <sid_ble_adv_policy.h>
+#endif /* CONFIG_SIDEWALK_BLE_ADV_POLICY */
 
 #include <sid_ble_uuid.h>
 
 #include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/logging/log.h>
@@ -20,12 +24,19 @@ LOG_MODULE_REGISTER(sid_ble_advert, CONFIG_SIDEWALK_BLE_ADAPTER_LOG_LEVEL);
 
 #define MS_TO_INTERVAL_VAL(ms) (uint16_t)((ms) / 0.625f)
 
+#if defined(CONFIG_SIDEWALK_BLE_ADV_EXT)
+/* Advertising sets are not restarted by the host after a connection. */
+#define AMA_ADV_OPT_ONE_TIME 0
+#else
+#define AMA_ADV_OPT_ONE_TIME BT_LE_ADV_OPT_ONE_TIME
+#endif /* CONFIG_SIDEWALK_BLE_ADV_EXT */
+
 #if defined(CONFIG_MAC_ADDRESS_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE)
 #define AMA_ADV_OPTIONS (BT_LE_ADV_OPT_USE_NAME | BT_LE_ADV_OPT_FORCE_NAME_IN_AD)
 #else
 #define AMA_ADV_OPTIONS                                                                            \
 	(BT_LE_ADV_OPT_CONNECTABLE | BT_LE_ADV_OPT_USE_NAME | BT_LE_ADV_OPT_FORCE_NAME_IN_AD |     \
-	 BT_LE_ADV_OPT_ONE_TIME)
+	 AMA_ADV_OPT_ONE_TIME)
 #endif
 
 #if 10240 < (CONFIG_SIDEWALK_BLE_ADV_INT_FAST + CONFIG_SIDEWALK_BLE_ADV_INT_PRECISION)
@@ -104,16 +115,267 @@ static uint8_t advert_manuf_data_copy(uint8_t *data, uint8_t data_len)
 	return new_data_len + ama_id_len;
 }
 
+#if defined(CONFIG_SIDEWALK_BLE_ADV_POLICY)
+static k_timeout_t fast_window_start(void)
+{
+	uint32_t window_ms = sid_ble_adv_policy_start(k_uptime_get_32());
+
+	LOG_DBG("Fast advertising for %u ms", window_ms);
+	return K_MSEC(window_ms);
+}
+#else
+static k_timeout_t fast_window_start(void)
+{
+	return K_SECONDS(CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION);
+}
+#endif /* CONFIG_SIDEWALK_BLE_ADV_POLICY */
+
+#if defined(CONFIG_SIDEWALK_BLE_ADV_EXT)
+/* The slow set is started before the fast one is stopped, there is no gap in advertising. */
+enum adv_set_id { ADV_SET_FAST, ADV_SET_SLOW, ADV_SET_COUNT };
+
+BUILD_ASSERT(CONFIG_BT_EXT_ADV_MAX_ADV_SET >=
+		     ADV_SET_COUNT + IS_ENABLED(CONFIG_SIDEWALK_DFU_ADV_SET),
+	     "Not enough advertising sets, increase CONFIG_BT_EXT_ADV_MAX_ADV_SET");
+
+static struct bt_le_ext_adv *adv_sets[ADV_SET_COUNT];
+
+static void adv_connected(struct bt_le_ext_adv *adv, struct bt_le_ext_adv_connected_info *info)
+{
+	ARG_UNUSED(info);
+
+	/* The host stops the set which got connected, the other one is stopped here. The state is
+	 * cleared first, an interval change which is already running stops the set it started.
+	 */
+	atomic_set(&adv_state, BLE_ADV_DISABLE);
+	k_work_cancel_delayable(&change_adv_work);
+#if defined(CONFIG_SIDEWALK_BLE_ADV_POLICY)
+	sid_ble_adv_policy_connected(k_uptime_get_32());
+#endif /* CONFIG_SIDEWALK_BLE_ADV_POLICY */
+	for (size_t i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		if (adv_sets[i] && adv_sets[i] != adv) {
+			(void)bt_le_ext_adv_stop(adv_sets[i]);
+		}
+	}
+}
+
+static const struct bt_le_ext_adv_cb adv_callbacks = {
+	.connected = adv_connected,
+};
+
+static int adv_sets_create(void)
+{
+	int err;
+
+	if (!adv_sets[ADV_SET_FAST]) {
+		err = bt_le_ext_adv_create(AMA_ADV_PARAM_FAST, &adv_callbacks,
+					   &adv_sets[ADV_SET_FAST]);
+		if (err) {
+			return err;
+		}
+	}
+
+	if (!adv_sets[ADV_SET_SLOW]) {
+		err = bt_le_ext_adv_create(AMA_ADV_PARAM_SLOW, &adv_callbacks,
+					   &adv_sets[ADV_SET_SLOW]);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+/* The host forgets its sets on bt_disable(), they are deleted and created again on start. */
+static int adv_sets_delete(void)
+{
+	int err = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		if (!adv_sets[i]) {
+			continue;
+		}
+
+		int set_err = bt_le_ext_adv_stop(adv_sets[i]);
+
+		if (!set_err) {
+			set_err = bt_le_ext_adv_delete(adv_sets[i]);
+		}
+		if (!set_err) {
+			adv_sets[i] = NULL;
+		}
+		err = err ? err : set_err;
+	}
+
+	return err;
+}
+
+static int advert_data_apply(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		int err = bt_le_ext_adv_set_data(adv_sets[i], adv_data, ARRAY_SIZE(adv_data), NULL,
+						 0);
+
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
 static void change_advertisement_interval(struct k_work *work)
 {
 	ARG_UNUSED(work);
+	if (BLE_ADV_ENABLE != atomic_get(&adv_state)) {
+		return;
+	}
+
+	int err = bt_le_ext_adv_start(adv_sets[ADV_SET_SLOW], BT_LE_EXT_ADV_START_DEFAULT);
+
+	if (err) {
+		LOG_WRN("Slow advertising start failed (err %d), fast advertising continues", err);
+		k_work_reschedule(&change_adv_work,
+				  K_SECONDS(CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION));
+		return;
+	}
+
+	/* A connection or a stop may have come while the set was started. */
+	if (BLE_ADV_ENABLE != atomic_get(&adv_state)) {
+		(void)bt_le_ext_adv_stop(adv_sets[ADV_SET_SLOW]);
+		return;
+	}
+
+	err = bt_le_ext_adv_stop(adv_sets[ADV_SET_FAST]);
+	if (err) {
+		LOG_WRN("Fast advertising stop failed (err %d)", err);
+	}
+	LOG_DBG("BLE -> BLE");
+}
+
+#if defined(CONFIG_SIDEWALK_BLE_ADV_POLICY)
+static void advert_burst_start(uint32_t burst_ms)
+{
+	int err = bt_le_ext_adv_start(adv_sets[ADV_SET_FAST], BT_LE_EXT_ADV_START_DEFAULT);
+
+	if (err) {
+		LOG_WRN("Fast advertising burst failed (err %d)", err);
+		return;
+	}
+	(void)bt_le_ext_adv_stop(adv_sets[ADV_SET_SLOW]);
+	k_work_reschedule(&change_adv_work, K_MSEC(burst_ms));
+}
+#endif /* CONFIG_SIDEWALK_BLE_ADV_POLICY */
+
+int sid_ble_advert_start(void)
+{
+	int err = adv_sets_create();
+
+	if (!err) {
+		err = advert_data_apply();
+	}
+	if (!err) {
+		(void)bt_le_ext_adv_stop(adv_sets[ADV_SET_SLOW]);
+		err = bt_le_ext_adv_start(adv_sets[ADV_SET_FAST], BT_LE_EXT_ADV_START_DEFAULT);
+	}
+	if (err) {
+		return err;
+	}
+
+	atomic_set(&adv_state, BLE_ADV_ENABLE);
+	k_work_reschedule(&change_adv_work, fast_window_start());
+
+#if defined(CONFIG_MAC_ADDRESS_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE)
+	static struct bt_le_oob oob;
+	(void)bt_le_oob_get_local(BT_ID_DEFAULT, &oob);
+#endif
+
+	return err;
+}
+
+int sid_ble_advert_stop(void)
+{
+	struct k_work_sync sync;
+	int err;
+
+	atomic_set(&adv_state, BLE_ADV_DISABLE);
+	(void)k_work_cancel_delayable_sync(&change_adv_work, &sync);
+	err = adv_sets_delete();
+
+	if (0 == err) {
+#if defined(CONFIG_SIDEWALK_BLE_ADV_POLICY)
+		sid_ble_adv_policy_stopped(k_uptime_get_32());
+#endif /* CONFIG_SIDEWALK_BLE_ADV_POLICY */
+	}
+
+	return err;
+}
+
+void sid_ble_advert_deinit(void)
+{
+	struct k_work_sync sync;
+
+	atomic_set(&adv_state, BLE_ADV_DISABLE);
+	(void)k_work_cancel_delayable_sync(&change_adv_work, &sync);
+	if (adv_sets_delete()) {
+		LOG_WRN("Advertising sets not deleted");
+	}
+}
+#else
+#if defined(CONFIG_SIDEWALK_BLE_ADV_POLICY)
+/* The host stops the one time advertising on connection, the policy learns it here. */
+static void adv_conn_connected(struct bt_conn *conn, uint8_t err)
+{
+	struct bt_conn_info info;
+
+	if (err || bt_conn_get_info(conn, &info) || BT_CONN_ROLE_PERIPHERAL != info.role) {
+		return;
+	}
 	if (BLE_ADV_ENABLE == atomic_get(&adv_state)) {
-		if (bt_le_adv_stop()) {
+		sid_ble_adv_policy_connected(k_uptime_get_32());
+	}
+}
+
+static struct bt_conn_cb adv_conn_callbacks = {
+	.connected = adv_conn_connected,
+};
+
+static void advert_burst_start(uint32_t burst_ms)
+{
+	if (bt_le_adv_stop()) {
+		LOG_WRN("Slow advertising stop failed, no burst");
+		return;
+	}
+	if (bt_le_adv_start(AMA_ADV_PARAM_FAST, adv_data, ARRAY_SIZE(adv_data), NULL, 0)) {
+		LOG_WRN("Fast advertising burst failed, slow advertising restarted");
+		if (bt_le_adv_start(AMA_ADV_PARAM_SLOW, adv_data, ARRAY_SIZE(adv_data), NULL, 0)) {
+			LOG_ERR("Advertising stopped");
 			atomic_set(&adv_state, BLE_ADV_DISABLE);
+		}
+		return;
+	}
+	k_work_reschedule(&change_adv_work, K_MSEC(burst_ms));
+}
+#endif /* CONFIG_SIDEWALK_BLE_ADV_POLICY */
+
+static void change_advertisement_interval(struct k_work *work)
+{
+	ARG_UNUSED(work);
+	if (BLE_ADV_ENABLE == atomic_get(&adv_state)) {
+		if (bt_le_adv_stop()) {
+			/* The fast advertising continues, the change is retried. */
+			LOG_WRN("Fast advertising stop failed");
+			k_work_reschedule(&change_adv_work,
+					  K_SECONDS(CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION));
 			return;
 		}
 		if (bt_le_adv_start(AMA_ADV_PARAM_SLOW, adv_data, ARRAY_SIZE(adv_data), NULL, 0)) {
-			atomic_set(&adv_state, BLE_ADV_DISABLE);
+			LOG_WRN("Slow advertising start failed, fast advertising restarted");
+			if (bt_le_adv_start(AMA_ADV_PARAM_FAST, adv_data, ARRAY_SIZE(adv_data), NULL,
+					    0)) {
+				LOG_ERR("Advertising stopped");
+				atomic_set(&adv_state, BLE_ADV_DISABLE);
+			}
 			return;
 		}
 		LOG_DBG("BLE -> BLE");
@@ -122,13 +384,21 @@ static void change_advertisement_interval(struct k_work *work)
 
 int sid_ble_advert_start(void)
 {
-	k_work_reschedule(&change_adv_work, K_SECONDS(CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION));
+#if defined(CONFIG_SIDEWALK_BLE_ADV_POLICY)
+	static bool bt_conn_registered;
+
+	if (!bt_conn_registered) {
+		bt_conn_cb_register(&adv_conn_callbacks);
+		bt_conn_registered = true;
+	}
+#endif /* CONFIG_SIDEWALK_BLE_ADV_POLICY */
 	int err = bt_le_adv_start(AMA_ADV_PARAM_FAST, adv_data, ARRAY_SIZE(adv_data), NULL, 0);
 
 	if (err) {
 		return err;
 	}
 	atomic_set(&adv_state, BLE_ADV_ENABLE);
+	k_work_reschedule(&change_adv_work, fast_window_start());
 
 #if defined(CONFIG_MAC_ADDRESS_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE)
 	static struct bt_le_oob oob;
@@ -144,12 +414,29 @@ int sid_ble_advert_stop(void)
 	int err = bt_le_adv_stop();
 
 	if (0 == err) {
+#if defined(CONFIG_SIDEWALK_BLE_ADV_POLICY)
+		sid_ble_adv_policy_stopped(k_uptime_get_32());
+#endif /* CONFIG_SIDEWALK_BLE_ADV_POLICY */
 		atomic_set(&adv_state, BLE_ADV_DISABLE);
 	}
 
 	return err;
 }
 
+void sid_ble_advert_deinit(void)
+{
+	struct k_work_sync sync;
+
+	atomic_set(&adv_state, BLE_ADV_DISABLE);
+	(void)k_work_cancel_delayable_sync(&change_adv_work, &sync);
+}
+
+static int advert_data_apply(void)
+{
+	return bt_le_adv_update_data(adv_data, ARRAY_SIZE(adv_data), NULL, 0);
+}
+#endif /* CONFIG_SIDEWALK_BLE_ADV_EXT */
+
 int sid_ble_advert_update(uint8_t *data, uint8_t data_len)
 {
 	if (!data || 0 == data_len) {
@@ -161,8 +448,19 @@ int sid_ble_advert_update(uint8_t *data, uint8_t data_len)
 	int err = 0;
 
 	if (BLE_ADV_ENABLE == atomic_get(&adv_state)) {
-		err = bt_le_adv_update_data(adv_data, ARRAY_SIZE(adv_data), NULL, 0);
+		err = advert_data_apply();
+	}
+
+#if defined(CONFIG_SIDEWALK_BLE_ADV_POLICY)
+	uint32_t burst_ms = sid_ble_adv_policy_data_updated(k_uptime_get_32());
+
+	/* A pending interval change means the fast advertising is still on. */
+	if (!err && burst_ms && BLE_ADV_ENABLE == atomic_get(&adv_state) &&
+	    !k_work_delayable_is_pending(&change_adv_work)) {
+		LOG_DBG("Fast advertising burst for %u ms", burst_ms);
+		advert_burst_start(burst_ms);
 	}
+#endif /* CONFIG_SIDEWALK_BLE_ADV_POLICY */
 
 	return err;
 }
@@ -10,6 +10,9 @@
 
 #include <sid_ble_ama_service.h>
 #include <sid_ble_adapter_callbacks.h>
+#include <sid_ble_connection.h>
+#include <sid_ble_rx.h>
+#include <sid_ble_trace.h>
 
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/gatt.h>
@@ -44,13 +47,18 @@ static ssize_t ama_srv_on_write(struct bt_conn *conn, const struct bt_gatt_attr
 				const void *buf, uint16_t len, uint16_t offset, uint8_t flags)
 {
 	ARG_UNUSED(attr);
-	ARG_UNUSED(conn);
 	ARG_UNUSED(offset);
 	ARG_UNUSED(flags);
 
+	sid_ble_trace_rx_write();
 	LOG_DBG("Data received for AMA_SERVICE [len=%d].", len);
 
-	sid_ble_adapter_data_write(AMA_SERVICE, (uint8_t *)buf, len);
+	if (!sid_ble_conn_rx(conn)) {
+		return BT_GATT_ERR(BT_ATT_ERR_WRITE_NOT_PERMITTED);
+	}
+	if (sid_ble_rx_put(conn, AMA_SERVICE, buf, len)) {
+		return BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES);
+	}
 	return len;
 }
 
@@ -6,6 +6,7 @@
 
 #include <sid_ble_connection.h>
 #include <sid_ble_adapter_callbacks.h>
+#include <sid_ble_rx.h>
 
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/gatt.h>
@@ -15,6 +16,7 @@
 #include <hci_utils.h>
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 K_MUTEX_DEFINE(bt_conn_mutex);
 
 LOG_MODULE_REGISTER(sid_ble_conn, CONFIG_SIDEWALK_LOG_LEVEL);
@@ -23,16 +25,394 @@ static void ble_connect_cb(struct bt_conn *conn, uint8_t err);
 static void ble_disconnect_cb(struct bt_conn *conn, uint8_t reason);
 static void ble_mtu_cb(struct bt_conn *conn, uint16_t tx_mtu, uint16_t rx_mtu);
 
-static sid_ble_conn_params_t conn_params;
-static sid_ble_conn_params_t *p_conn_params_out;
+struct conn_entry {
+	sid_ble_conn_params_t params;
+	/* Uptime of the last Sidewalk data, or of the connection. */
+	int64_t rx_uptime_ms;
+#if !defined(CONFIG_SIDEWALK_BLE_LINK_POLICY_NONE)
+	struct k_work_delayable link_work;
+	atomic_t link_step;
+	sid_ble_link_params_t link_params;
+#if defined(CONFIG_SIDEWALK_BLE_LINK_MTU)
+	struct bt_gatt_exchange_params mtu_exchange;
+#endif /* CONFIG_SIDEWALK_BLE_LINK_MTU */
+#endif /* !CONFIG_SIDEWALK_BLE_LINK_POLICY_NONE */
+};
+
+/* Indexed by bt_conn_index(). */
+static struct conn_entry conns[SID_BLE_CONN_MAX];
+static struct conn_entry *active = &conns[0];
+/* Connection of the active entry, published for readers which do not take bt_conn_mutex.
+ * It holds the reference of the entry, so it is cleared before that reference is dropped.
+ */
+static atomic_ptr_t active_conn;
+static bool conn_enabled;
+
+#if !defined(CONFIG_SIDEWALK_BLE_LINK_POLICY_NONE)
+/* Link layer procedures requested after connection, in order. */
+enum link_step {
+	LINK_STEP_START,
+	LINK_STEP_DATA_LEN,
+	LINK_STEP_PHY,
+	LINK_STEP_MTU,
+	LINK_STEP_CONN_PARAM,
+	LINK_STEP_DONE,
+};
+
+static void ble_le_param_updated_cb(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+				    uint16_t timeout);
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+static void ble_le_phy_updated_cb(struct bt_conn *conn, struct bt_conn_le_phy_info *param);
+#endif /* CONFIG_BT_USER_PHY_UPDATE */
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+static void ble_le_data_len_updated_cb(struct bt_conn *conn, struct bt_conn_le_data_len_info *info);
+#endif /* CONFIG_BT_USER_DATA_LEN_UPDATE */
+#endif /* !CONFIG_SIDEWALK_BLE_LINK_POLICY_NONE */
 
 static struct bt_conn_cb conn_callbacks = {
 	.connected = ble_connect_cb,
 	.disconnected = ble_disconnect_cb,
+#if !defined(CONFIG_SIDEWALK_BLE_LINK_POLICY_NONE)
+	.le_param_updated = ble_le_param_updated_cb,
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+	.le_phy_updated = ble_le_phy_updated_cb,
+#endif /* CONFIG_BT_USER_PHY_UPDATE */
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+	.le_data_len_updated = ble_le_data_len_updated_cb,
+#endif /* CONFIG_BT_USER_DATA_LEN_UPDATE */
+#endif /* !CONFIG_SIDEWALK_BLE_LINK_POLICY_NONE */
 };
 
 static struct bt_gatt_cb gatt_callbacks = { .att_mtu_updated = ble_mtu_cb };
 
+static struct conn_entry *conn_entry_get(const struct bt_conn *conn)
+{
+	uint8_t index;
+
+	if (!conn) {
+		return NULL;
+	}
+
+	index = bt_conn_index(conn);
+	if (index >= ARRAY_SIZE(conns) || conns[index].params.conn != conn) {
+		return NULL;
+	}
+
+	return &conns[index];
+}
+
+#if !defined(CONFIG_SIDEWALK_BLE_LINK_POLICY_NONE)
+static int link_step_request(struct conn_entry *entry, struct bt_conn *conn, enum link_step step)
+{
+	switch (step) {
+#if defined(CONFIG_SIDEWALK_BLE_LINK_DATA_LEN)
+	case LINK_STEP_DATA_LEN:
+		return bt_conn_le_data_len_update(conn, BT_LE_DATA_LEN_PARAM_MAX);
+#endif /* CONFIG_SIDEWALK_BLE_LINK_DATA_LEN */
+#if defined(CONFIG_SIDEWALK_BLE_LINK_PHY_2M)
+	case LINK_STEP_PHY:
+		return bt_conn_le_phy_update(conn, BT_CONN_LE_PHY_PARAM_2M);
+#endif /* CONFIG_SIDEWALK_BLE_LINK_PHY_2M */
+#if defined(CONFIG_SIDEWALK_BLE_LINK_MTU)
+	case LINK_STEP_MTU:
+		return bt_gatt_exchange_mtu(conn, &entry->mtu_exchange);
+#endif /* CONFIG_SIDEWALK_BLE_LINK_MTU */
+	case LINK_STEP_CONN_PARAM:
+		return bt_conn_le_param_update(
+			conn, BT_LE_CONN_PARAM(CONFIG_SIDEWALK_BLE_LINK_INTERVAL_MIN,
+					       CONFIG_SIDEWALK_BLE_LINK_INTERVAL_MAX,
+					       CONFIG_SIDEWALK_BLE_LINK_LATENCY,
+					       CONFIG_SIDEWALK_BLE_LINK_TIMEOUT));
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static void link_params_report(struct conn_entry *entry, struct bt_conn *conn)
+{
+	sid_ble_link_params_t link_params;
+	uint16_t mtu = bt_gatt_get_mtu(conn);
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	entry->link_params.mtu = mtu;
+	link_params = entry->link_params;
+	k_mutex_unlock(&bt_conn_mutex);
+
+	uint32_t interval_us = link_params.interval * 1250U;
+
+	LOG_INF("Link %u interval %u.%02u ms, latency %u, timeout %u ms", bt_conn_index(conn),
+		interval_us / 1000U, (interval_us % 1000U) / 10U, link_params.latency,
+		link_params.timeout * 10U);
+	LOG_INF("Link %u MTU %u, data length tx %u rx %u, PHY tx %u rx %u", bt_conn_index(conn),
+		link_params.mtu, link_params.tx_max_len, link_params.rx_max_len,
+		link_params.tx_phy, link_params.rx_phy);
+
+	sid_ble_adapter_link_params_changed(&link_params);
+}
+
+/**
+ * @brief Request the next procedure of the link policy.
+ *
+ * Runs when the current procedure completes or its timeout expires. Procedures which are
+ * disabled, not needed or rejected are skipped.
+ */
+static void link_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct conn_entry *entry = CONTAINER_OF(dwork, struct conn_entry, link_work);
+	struct bt_conn *conn = NULL;
+	atomic_val_t step = atomic_get(&entry->link_step);
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	if (entry->params.conn && step != LINK_STEP_DONE) {
+		conn = bt_conn_ref(entry->params.conn);
+	}
+	k_mutex_unlock(&bt_conn_mutex);
+
+	if (!conn) {
+		return;
+	}
+
+	for (step++; step < LINK_STEP_DONE; step++) {
+		int err = link_step_request(entry, conn, step);
+
+		if (!err) {
+			atomic_set(&entry->link_step, step);
+			k_work_reschedule(&entry->link_work,
+					  K_MSEC(CONFIG_SIDEWALK_BLE_LINK_STEP_TIMEOUT_MS));
+			bt_conn_unref(conn);
+			return;
+		}
+
+		if (err != -ENOTSUP && err != -EALREADY) {
+			LOG_WRN("Link procedure %d failed (err %d)", (int)step, err);
+		}
+	}
+
+	atomic_set(&entry->link_step, LINK_STEP_DONE);
+	link_params_report(entry, conn);
+	bt_conn_unref(conn);
+}
+
+static void link_step_complete(struct conn_entry *entry, enum link_step step)
+{
+	if (atomic_get(&entry->link_step) == step) {
+		k_work_reschedule(&entry->link_work, K_NO_WAIT);
+	}
+}
+
+static void link_negotiation_start(struct conn_entry *entry, struct bt_conn *conn)
+{
+	sid_ble_link_params_t link_params = { 0 };
+	struct bt_conn_info info = { 0 };
+
+	if (!bt_conn_get_info(conn, &info)) {
+		link_params.interval = info.le.interval;
+		link_params.latency = info.le.latency;
+		link_params.timeout = info.le.timeout;
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+		if (info.le.phy) {
+			link_params.tx_phy = info.le.phy->tx_phy;
+			link_params.rx_phy = info.le.phy->rx_phy;
+		}
+#endif /* CONFIG_BT_USER_PHY_UPDATE */
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+		if (info.le.data_len) {
+			link_params.tx_max_len = info.le.data_len->tx_max_len;
+			link_params.rx_max_len = info.le.data_len->rx_max_len;
+		}
+#endif /* CONFIG_BT_USER_DATA_LEN_UPDATE */
+	}
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	entry->link_params = link_params;
+	k_mutex_unlock(&bt_conn_mutex);
+
+	atomic_set(&entry->link_step, LINK_STEP_START);
+	k_work_reschedule(&entry->link_work, K_NO_WAIT);
+}
+
+static void link_negotiation_stop(struct conn_entry *entry)
+{
+	atomic_set(&entry->link_step, LINK_STEP_DONE);
+	(void)k_work_cancel_delayable(&entry->link_work);
+}
+
+static void ble_le_param_updated_cb(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+				    uint16_t timeout)
+{
+	struct conn_entry *entry;
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	entry = conn_entry_get(conn);
+	if (entry) {
+		entry->link_params.interval = interval;
+		entry->link_params.latency = latency;
+		entry->link_params.timeout = timeout;
+	}
+	k_mutex_unlock(&bt_conn_mutex);
+
+	if (entry) {
+		link_step_complete(entry, LINK_STEP_CONN_PARAM);
+	}
+}
+
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+static void ble_le_phy_updated_cb(struct bt_conn *conn, struct bt_conn_le_phy_info *param)
+{
+	struct conn_entry *entry;
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	entry = conn_entry_get(conn);
+	if (entry) {
+		entry->link_params.tx_phy = param->tx_phy;
+		entry->link_params.rx_phy = param->rx_phy;
+	}
+	k_mutex_unlock(&bt_conn_mutex);
+
+	if (entry) {
+		link_step_complete(entry, LINK_STEP_PHY);
+	}
+}
+#endif /* CONFIG_BT_USER_PHY_UPDATE */
+
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+static void ble_le_data_len_updated_cb(struct bt_conn *conn, struct bt_conn_le_data_len_info *info)
+{
+	struct conn_entry *entry;
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	entry = conn_entry_get(conn);
+	if (entry) {
+		entry->link_params.tx_max_len = info->tx_max_len;
+		entry->link_params.rx_max_len = info->rx_max_len;
+	}
+	k_mutex_unlock(&bt_conn_mutex);
+
+	if (entry) {
+		link_step_complete(entry, LINK_STEP_DATA_LEN);
+	}
+}
+#endif /* CONFIG_BT_USER_DATA_LEN_UPDATE */
+
+#if defined(CONFIG_SIDEWALK_BLE_LINK_MTU)
+static void ble_mtu_exchange_cb(struct bt_conn *conn, uint8_t err,
+				struct bt_gatt_exchange_params *params)
+{
+	struct conn_entry *entry = conn_entry_get(conn);
+
+	ARG_UNUSED(params);
+
+	if (err) {
+		LOG_WRN("MTU exchange failed (err %u)", err);
+	}
+	if (entry) {
+		link_step_complete(entry, LINK_STEP_MTU);
+	}
+}
+#endif /* CONFIG_SIDEWALK_BLE_LINK_MTU */
+
+static void link_negotiation_init(struct conn_entry *entry)
+{
+	atomic_set(&entry->link_step, LINK_STEP_DONE);
+	k_work_init_delayable(&entry->link_work, link_work_handler);
+#if defined(CONFIG_SIDEWALK_BLE_LINK_MTU)
+	entry->mtu_exchange.func = ble_mtu_exchange_cb;
+#endif /* CONFIG_SIDEWALK_BLE_LINK_MTU */
+}
+#else
+static inline void link_negotiation_init(struct conn_entry *entry)
+{
+}
+
+static inline void link_negotiation_start(struct conn_entry *entry, struct bt_conn *conn)
+{
+}
+
+static inline void link_negotiation_stop(struct conn_entry *entry)
+{
+}
+#endif /* !CONFIG_SIDEWALK_BLE_LINK_POLICY_NONE */
+
+/**
+ * @brief Make the entry active and publish its connection.
+ *
+ * Called with bt_conn_mutex locked.
+ */
+static void active_set(struct conn_entry *entry)
+{
+	active = entry;
+	atomic_ptr_set(&active_conn, entry->params.conn);
+}
+
+/**
+ * @brief Connection events for the protocol, which knows a single link.
+ *
+ * They are collected with bt_conn_mutex locked and passed on after it is unlocked, so the
+ * protocol can call back into the adapter. The Bluetooth host calls the connection and GATT
+ * callbacks from one thread, so the events are passed on in order.
+ */
+struct conn_report {
+	bool disconnected;
+	bool connected;
+	uint16_t mtu;
+	uint8_t disconnected_addr[BT_ADDR_SIZE];
+	uint8_t connected_addr[BT_ADDR_SIZE];
+};
+
+/**
+ * @brief Report the previous active connection closed.
+ *
+ * Called with bt_conn_mutex locked.
+ */
+static void report_disconnected(struct conn_report *report, const struct conn_entry *entry)
+{
+	report->disconnected = true;
+	memcpy(report->disconnected_addr, entry->params.addr, BT_ADDR_SIZE);
+}
+
+/**
+ * @brief Report the active connection opened, with its MTU when it is known.
+ *
+ * Called with bt_conn_mutex locked.
+ */
+static void report_connected(struct conn_report *report)
+{
+	report->connected = true;
+	memcpy(report->connected_addr, active->params.addr, BT_ADDR_SIZE);
+	report->mtu = active->params.mtu;
+}
+
+static void report_send(const struct conn_report *report)
+{
+	if (report->disconnected) {
+		sid_ble_adapter_conn_disconnected(report->disconnected_addr);
+	}
+	if (report->connected) {
+		sid_ble_adapter_conn_connected(report->connected_addr);
+	}
+	if (report->mtu) {
+		sid_ble_adapter_mtu_changed(report->mtu);
+	}
+}
+
+/**
+ * @brief Make an other connection active when the active one is closed.
+ *
+ * Called with bt_conn_mutex locked.
+ */
+static void active_conn_replace(struct conn_report *report)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].params.conn) {
+			active_set(&conns[i]);
+			LOG_INF("Active connection %u", i);
+			report_connected(report);
+			return;
+		}
+	}
+}
+
 /**
  * @brief The function is called when a new connection is established.
  *
@@ -46,22 +426,43 @@ static void ble_connect_cb(struct bt_conn *conn, uint8_t err)
 		return;
 	}
 
+	uint8_t index = bt_conn_index(conn);
+
+	if (index >= ARRAY_SIZE(conns)) {
+		LOG_ERR("Connection index %u out of range", index);
+		return;
+	}
+
+	struct conn_entry *entry = &conns[index];
 	const bt_addr_le_t *bt_addr_le = bt_conn_get_dst(conn);
+	struct conn_report report = { 0 };
 
 	if (bt_addr_le) {
-		memcpy(conn_params.addr, bt_addr_le->a.val, BT_ADDR_SIZE);
+		memcpy(entry->params.addr, bt_addr_le->a.val, BT_ADDR_SIZE);
 	} else {
 		LOG_ERR("Connection bt address not found.");
-		memset(conn_params.addr, 0x00, BT_ADDR_SIZE);
+		memset(entry->params.addr, 0x00, BT_ADDR_SIZE);
 	}
 
 	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
-	conn_params.conn = bt_conn_ref(conn);
-
-	sid_ble_adapter_conn_connected((const uint8_t *)conn_params.addr);
+	entry->params.conn = bt_conn_ref(conn);
+	entry->params.mtu = bt_gatt_get_mtu(conn);
+	/* A peer connecting later does not take over the data of the active one, the protocol
+	 * learns about it when it becomes active.
+	 */
+	entry->rx_uptime_ms = k_uptime_get();
+	if (!active->params.conn || active == entry) {
+		active_set(entry);
+		report.connected = true;
+		memcpy(report.connected_addr, entry->params.addr, BT_ADDR_SIZE);
+	}
 	k_mutex_unlock(&bt_conn_mutex);
 
-	LOG_INF("BT Connected");
+	report_send(&report);
+
+	LOG_INF("BT Connected %u", index);
+
+	link_negotiation_start(entry, conn);
 }
 
 /**
@@ -72,55 +473,175 @@ static void ble_connect_cb(struct bt_conn *conn, uint8_t err)
  */
 static void ble_disconnect_cb(struct bt_conn *conn, uint8_t reason)
 {
-	if (!conn || conn_params.conn != conn) {
+	struct conn_entry *entry;
+	struct bt_conn *entry_conn;
+	struct conn_report report = { 0 };
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	entry = conn_entry_get(conn);
+	k_mutex_unlock(&bt_conn_mutex);
+
+	if (!entry) {
 		LOG_WRN("Unknow connection");
 		return;
 	}
-	sid_ble_adapter_conn_disconnected((const uint8_t *)conn_params.addr);
+	link_negotiation_stop(entry);
+	sid_ble_rx_conn_flush(conn);
 
 	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
-	bt_conn_unref(conn_params.conn);
-	conn_params.conn = NULL;
+	entry_conn = entry->params.conn;
+	entry->params.conn = NULL;
+	entry->params.mtu = 0;
+	/* Only the active connection is known to the protocol. */
+	if (entry == active) {
+		atomic_ptr_clear(&active_conn);
+		report_disconnected(&report, entry);
+		active_conn_replace(&report);
+	}
+	/* Readers which got the connection before it was unpublished hold their own reference. */
+	bt_conn_unref(entry_conn);
 	k_mutex_unlock(&bt_conn_mutex);
 
+	report_send(&report);
+
 	LOG_INF("BT Disconnected Reason: 0x%x = %s", reason, HCI_err_to_str(reason));
 }
 
 static void ble_mtu_cb(struct bt_conn *conn, uint16_t tx_mtu, uint16_t rx_mtu)
 {
-	ARG_UNUSED(rx_mtu);
+	struct conn_entry *entry;
+	bool report;
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	entry = conn_entry_get(conn);
+	if (entry) {
+		entry->params.mtu = MIN(tx_mtu, rx_mtu);
+	}
+	report = (!active->params.conn || active == entry);
+	k_mutex_unlock(&bt_conn_mutex);
 
-	if (!conn_params.conn || conn_params.conn == conn) {
+	if (report) {
 		sid_ble_adapter_mtu_changed(MIN(tx_mtu, rx_mtu));
 	}
 }
 
 const sid_ble_conn_params_t *sid_ble_conn_params_get(void)
 {
-	return (const sid_ble_conn_params_t *)p_conn_params_out;
+	return conn_enabled ? &active->params : NULL;
+}
+
+struct bt_conn *sid_ble_conn_active_ref(void)
+{
+	struct bt_conn *conn;
+	struct bt_conn *ref;
+
+	if (!conn_enabled) {
+		return NULL;
+	}
+
+	/* The connection can be unpublished between its load and its reference. Then the
+	 * reference fails if the host has released the connection, or it is to a connection
+	 * which is not the active one any more. Both are let go and the load is retried, which
+	 * happens only when the active connection changes.
+	 */
+	for (;;) {
+		conn = atomic_ptr_get(&active_conn);
+		if (!conn) {
+			return NULL;
+		}
+
+		ref = bt_conn_ref(conn);
+		if (atomic_ptr_get(&active_conn) == conn) {
+			return ref;
+		}
+
+		if (ref) {
+			bt_conn_unref(ref);
+		}
+	}
+}
+
+const sid_ble_conn_params_t *sid_ble_conn_params_find(const struct bt_conn *conn)
+{
+	struct conn_entry *entry = conn_entry_get(conn);
+
+	return entry ? &entry->params : NULL;
+}
+
+bool sid_ble_conn_rx(struct bt_conn *conn)
+{
+	struct conn_entry *entry;
+	struct conn_report report = { 0 };
+	struct bt_conn *previous = NULL;
+	bool accepted = true;
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	entry = conn_entry_get(conn);
+	if (entry && entry != active) {
+		/* An other central takes over only when the active one is gone or idle, so two
+		 * centrals writing at the same time do not tear down each other's session.
+		 */
+		if (active->params.conn &&
+		    now - active->rx_uptime_ms < CONFIG_SIDEWALK_BLE_CONN_SWITCH_HOLDOFF_MS) {
+			accepted = false;
+		} else {
+			/* The protocol sees the previous link closed and the new one opened. */
+			if (active->params.conn) {
+				previous = bt_conn_ref(active->params.conn);
+				report_disconnected(&report, active);
+			}
+			active_set(entry);
+			LOG_INF("Active connection %u", bt_conn_index(conn));
+			report_connected(&report);
+		}
+	}
+	if (entry && accepted) {
+		entry->rx_uptime_ms = now;
+	}
+	k_mutex_unlock(&bt_conn_mutex);
+
+	if (!accepted) {
+		LOG_DBG("Data from inactive connection %u ignored", bt_conn_index(conn));
+	}
+	if (previous) {
+		/* Data of the previous link is not delivered after it is reported closed. */
+		sid_ble_rx_conn_flush(previous);
+		bt_conn_unref(previous);
+	}
+	report_send(&report);
+
+	return accepted;
 }
 
 void sid_ble_conn_init(void)
 {
-	p_conn_params_out = &conn_params;
 	static bool bt_conn_registered;
 
 	if (!bt_conn_registered) {
+		for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+			link_negotiation_init(&conns[i]);
+		}
 		bt_conn_cb_register(&conn_callbacks);
 		bt_gatt_cb_register(&gatt_callbacks);
 		bt_conn_registered = true;
 	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		link_negotiation_stop(&conns[i]);
+	}
+	conn_enabled = true;
 }
 
 int sid_ble_conn_disconnect(void)
 {
-	if (!conn_params.conn) {
-		return -ENOENT;
-	}
+	int err = -ENOENT;
 
+	/* The entry holds a reference of its connection while the mutex is locked. */
 	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
-	int err = bt_conn_disconnect(conn_params.conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
-
+	if (active->params.conn) {
+		err = bt_conn_disconnect(active->params.conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	}
 	k_mutex_unlock(&bt_conn_mutex);
 
 	return err;
@@ -128,5 +649,8 @@ int sid_ble_conn_disconnect(void)
 
 void sid_ble_conn_deinit(void)
 {
-	p_conn_params_out = NULL;
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		link_negotiation_stop(&conns[i]);
+	}
+	conn_enabled = false;
 }
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_log_backend.c
+ *  @brief Log backend streaming over the Bluetooth low energy logging service.
+ */
+
+#include <sid_ble_log_backend.h>
+#include <sid_ble_log_service.h>
+#include <sid_ble_connection.h>
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_output.h>
+
+/* ATT notification opcode and attribute handle. */
+#define NOTIFY_HDR_SIZE (3)
+#define BATCH_SIZE_MAX (CONFIG_BT_L2CAP_TX_MTU - NOTIFY_HDR_SIZE)
+#define RECORD_SIZE_MAX (CONFIG_SIDEWALK_LOG_BACKEND_BLE_RECORD_SIZE)
+#define DROPPED_MAX (UINT16_MAX)
+
+static uint8_t output_buf[32];
+static uint8_t record[RECORD_SIZE_MAX];
+static size_t record_len;
+
+static uint8_t batch[BATCH_SIZE_MAX];
+static size_t batch_len;
+static size_t batch_records;
+static uint32_t batch_reported;
+
+static const struct bt_gatt_attr *notify_attr;
+static uint32_t log_format = IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) ? LOG_OUTPUT_DICT :
+									 LOG_OUTPUT_TEXT;
+static bool panic_mode;
+static atomic_t dropped;
+
+static K_MUTEX_DEFINE(batch_lock);
+static K_SEM_DEFINE(tx_credits, CONFIG_SIDEWALK_LOG_BACKEND_BLE_TX_CREDITS,
+		    CONFIG_SIDEWALK_LOG_BACKEND_BLE_TX_CREDITS);
+
+static void flush_work_handler(struct k_work *work);
+static K_WORK_DEFINE(flush_work, flush_work_handler);
+
+static int record_out(uint8_t *data, size_t length, void *ctx)
+{
+	size_t space = sizeof(record) - record_len;
+
+	ARG_UNUSED(ctx);
+
+	/* Message is truncated to the record size. */
+	memcpy(&record[record_len], data, MIN(length, space));
+	record_len += MIN(length, space);
+
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(log_output_sid_ble, record_out, output_buf, sizeof(output_buf));
+
+static void drop_count(uint32_t count)
+{
+	atomic_val_t current;
+
+	do {
+		current = atomic_get(&dropped);
+		if (current >= DROPPED_MAX) {
+			return;
+		}
+	} while (!atomic_cas(&dropped, current, MIN(current + count, DROPPED_MAX)));
+}
+
+uint32_t sid_ble_log_backend_dropped(void)
+{
+	return (uint32_t)atomic_get(&dropped);
+}
+
+static const struct bt_gatt_attr *notify_attr_get(void)
+{
+	if (!notify_attr) {
+		const struct bt_gatt_service_static *srv = sid_ble_get_log_service();
+
+		notify_attr = bt_gatt_find_by_uuid(srv->attrs, srv->attr_count,
+						   LOG_SID_BT_CHARACTERISTIC_NOTIFY);
+	}
+
+	return notify_attr;
+}
+
+/* Returns a reference to the active connection, released by the caller with bt_conn_unref(). */
+static struct bt_conn *stream_conn_get(size_t *payload_max)
+{
+	struct bt_conn *conn;
+
+	if (!notify_attr_get()) {
+		return NULL;
+	}
+
+	conn = sid_ble_conn_active_ref();
+	if (!conn) {
+		return NULL;
+	}
+
+	if (!bt_gatt_is_subscribed(conn, notify_attr, BT_GATT_CCC_NOTIFY)) {
+		bt_conn_unref(conn);
+		return NULL;
+	}
+
+	*payload_max = MIN(bt_gatt_get_mtu(conn) - NOTIFY_HDR_SIZE, sizeof(batch));
+
+	return conn;
+}
+
+static void notify_sent(struct bt_conn *conn, void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(user_data);
+
+	k_sem_give(&tx_credits);
+	k_work_submit(&flush_work);
+}
+
+static void batch_reset(void)
+{
+	uint32_t count = (uint32_t)atomic_get(&dropped);
+
+	batch_len = 0;
+	batch_records = 0;
+	batch_reported = 0;
+
+	/* Drops are reported in front of the following records. */
+	if (count) {
+		batch[batch_len++] = sizeof(uint16_t);
+		batch[batch_len++] = SID_BLE_LOG_RECORD_DROPPED;
+		sys_put_le16((uint16_t)count, &batch[batch_len]);
+		batch_len += sizeof(uint16_t);
+		batch_reported = count;
+		atomic_sub(&dropped, (atomic_val_t)count);
+	}
+}
+
+static int batch_send(struct bt_conn *conn)
+{
+	struct bt_gatt_notify_params params = {
+		.attr = notify_attr,
+		.data = batch,
+		.len = batch_len,
+		.func = notify_sent,
+	};
+
+	if (!batch_len) {
+		return 0;
+	}
+
+	/* Back-pressure, the batch is kept until a notification is sent. */
+	if (k_sem_take(&tx_credits, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+
+	/* Notification data is copied, the batch can be reused when the call returns. */
+	if (bt_gatt_notify_cb(conn, &params)) {
+		k_sem_give(&tx_credits);
+		drop_count(batch_records + batch_reported);
+	}
+	batch_reset();
+
+	return 0;
+}
+
+static int batch_add(struct bt_conn *conn, size_t payload_max, uint8_t type, const uint8_t *data,
+		     size_t len)
+{
+	size_t size = SID_BLE_LOG_RECORD_HDR_SIZE + len;
+
+	if (size > payload_max) {
+		return -EMSGSIZE;
+	}
+
+	if (batch_len + size > payload_max && batch_send(conn)) {
+		return -EBUSY;
+	}
+
+	batch[batch_len++] = (uint8_t)len;
+	batch[batch_len++] = type;
+	memcpy(&batch[batch_len], data, len);
+	batch_len += len;
+	batch_records++;
+
+	return 0;
+}
+
+static void flush_work_handler(struct k_work *work)
+{
+	struct bt_conn *conn;
+	size_t payload_max;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	conn = stream_conn_get(&payload_max);
+	if (conn) {
+		if (!batch_len) {
+			batch_reset();
+		}
+		(void)batch_send(conn);
+		bt_conn_unref(conn);
+	}
+	k_mutex_unlock(&batch_lock);
+}
+
+static void backend_process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	log_format_func_t log_output_func = log_format_func_t_get(log_format);
+	struct bt_conn *conn;
+	size_t payload_max;
+
+	ARG_UNUSED(backend);
+
+	if (panic_mode) {
+		return;
+	}
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	conn = stream_conn_get(&payload_max);
+	if (!conn) {
+		/* Nobody listens, pending records are discarded. */
+		batch_len = 0;
+		batch_records = 0;
+		batch_reported = 0;
+		k_mutex_unlock(&batch_lock);
+		return;
+	}
+
+	record_len = 0;
+	log_output_func(&log_output_sid_ble, &msg->log,
+			LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_TIMESTAMP | LOG_OUTPUT_FLAG_CRLF_NONE);
+
+	if (!batch_len) {
+		batch_reset();
+	}
+	if (batch_add(conn, payload_max, SID_BLE_LOG_RECORD_MSG, record, record_len)) {
+		drop_count(1);
+	}
+
+	/* Records are batched while messages are pending. */
+	if (!log_buffered_cnt()) {
+		(void)batch_send(conn);
+	}
+	k_mutex_unlock(&batch_lock);
+	bt_conn_unref(conn);
+}
+
+static void backend_dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	drop_count(cnt);
+}
+
+static void backend_panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+
+	/* Notifications can not be sent synchronously. */
+	panic_mode = true;
+}
+
+static int backend_format_set(const struct log_backend *const backend, uint32_t format)
+{
+	ARG_UNUSED(backend);
+
+	if (format != LOG_OUTPUT_TEXT &&
+	    !(IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) && format == LOG_OUTPUT_DICT)) {
+		return -ENOTSUP;
+	}
+	log_format = format;
+
+	return 0;
+}
+
+static const struct log_backend_api sid_ble_log_backend_api = {
+	.process = backend_process,
+	.dropped = backend_dropped,
+	.panic = backend_panic,
+	.format_set = backend_format_set,
+};
+
+LOG_BACKEND_DEFINE(sid_ble_log, sid_ble_log_backend_api, true);
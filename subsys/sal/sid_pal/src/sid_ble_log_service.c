@@ -10,16 +10,28 @@
 
 #include <sid_ble_log_service.h>
 #include <sid_ble_adapter_callbacks.h>
+#include <sid_ble_rx.h>
+#include <sid_ble_trace.h>
 
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/gatt.h>
 #include <zephyr/logging/log.h>
 
+#if defined(CONFIG_SIDEWALK_LOG_CONTROL_BLE)
+#include <sid_log_control.h>
+#include <string.h>
+#endif /* CONFIG_SIDEWALK_LOG_CONTROL_BLE */
+
 LOG_MODULE_REGISTER(sid_ble_log_srv, CONFIG_SIDEWALK_LOG_LEVEL);
 
 static void log_srv_notif_changed(const struct bt_gatt_attr *attr, uint16_t value);
 static ssize_t log_srv_on_write(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 				const void *buf, uint16_t len, uint16_t offset, uint8_t flags);
+#if defined(CONFIG_SIDEWALK_LOG_CONTROL_BLE)
+static ssize_t log_srv_on_control_write(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+					const void *buf, uint16_t len, uint16_t offset,
+					uint8_t flags);
+#endif /* CONFIG_SIDEWALK_LOG_CONTROL_BLE */
 
 /* VENDOR_SERVICE definition */
 BT_GATT_SERVICE_DEFINE(log_service, BT_GATT_PRIMARY_SERVICE(LOG_SID_BT_UUID_SERVICE),
@@ -29,7 +41,13 @@ BT_GATT_SERVICE_DEFINE(log_service, BT_GATT_PRIMARY_SERVICE(LOG_SID_BT_UUID_SERV
 		       BT_GATT_CHARACTERISTIC(LOG_SID_BT_CHARACTERISTIC_NOTIFY, BT_GATT_CHRC_NOTIFY,
 					      BT_GATT_PERM_NONE, NULL, NULL, NULL),
 		       BT_GATT_CCC(log_srv_notif_changed,
-				   BT_GATT_PERM_READ | BT_GATT_PERM_WRITE), );
+				   BT_GATT_PERM_READ | BT_GATT_PERM_WRITE),
+		       IF_ENABLED(CONFIG_SIDEWALK_LOG_CONTROL_BLE,
+				  (BT_GATT_CHARACTERISTIC(LOG_SID_BT_CHARACTERISTIC_CONTROL,
+							  BT_GATT_CHRC_WRITE,
+							  BT_GATT_PERM_WRITE_ENCRYPT,
+							  NULL, log_srv_on_control_write,
+							  NULL))));
 
 static void log_srv_notif_changed(const struct bt_gatt_attr *attr, uint16_t value)
 {
@@ -44,15 +62,54 @@ static ssize_t log_srv_on_write(struct bt_conn *conn, const struct bt_gatt_attr
 				const void *buf, uint16_t len, uint16_t offset, uint8_t flags)
 {
 	ARG_UNUSED(attr);
-	ARG_UNUSED(conn);
 	ARG_UNUSED(offset);
 	ARG_UNUSED(flags);
 
+	sid_ble_trace_rx_write();
 	LOG_DBG("Data received for LOGGING_SERVICE [len=%d].", len);
 
-	sid_ble_adapter_data_write(LOGGING_SERVICE, (uint8_t *)buf, len);
+	if (sid_ble_rx_put(conn, LOGGING_SERVICE, buf, len)) {
+		return BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES);
+	}
+	return len;
+}
+
+#if defined(CONFIG_SIDEWALK_LOG_CONTROL_BLE)
+static ssize_t log_srv_on_control_write(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+					const void *buf, uint16_t len, uint16_t offset,
+					uint8_t flags)
+{
+	char module[SID_LOG_CONTROL_MODULE_NAME_MAX + 1] = SID_LOG_CONTROL_PROTOCOL_MODULE;
+	const uint8_t *data = buf;
+	sid_error_t erc;
+
+	ARG_UNUSED(attr);
+	ARG_UNUSED(conn);
+	ARG_UNUSED(flags);
+
+	if (offset) {
+		return BT_GATT_ERR(BT_ATT_ERR_INVALID_OFFSET);
+	}
+
+	if (!len || len > sizeof(module)) {
+		return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+	}
+
+	if (len > 1) {
+		memcpy(module, &data[1], len - 1);
+		module[len - 1] = '\0';
+	}
+
+	/* Flash is written from the system work queue, not from the Bluetooth RX thread. */
+	erc = sid_log_control_set_level_deferred(module, (sid_pal_log_severity_t)data[0]);
+	LOG_INF("Log level of %s set to %d over BLE, err %d", module, data[0], erc);
+	if (SID_ERROR_NONE != erc) {
+		return BT_GATT_ERR(BT_ATT_ERR_VALUE_NOT_ALLOWED);
+	}
+
 	return len;
 }
+#endif /* CONFIG_SIDEWALK_LOG_CONTROL_BLE */
 
 const struct bt_gatt_service_static *sid_ble_get_log_service(void)
 {
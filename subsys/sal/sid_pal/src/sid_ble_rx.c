@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_rx.c
+ *  @brief Deferred delivery of received Sidewalk data.
+ *
+ * Records do not wrap around the end of the ring, a padding record fills the rest of it.
+ * The protocol reads the data in place, the record is released when the callback returns.
+ */
+
+#include <sid_ble_rx.h>
+#include <sid_ble_adapter_callbacks.h>
+#include <sid_ble_trace.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+
+#include <errno.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(sid_ble_rx, CONFIG_SIDEWALK_BLE_ADAPTER_LOG_LEVEL);
+
+#define RING_SIZE (ROUND_DOWN(CONFIG_SIDEWALK_BLE_RX_RING_SIZE, RECORD_ALIGN))
+#define HIGH_WATERMARK (RING_SIZE * CONFIG_SIDEWALK_BLE_RX_HIGH_WATERMARK / 100)
+
+#define RECORD_ALIGN (sizeof(struct rx_record_hdr))
+#define RECORD_SIZE(_length) (sizeof(struct rx_record_hdr) + ROUND_UP(_length, RECORD_ALIGN))
+
+/* Values of the conn field which are not a connection index. */
+#define RECORD_PADDING (0xFF)
+#define RECORD_FLUSHED (0xFE)
+
+struct rx_record_hdr {
+	uint16_t length;
+	uint8_t id;
+	uint8_t conn;
+#if defined(CONFIG_SIDEWALK_BLE_TRACE)
+	uint32_t stamp;
+#endif /* CONFIG_SIDEWALK_BLE_TRACE */
+};
+
+BUILD_ASSERT(sizeof(struct rx_record_hdr) == SID_BLE_RX_RECORD_HDR_SIZE,
+	     "SID_BLE_RX_RECORD_HDR_SIZE does not match the record header");
+BUILD_ASSERT(RECORD_SIZE(SID_BLE_RX_WRITE_MAX) <= RING_SIZE,
+	     "SID_BLE_RX_WRITE_MAX does not fit the receive ring");
+
+static uint8_t ring[RING_SIZE] __aligned(RECORD_ALIGN);
+/* Byte offsets of the next record to write and to deliver, modulo RING_SIZE in the ring. */
+static uint32_t head;
+static uint32_t tail;
+/* The record at the tail is being delivered. */
+static bool delivering;
+static struct sid_ble_rx_stats stats;
+/* Called when the next record is released, after a write was held back. */
+static sid_ble_rx_space_cb_t space_waiter;
+static struct k_spinlock lock;
+
+static K_SEM_DEFINE(rx_sem, 0, 1);
+
+static struct rx_record_hdr *record_hdr(uint32_t offset)
+{
+	return (struct rx_record_hdr *)&ring[offset % RING_SIZE];
+}
+
+/* Lock held. */
+static uint32_t records_flush(int conn_index)
+{
+	uint32_t flushed = 0;
+	uint32_t offset = tail;
+
+	if (delivering && offset != head) {
+		offset += RECORD_SIZE(record_hdr(offset)->length);
+	}
+	while (offset != head) {
+		struct rx_record_hdr *hdr = record_hdr(offset);
+
+		if (hdr->conn != RECORD_PADDING && hdr->conn != RECORD_FLUSHED &&
+		    (conn_index < 0 || hdr->conn == conn_index)) {
+			hdr->conn = RECORD_FLUSHED;
+			flushed++;
+		}
+		offset += RECORD_SIZE(hdr->length);
+	}
+	stats.flushed += flushed;
+
+	return flushed;
+}
+
+static int record_put(struct bt_conn *conn, sid_ble_cfg_service_identifier_t id,
+		      const uint8_t *data, uint16_t length, sid_ble_rx_space_cb_t space_cb)
+{
+	uint32_t need = RECORD_SIZE(length);
+	k_spinlock_key_t key;
+
+	if (need > RING_SIZE) {
+		key = k_spin_lock(&lock);
+		stats.dropped++;
+		k_spin_unlock(&lock, key);
+		LOG_WRN("Write of %u bytes does not fit the receive ring", length);
+		return -EMSGSIZE;
+	}
+
+	key = k_spin_lock(&lock);
+	if (head == tail) {
+		/* Empty, the next record starts at the beginning. */
+		head = 0;
+		tail = 0;
+	}
+
+	uint32_t contiguous = RING_SIZE - (head % RING_SIZE);
+	uint32_t padding = (contiguous < need) ? contiguous : 0;
+	bool throttled = (head != tail && head - tail + need > HIGH_WATERMARK);
+
+	if (throttled || head - tail + padding + need > RING_SIZE) {
+		if (throttled) {
+			stats.throttled++;
+		}
+		if (space_cb) {
+			/* Set under the lock, so the record which frees the space calls it. */
+			space_waiter = space_cb;
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+		/* Waiting would stall the Bluetooth RX thread, the write is lost instead. */
+		stats.dropped++;
+		k_spin_unlock(&lock, key);
+		return -ENOBUFS;
+	}
+
+	if (padding) {
+		*record_hdr(head) = (struct rx_record_hdr){
+			.length = padding - sizeof(struct rx_record_hdr),
+			.conn = RECORD_PADDING,
+		};
+		head += padding;
+	}
+
+	struct rx_record_hdr *hdr = record_hdr(head);
+
+	*hdr = (struct rx_record_hdr){
+		.length = length,
+		.id = (uint8_t)id,
+		.conn = bt_conn_index(conn),
+#if defined(CONFIG_SIDEWALK_BLE_TRACE)
+		.stamp = sid_ble_trace_rx_stamp(),
+#endif /* CONFIG_SIDEWALK_BLE_TRACE */
+	};
+	memcpy(hdr + 1, data, length);
+	head += need;
+	stats.received++;
+	stats.peak_fill = MAX(stats.peak_fill, head - tail);
+	k_spin_unlock(&lock, key);
+
+	k_sem_give(&rx_sem);
+
+	return 0;
+}
+
+int sid_ble_rx_put(struct bt_conn *conn, sid_ble_cfg_service_identifier_t id, const uint8_t *data,
+		   uint16_t length)
+{
+	return record_put(conn, id, data, length, NULL);
+}
+
+int sid_ble_rx_try_put(struct bt_conn *conn, sid_ble_cfg_service_identifier_t id,
+		       const uint8_t *data, uint16_t length, sid_ble_rx_space_cb_t space_cb)
+{
+	if (!space_cb) {
+		return -EINVAL;
+	}
+
+	return record_put(conn, id, data, length, space_cb);
+}
+
+static bool record_deliver(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (head == tail) {
+		k_spin_unlock(&lock, key);
+		return false;
+	}
+
+	struct rx_record_hdr *hdr = record_hdr(tail);
+	struct rx_record_hdr record = *hdr;
+	bool deliver = (record.conn != RECORD_PADDING && record.conn != RECORD_FLUSHED);
+
+	delivering = true;
+	k_spin_unlock(&lock, key);
+
+	/* The producer does not write the record until the tail moves past it. */
+	if (deliver) {
+		LOG_DBG("BLE RX -> Sidewalk");
+#if defined(CONFIG_SIDEWALK_BLE_TRACE)
+		sid_ble_trace_rx_deliver(record.stamp);
+#endif /* CONFIG_SIDEWALK_BLE_TRACE */
+		sid_ble_adapter_data_write((sid_ble_cfg_service_identifier_t)record.id,
+					   (uint8_t *)(hdr + 1), record.length);
+	}
+
+	key = k_spin_lock(&lock);
+	if (deliver) {
+		stats.delivered++;
+	}
+	tail += RECORD_SIZE(record.length);
+	delivering = false;
+
+	sid_ble_rx_space_cb_t space_cb = space_waiter;
+
+	space_waiter = NULL;
+	k_spin_unlock(&lock, key);
+
+	if (space_cb) {
+		space_cb();
+	}
+
+	return true;
+}
+
+void sid_ble_rx_init(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	(void)records_flush(-1);
+	memset(&stats, 0, sizeof(stats));
+	stats.peak_fill = head - tail;
+	k_spin_unlock(&lock, key);
+}
+
+void sid_ble_rx_deinit(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t flushed = records_flush(-1);
+
+	k_spin_unlock(&lock, key);
+
+	if (flushed) {
+		LOG_WRN("%u writes not delivered", flushed);
+	}
+}
+
+void sid_ble_rx_conn_flush(struct bt_conn *conn)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t flushed = records_flush(bt_conn_index(conn));
+
+	k_spin_unlock(&lock, key);
+
+	if (flushed) {
+		LOG_DBG("%u writes of disconnected peer removed", flushed);
+	}
+}
+
+void sid_ble_rx_stats_get(struct sid_ble_rx_stats *rx_stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*rx_stats = stats;
+	k_spin_unlock(&lock, key);
+}
+
+static void rx_task(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (1) {
+		k_sem_take(&rx_sem, K_FOREVER);
+		while (record_deliver()) {
+		}
+	}
+}
+
+K_THREAD_DEFINE(sid_ble_rx_thread, CONFIG_SIDEWALK_BLE_RX_STACK_SIZE, rx_task, NULL, NULL, NULL,
+		K_PRIO_COOP(CONFIG_SIDEWALK_BLE_RX_PRIORITY), 0, 0);
@@ -10,41 +10,173 @@
 
 #include <sid_ble_service.h>
 #include <sid_ble_adapter_callbacks.h>
-
+#include <sid_ble_connection.h>
+#include <sid_ble_ama_service.h>
+#include <sid_ble_trace.h>
+#if defined(CONFIG_SIDEWALK_VENDOR_SERVICE)
+#include <sid_ble_vnd_service.h>
+#endif /* CONFIG_SIDEWALK_VENDOR_SERVICE */
+#if defined(CONFIG_SIDEWALK_LOGGING_SERVICE)
+#include <sid_ble_log_service.h>
+#endif /* CONFIG_SIDEWALK_LOGGING_SERVICE */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(sid_ble_srv, CONFIG_SIDEWALK_LOG_LEVEL);
 
-static struct bt_gatt_notify_params not_params;
+/* Notifications in flight are bound by the host ACL buffers, so a send never blocks on them. */
+#if defined(CONFIG_BT_BUF_ACL_TX_COUNT)
+#define TX_CREDITS MIN(CONFIG_SIDEWALK_BLE_NOTIFY_TX_CREDITS, CONFIG_BT_BUF_ACL_TX_COUNT)
+#else
+#define TX_CREDITS (CONFIG_SIDEWALK_BLE_NOTIFY_TX_CREDITS)
+#endif /* CONFIG_BT_BUF_ACL_TX_COUNT */
+
+struct notify_srv {
+	const struct bt_gatt_service_static *(*service_get)(void);
+	const struct bt_uuid *uuid;
+};
+
+static const struct notify_srv notify_srvs[] = {
+	[AMA_SERVICE] = { sid_ble_get_ama_service, AMA_SID_BT_CHARACTERISTIC_NOTIFY },
+#if defined(CONFIG_SIDEWALK_VENDOR_SERVICE)
+	[VENDOR_SERVICE] = { sid_ble_get_vnd_service, VND_SID_BT_CHARACTERISTIC_NOTIFY },
+#endif /* CONFIG_SIDEWALK_VENDOR_SERVICE */
+#if defined(CONFIG_SIDEWALK_LOGGING_SERVICE)
+	[LOGGING_SERVICE] = { sid_ble_get_log_service, LOG_SID_BT_CHARACTERISTIC_NOTIFY },
+#endif /* CONFIG_SIDEWALK_LOGGING_SERVICE */
+};
+
+static const struct bt_gatt_attr *notify_attrs[ARRAY_SIZE(notify_srvs)];
+
+/* Notifications in flight of a connection, indexed by bt_conn_index(). */
+struct tx_queue {
+	/* A descriptor per credit, so it is not reused while its notification is in flight. */
+	struct bt_gatt_notify_params params[TX_CREDITS];
+	size_t next;
+	struct k_sem credits;
+	/* Incremented on disconnection, completions of older notifications are ignored. */
+	atomic_t generation;
+};
+
+static struct tx_queue tx_queues[SID_BLE_CONN_MAX];
+/* Index + 1 of the queue whose last send waits for a credit to be acknowledged, 0 for none. */
+static atomic_t ack_pending;
+
+static void ack_work_handler(struct k_work *work);
+static K_WORK_DEFINE(ack_work, ack_work_handler);
+
+static void ble_disconnect_cb(struct bt_conn *conn, uint8_t reason);
+
+static struct bt_conn_cb conn_callbacks = {
+	.disconnected = ble_disconnect_cb,
+};
+
+static struct tx_queue *tx_queue_get(const struct bt_conn *conn)
+{
+	uint8_t index = bt_conn_index(conn);
+
+	return (index < ARRAY_SIZE(tx_queues)) ? &tx_queues[index] : NULL;
+}
+
+static atomic_val_t tx_queue_id(const struct tx_queue *queue)
+{
+	return (atomic_val_t)(queue - tx_queues) + 1;
+}
+
+static void ack_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	sid_ble_adapter_notification_sent();
+}
 
 static void notification_sent(struct bt_conn *conn, void *user_data)
 {
-	ARG_UNUSED(user_data);
-	ARG_UNUSED(conn);
+	struct tx_queue *queue = tx_queue_get(conn);
+
+	if (!queue || (atomic_val_t)(uintptr_t)user_data != atomic_get(&queue->generation)) {
+		return;
+	}
 
 	LOG_DBG("Notification sent.");
+	sid_ble_trace_tx_sent(conn, SID_BLE_TRACE_GATT);
 
-	sid_ble_adapter_notification_sent();
+	k_sem_give(&queue->credits);
+	if (atomic_cas(&ack_pending, tx_queue_id(queue), 0)) {
+		sid_ble_adapter_notification_sent();
+	}
+}
+
+static void tx_reset(struct tx_queue *queue)
+{
+	atomic_inc(&queue->generation);
+	(void)atomic_cas(&ack_pending, tx_queue_id(queue), 0);
+	k_sem_init(&queue->credits, TX_CREDITS, TX_CREDITS);
+}
+
+static void ble_disconnect_cb(struct bt_conn *conn, uint8_t reason)
+{
+	struct tx_queue *queue = tx_queue_get(conn);
+
+	ARG_UNUSED(reason);
+
+	if (queue) {
+		tx_reset(queue);
+	}
+	sid_ble_trace_conn_reset(conn);
+}
+
+int sid_ble_service_init(void)
+{
+	static bool bt_conn_registered;
+	int err = 0;
+
+	if (!bt_conn_registered) {
+		bt_conn_cb_register(&conn_callbacks);
+		bt_conn_registered = true;
+	}
+	atomic_clear(&ack_pending);
+	(void)k_work_cancel(&ack_work);
+	for (size_t i = 0; i < ARRAY_SIZE(tx_queues); i++) {
+		tx_reset(&tx_queues[i]);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(notify_srvs); i++) {
+		const struct bt_gatt_service_static *srv;
+
+		notify_attrs[i] = NULL;
+		if (!notify_srvs[i].service_get) {
+			continue;
+		}
+
+		srv = notify_srvs[i].service_get();
+		notify_attrs[i] = bt_gatt_find_by_uuid(srv->attrs, srv->attr_count,
+						       notify_srvs[i].uuid);
+		if (!notify_attrs[i]) {
+			LOG_ERR("Notify attribute of service %d not found.", i);
+			err = -ENOENT;
+		}
+	}
+
+	return err;
 }
 
 int sid_ble_send_data(sid_ble_srv_params_t *params, uint8_t *data, uint16_t length)
 {
 	int error_code;
-	const struct bt_gatt_attr *srv_attrs = NULL;
-	uint16_t srv_attr_count = 0;
 	const struct bt_gatt_attr *attr = NULL;
+	struct tx_queue *queue;
 
 	if (!params) {
 		return -ENOENT;
 	}
 
-	if (NULL != params->service) {
-		srv_attrs = params->service->attrs;
-		srv_attr_count = params->service->attr_count;
+	if ((unsigned int)params->id < ARRAY_SIZE(notify_attrs)) {
+		attr = notify_attrs[params->id];
 	}
 
-	attr = bt_gatt_find_by_uuid(srv_attrs, srv_attr_count, params->uuid);
-
 	if (!attr) {
 		LOG_ERR("Attribute not found.");
 		return -ENOENT;
@@ -55,17 +187,43 @@ int sid_ble_send_data(sid_ble_srv_params_t *params, uint8_t *data, uint16_t leng
 		return -EINVAL;
 	}
 
-	memset(&not_params, 0, sizeof(not_params));
+	queue = tx_queue_get(params->conn);
+	if (!queue) {
+		return -ENOENT;
+	}
+
+	if (k_sem_take(&queue->credits, K_NO_WAIT)) {
+		LOG_ERR("No TX credits.");
+		return -EBUSY;
+	}
+
+	struct bt_gatt_notify_params *notify = &queue->params[queue->next];
 
-	not_params.attr = attr;
-	not_params.data = data;
-	not_params.len = length;
-	not_params.func = notification_sent;
+	queue->next = (queue->next + 1) % ARRAY_SIZE(queue->params);
+	memset(notify, 0, sizeof(*notify));
+	notify->attr = attr;
+	notify->data = data;
+	notify->len = length;
+	notify->func = notification_sent;
+	notify->user_data = (void *)(uintptr_t)atomic_get(&queue->generation);
 
-	error_code = bt_gatt_notify_cb(params->conn, &not_params);
+	sid_ble_trace_tx_submit(params->conn, SID_BLE_TRACE_GATT);
+	error_code = bt_gatt_notify_cb(params->conn, notify);
 	if (error_code) {
+		sid_ble_trace_tx_cancel(params->conn, SID_BLE_TRACE_GATT);
+		k_sem_give(&queue->credits);
 		LOG_ERR("Send err:%d.", error_code);
+		return error_code;
+	}
+
+	/* The protocol sends the next fragment when the previous one is acknowledged. It is
+	 * acknowledged at once while credits are left, so several notifications are queued for a
+	 * connection event. Otherwise the acknowledge waits for a notification to complete.
+	 */
+	atomic_set(&ack_pending, tx_queue_id(queue));
+	if (k_sem_count_get(&queue->credits) && atomic_cas(&ack_pending, tx_queue_id(queue), 0)) {
+		k_work_submit(&ack_work);
 	}
 
-	return error_code;
+	return 0;
 }
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_trace.c
+ *  @brief Latency tracepoints of the Sidewalk BLE adapter.
+ *
+ * Completions of the notifications sent in one connection event are reported together, so
+ * completions closer than half of the shortest connection interval count as one event.
+ */
+
+#include <sid_ble_trace.h>
+#include <sid_ble_connection.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#if defined(CONFIG_SIDEWALK_BLE_VND_L2CAP)
+#define TX_DEPTH MAX(CONFIG_SIDEWALK_BLE_NOTIFY_TX_CREDITS, CONFIG_SIDEWALK_BLE_VND_L2CAP_TX_COUNT)
+#else
+#define TX_DEPTH (CONFIG_SIDEWALK_BLE_NOTIFY_TX_CREDITS)
+#endif /* CONFIG_SIDEWALK_BLE_VND_L2CAP */
+#define EVENT_GAP_US (3750)
+
+/* Submit times of the packets in flight of one transport, they complete in order. */
+struct tx_fifo {
+	uint32_t submitted[TX_DEPTH];
+	uint32_t head;
+	uint32_t tail;
+};
+
+/* Packets in flight of a connection, indexed by bt_conn_index(). */
+struct tx_trace {
+	struct tx_fifo fifo[SID_BLE_TRACE_TRANSPORT_COUNT];
+	uint32_t event_last;
+	uint32_t event_notifications;
+};
+
+static struct sid_ble_trace_stats trace_stats;
+static struct tx_trace tx_traces[SID_BLE_CONN_MAX];
+static struct k_spinlock lock;
+
+/* Written on the Bluetooth RX thread. */
+static uint32_t rx_write_stamp;
+/* Written by the thread which calls the protocol. */
+static uint32_t rx_deliver_stamp;
+
+static const char *const latency_names[SID_BLE_TRACE_LATENCY_COUNT] = {
+	[SID_BLE_TRACE_RX_DISPATCH] = "rx_dispatch",
+	[SID_BLE_TRACE_TX_SENT] = "tx_sent",
+};
+
+static struct tx_fifo *tx_fifo_get(const struct bt_conn *conn,
+				   enum sid_ble_trace_transport transport)
+{
+	uint8_t index = bt_conn_index(conn);
+
+	if (index >= ARRAY_SIZE(tx_traces) || transport >= SID_BLE_TRACE_TRANSPORT_COUNT) {
+		return NULL;
+	}
+
+	return &tx_traces[index].fifo[transport];
+}
+
+static struct tx_trace *tx_trace_get(const struct bt_conn *conn)
+{
+	uint8_t index = bt_conn_index(conn);
+
+	return (index < ARRAY_SIZE(tx_traces)) ? &tx_traces[index] : NULL;
+}
+
+/* Lock held. */
+static void latency_record(enum sid_ble_trace_latency latency, uint32_t now, uint32_t stamp)
+{
+	uint32_t time_us = k_cyc_to_us_floor32(now - stamp);
+	uint32_t bucket = time_us ? (31 - __builtin_clz(time_us)) : 0;
+	struct sid_ble_trace_latency_stats *entry = &trace_stats.latency[latency];
+
+	entry->count++;
+	entry->total_us += time_us;
+	entry->max_us = MAX(entry->max_us, time_us);
+	entry->hist[MIN(bucket, SID_BLE_TRACE_HIST_BUCKETS - 1)]++;
+}
+
+/* Lock held. */
+static void event_close(struct tx_trace *trace)
+{
+	if (!trace->event_notifications) {
+		return;
+	}
+
+	trace_stats.events++;
+	trace_stats.notify_per_event[MIN(trace->event_notifications,
+					 SID_BLE_TRACE_EVENT_BUCKETS) - 1]++;
+	trace->event_notifications = 0;
+}
+
+void sid_ble_trace_rx_write(void)
+{
+	rx_write_stamp = k_cycle_get_32();
+#if !defined(CONFIG_SIDEWALK_BLE_RX_DEFERRED)
+	/* The protocol is called from the write handler. */
+	rx_deliver_stamp = rx_write_stamp;
+#endif /* CONFIG_SIDEWALK_BLE_RX_DEFERRED */
+}
+
+uint32_t sid_ble_trace_rx_stamp(void)
+{
+	return rx_write_stamp;
+}
+
+void sid_ble_trace_rx_deliver(uint32_t stamp)
+{
+	rx_deliver_stamp = stamp;
+}
+
+void sid_ble_trace_rx_dispatch(void)
+{
+	uint32_t now = k_cycle_get_32();
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	latency_record(SID_BLE_TRACE_RX_DISPATCH, now, rx_deliver_stamp);
+	k_spin_unlock(&lock, key);
+}
+
+void sid_ble_trace_tx_submit(struct bt_conn *conn, enum sid_ble_trace_transport transport)
+{
+	struct tx_fifo *fifo = tx_fifo_get(conn, transport);
+	k_spinlock_key_t key;
+
+	if (!fifo) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	if (fifo->head - fifo->tail < TX_DEPTH) {
+		fifo->submitted[fifo->head % TX_DEPTH] = k_cycle_get_32();
+		fifo->head++;
+	}
+	k_spin_unlock(&lock, key);
+}
+
+void sid_ble_trace_tx_cancel(struct bt_conn *conn, enum sid_ble_trace_transport transport)
+{
+	struct tx_fifo *fifo = tx_fifo_get(conn, transport);
+	k_spinlock_key_t key;
+
+	if (!fifo) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	if (fifo->head != fifo->tail) {
+		fifo->head--;
+	}
+	k_spin_unlock(&lock, key);
+}
+
+void sid_ble_trace_tx_sent(struct bt_conn *conn, enum sid_ble_trace_transport transport)
+{
+	struct tx_trace *trace = tx_trace_get(conn);
+	struct tx_fifo *fifo = tx_fifo_get(conn, transport);
+	uint32_t now = k_cycle_get_32();
+	k_spinlock_key_t key;
+
+	if (!trace || !fifo) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	if (fifo->head != fifo->tail) {
+		latency_record(SID_BLE_TRACE_TX_SENT, now, fifo->submitted[fifo->tail % TX_DEPTH]);
+		fifo->tail++;
+	}
+
+	if (trace->event_notifications &&
+	    k_cyc_to_us_floor32(now - trace->event_last) >= EVENT_GAP_US) {
+		event_close(trace);
+	}
+	trace->event_notifications++;
+	trace->event_last = now;
+	k_spin_unlock(&lock, key);
+}
+
+void sid_ble_trace_conn_reset(struct bt_conn *conn)
+{
+	struct tx_trace *trace = tx_trace_get(conn);
+	k_spinlock_key_t key;
+
+	if (!trace) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	event_close(trace);
+	for (size_t i = 0; i < ARRAY_SIZE(trace->fifo); i++) {
+		trace->fifo[i].tail = trace->fifo[i].head;
+	}
+	k_spin_unlock(&lock, key);
+}
+
+void sid_ble_trace_snapshot(struct sid_ble_trace_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = trace_stats;
+	k_spin_unlock(&lock, key);
+}
+
+void sid_ble_trace_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(&trace_stats, 0, sizeof(trace_stats));
+	for (size_t i = 0; i < ARRAY_SIZE(tx_traces); i++) {
+		tx_traces[i].event_notifications = 0;
+	}
+	k_spin_unlock(&lock, key);
+}
+
+const char *sid_ble_trace_latency_name(enum sid_ble_trace_latency latency)
+{
+	if (latency >= SID_BLE_TRACE_LATENCY_COUNT) {
+		return "unknown";
+	}
+
+	return latency_names[latency];
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <sid_ble_trace.h>
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+static void print_histogram(const struct shell *shell,
+			    const struct sid_ble_trace_latency_stats *stats)
+{
+	for (int i = 0; i < SID_BLE_TRACE_HIST_BUCKETS; i++) {
+		if (!stats->hist[i]) {
+			continue;
+		}
+		if (i == SID_BLE_TRACE_HIST_BUCKETS - 1) {
+			shell_print(shell, "    >= %8u us: %u", 1U << i, stats->hist[i]);
+		} else {
+			shell_print(shell, "    < %9u us: %u", 1U << (i + 1), stats->hist[i]);
+		}
+	}
+}
+
+static int cmd_ble_trace_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	static struct sid_ble_trace_stats stats;
+	bool verbose = (argc > 1 && !strcmp(argv[1], "-v"));
+
+	if (argc > 1 && !verbose) {
+		shell_error(shell, "Unknown option %s", argv[1]);
+		return -EINVAL;
+	}
+
+	sid_ble_trace_snapshot(&stats);
+
+	shell_print(shell, "%-12s %10s %10s %10s", "latency", "count", "avg [us]", "max [us]");
+	for (int i = 0; i < SID_BLE_TRACE_LATENCY_COUNT; i++) {
+		const struct sid_ble_trace_latency_stats *entry = &stats.latency[i];
+
+		if (!entry->count) {
+			continue;
+		}
+		shell_print(shell, "%-12s %10u %10llu %10u", sid_ble_trace_latency_name(i),
+			    entry->count, (unsigned long long)(entry->total_us / entry->count),
+			    entry->max_us);
+		if (verbose) {
+			print_histogram(shell, entry);
+		}
+	}
+
+	shell_print(shell, "connection events: %u", stats.events);
+	if (!verbose) {
+		return 0;
+	}
+	for (int i = 0; i < SID_BLE_TRACE_EVENT_BUCKETS; i++) {
+		if (!stats.notify_per_event[i]) {
+			continue;
+		}
+		shell_print(shell, "    %s%2d notifications: %u",
+			    (i == SID_BLE_TRACE_EVENT_BUCKETS - 1) ? ">=" : "  ", i + 1,
+			    stats.notify_per_event[i]);
+	}
+
+	return 0;
+}
+
+static int cmd_ble_trace_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	sid_ble_trace_reset();
+	shell_print(shell, "BLE trace cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_sid_ble_trace,
+	SHELL_CMD_ARG(stats, NULL,
+		      "[-v] print BLE latencies, -v adds histograms and notifications per event",
+		      cmd_ble_trace_stats, 1, 1),
+	SHELL_CMD_ARG(reset, NULL, "clear BLE latencies", cmd_ble_trace_reset, 1, 0),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(sid_ble_trace, &sub_sid_ble_trace, "Sidewalk BLE adapter latency", NULL);
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_vnd_l2cap.c
+ *  @brief Vendor data over an L2CAP connection-oriented channel.
+ *
+ * The host segments an SDU into K-frames of the peer MPS and sends them as the peer gives
+ * credits. Received SDUs are reassembled by the host and passed on as one write, the credits
+ * are returned when the data is queued for the protocol. An SDU which does not fit the receive
+ * ring is held until the ring drains, the peer has no credits left meanwhile.
+ */
+
+#include <sid_ble_vnd_l2cap.h>
+#include <sid_ble_adapter_callbacks.h>
+#include <sid_ble_connection.h>
+#include <sid_ble_rx.h>
+#include <sid_ble_trace.h>
+
+#include <zephyr/bluetooth/l2cap.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+
+#include <string.h>
+
+LOG_MODULE_REGISTER(sid_ble_vnd_l2cap, CONFIG_SIDEWALK_BLE_ADAPTER_LOG_LEVEL);
+
+#define SDU_MTU (CONFIG_SIDEWALK_BLE_VND_L2CAP_MTU)
+#define TX_COUNT (CONFIG_SIDEWALK_BLE_VND_L2CAP_TX_COUNT)
+
+#if defined(CONFIG_SIDEWALK_BLE_RX_DEFERRED)
+BUILD_ASSERT(SDU_MTU <= SID_BLE_RX_WRITE_MAX,
+	     "SIDEWALK_BLE_VND_L2CAP_MTU does not fit SIDEWALK_BLE_RX_RING_SIZE");
+#endif /* CONFIG_SIDEWALK_BLE_RX_DEFERRED */
+
+NET_BUF_POOL_FIXED_DEFINE(vnd_tx_pool, TX_COUNT, BT_L2CAP_SDU_BUF_SIZE(SDU_MTU),
+			  CONFIG_BT_CONN_TX_USER_DATA_SIZE, NULL);
+/* One SDU in reassembly per channel, it is released when the receive ring takes it. */
+NET_BUF_POOL_FIXED_DEFINE(vnd_rx_pool, SID_BLE_CONN_MAX, BT_L2CAP_SDU_BUF_SIZE(SDU_MTU),
+			  CONFIG_BT_CONN_TX_USER_DATA_SIZE, NULL);
+
+/* Vendor channel of a connection, indexed by bt_conn_index(). */
+struct vnd_chan {
+	struct bt_l2cap_le_chan le;
+	bool in_use;
+	bool connected;
+	/* SDUs of the channel which hold a TX buffer. */
+	atomic_t tx_inflight;
+	/* Received SDU which waits for space in the receive ring, under rx_mutex. */
+	struct net_buf *rx_held;
+};
+
+static struct vnd_chan vnd_chans[SID_BLE_CONN_MAX];
+
+/* TX buffers, taken by a send and given back when its SDU is sent. */
+static K_SEM_DEFINE(tx_credits, TX_COUNT, TX_COUNT);
+/* The last send waits for an SDU to be sent before it is acknowledged. */
+static atomic_t ack_pending;
+
+static void ack_work_handler(struct k_work *work);
+static K_WORK_DEFINE(ack_work, ack_work_handler);
+
+/* Orders the puts of a held SDU on the Bluetooth RX thread and on the Sidewalk BLE RX thread,
+ * so the space callback does not run before the SDU is held.
+ */
+static K_MUTEX_DEFINE(rx_mutex);
+
+static int vnd_chan_recv(struct bt_l2cap_chan *chan, struct net_buf *buf);
+static struct net_buf *vnd_chan_alloc_buf(struct bt_l2cap_chan *chan);
+static void vnd_chan_sent(struct bt_l2cap_chan *chan);
+static void vnd_chan_connected(struct bt_l2cap_chan *chan);
+static void vnd_chan_disconnected(struct bt_l2cap_chan *chan);
+static void vnd_chan_released(struct bt_l2cap_chan *chan);
+
+static const struct bt_l2cap_chan_ops vnd_chan_ops = {
+	.alloc_buf = vnd_chan_alloc_buf,
+	.recv = vnd_chan_recv,
+	.sent = vnd_chan_sent,
+	.connected = vnd_chan_connected,
+	.disconnected = vnd_chan_disconnected,
+	.released = vnd_chan_released,
+};
+
+static struct vnd_chan *vnd_chan_get(const struct bt_conn *conn)
+{
+	uint8_t index;
+
+	if (!conn) {
+		return NULL;
+	}
+
+	index = bt_conn_index(conn);
+
+	return (index < ARRAY_SIZE(vnd_chans)) ? &vnd_chans[index] : NULL;
+}
+
+static void ack_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	sid_ble_adapter_notification_sent();
+}
+
+static void rx_space_cb(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(vnd_chans); i++) {
+		struct vnd_chan *vnd = &vnd_chans[i];
+		struct net_buf *buf = NULL;
+		int err = 0;
+
+		k_mutex_lock(&rx_mutex, K_FOREVER);
+		if (vnd->rx_held) {
+			err = sid_ble_rx_try_put(vnd->le.chan.conn, VENDOR_SERVICE,
+						 vnd->rx_held->data, vnd->rx_held->len,
+						 rx_space_cb);
+			if (err != -EAGAIN) {
+				buf = vnd->rx_held;
+				vnd->rx_held = NULL;
+			}
+		}
+		k_mutex_unlock(&rx_mutex);
+
+		if (err == -EAGAIN) {
+			/* Called again when the next record is released. */
+			return;
+		}
+		if (buf) {
+			/* Gives the credits of the SDU back to the peer. */
+			(void)bt_l2cap_chan_recv_complete(&vnd->le.chan, buf);
+		}
+	}
+}
+
+static int vnd_chan_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	struct vnd_chan *vnd = CONTAINER_OF(chan, struct vnd_chan, le.chan);
+	int err;
+
+	sid_ble_trace_rx_write();
+	LOG_DBG("Data received for VENDOR_SERVICE over L2CAP [len=%d].", buf->len);
+
+	if (!sid_ble_conn_rx(chan->conn)) {
+		LOG_DBG("Vendor SDU of an inactive connection dropped");
+		return 0;
+	}
+
+	k_mutex_lock(&rx_mutex, K_FOREVER);
+	err = sid_ble_rx_try_put(chan->conn, VENDOR_SERVICE, buf->data, buf->len, rx_space_cb);
+	if (err == -EAGAIN) {
+		vnd->rx_held = buf;
+	}
+	k_mutex_unlock(&rx_mutex);
+
+	if (err == -EAGAIN) {
+		LOG_DBG("Vendor SDU held, receive ring full");
+		return -EINPROGRESS;
+	}
+	if (err) {
+		LOG_WRN("Vendor SDU of %u bytes dropped", buf->len);
+	}
+
+	return 0;
+}
+
+static struct net_buf *vnd_chan_alloc_buf(struct bt_l2cap_chan *chan)
+{
+	ARG_UNUSED(chan);
+
+	return net_buf_alloc(&vnd_rx_pool, K_NO_WAIT);
+}
+
+static void vnd_chan_sent(struct bt_l2cap_chan *chan)
+{
+	struct vnd_chan *vnd = CONTAINER_OF(chan, struct vnd_chan, le.chan);
+
+	LOG_DBG("Vendor SDU sent.");
+	sid_ble_trace_tx_sent(chan->conn, SID_BLE_TRACE_L2CAP);
+
+	atomic_dec(&vnd->tx_inflight);
+	k_sem_give(&tx_credits);
+	if (atomic_cas(&ack_pending, 1, 0)) {
+		sid_ble_adapter_notification_sent();
+	}
+}
+
+static void vnd_chan_connected(struct bt_l2cap_chan *chan)
+{
+	struct vnd_chan *vnd = CONTAINER_OF(chan, struct vnd_chan, le.chan);
+
+	vnd->connected = true;
+	LOG_INF("Vendor L2CAP channel connected, tx mtu %u mps %u", vnd->le.tx.mtu,
+		vnd->le.tx.mps);
+}
+
+static void vnd_chan_disconnected(struct bt_l2cap_chan *chan)
+{
+	struct vnd_chan *vnd = CONTAINER_OF(chan, struct vnd_chan, le.chan);
+	struct net_buf *rx_held;
+
+	vnd->connected = false;
+	k_mutex_lock(&rx_mutex, K_FOREVER);
+	rx_held = vnd->rx_held;
+	vnd->rx_held = NULL;
+	k_mutex_unlock(&rx_mutex);
+	if (rx_held) {
+		net_buf_unref(rx_held);
+	}
+	/* The host drops SDUs which are not sent, their buffers are free again. */
+	for (atomic_val_t inflight = atomic_set(&vnd->tx_inflight, 0); inflight > 0; inflight--) {
+		sid_ble_trace_tx_cancel(chan->conn, SID_BLE_TRACE_L2CAP);
+		k_sem_give(&tx_credits);
+	}
+	if (atomic_cas(&ack_pending, 1, 0)) {
+		sid_ble_adapter_notification_sent();
+	}
+	LOG_INF("Vendor L2CAP channel disconnected");
+}
+
+static void vnd_chan_released(struct bt_l2cap_chan *chan)
+{
+	struct vnd_chan *vnd = CONTAINER_OF(chan, struct vnd_chan, le.chan);
+
+	vnd->in_use = false;
+}
+
+static int vnd_chan_accept(struct bt_conn *conn, struct bt_l2cap_chan **chan)
+{
+	struct vnd_chan *vnd = vnd_chan_get(conn);
+
+	if (!vnd || vnd->in_use) {
+		LOG_ERR("No vendor L2CAP channel available");
+		return -ENOMEM;
+	}
+
+	memset(vnd, 0, sizeof(*vnd));
+	vnd->le.chan.ops = &vnd_chan_ops;
+	vnd->le.rx.mtu = SDU_MTU;
+	vnd->in_use = true;
+	*chan = &vnd->le.chan;
+
+	return 0;
+}
+
+int sid_ble_vnd_l2cap_init(void)
+{
+	static struct bt_l2cap_server server = {
+		.psm = CONFIG_SIDEWALK_BLE_VND_L2CAP_PSM,
+		.sec_level = CONFIG_SIDEWALK_BLE_VND_L2CAP_SEC_LEVEL,
+		.accept = vnd_chan_accept,
+	};
+	static bool server_registered;
+	int err;
+
+	/* A server can not be unregistered, it stays registered after a deinit. */
+	if (server_registered) {
+		return 0;
+	}
+
+	err = bt_l2cap_server_register(&server);
+	if (err) {
+		LOG_ERR("L2CAP server register failed (err %d)", err);
+		return err;
+	}
+	server_registered = true;
+
+	return 0;
+}
+
+int sid_ble_vnd_l2cap_send(struct bt_conn *conn, const uint8_t *data, uint16_t length)
+{
+	struct vnd_chan *vnd = vnd_chan_get(conn);
+	struct net_buf *buf;
+	int err;
+
+	if (!vnd || !vnd->connected) {
+		return -ENOTCONN;
+	}
+
+	if (!data || !length) {
+		return -EINVAL;
+	}
+
+	if (length > SDU_MTU || length > vnd->le.tx.mtu) {
+		return -EMSGSIZE;
+	}
+
+	if (k_sem_take(&tx_credits, K_NO_WAIT)) {
+		LOG_ERR("No L2CAP TX buffers.");
+		return -EBUSY;
+	}
+
+	buf = net_buf_alloc(&vnd_tx_pool, K_NO_WAIT);
+	if (!buf) {
+		k_sem_give(&tx_credits);
+		LOG_ERR("No L2CAP TX buffers.");
+		return -EBUSY;
+	}
+
+	net_buf_reserve(buf, BT_L2CAP_SDU_CHAN_SEND_RESERVE);
+	net_buf_add_mem(buf, data, length);
+
+	atomic_inc(&vnd->tx_inflight);
+	sid_ble_trace_tx_submit(conn, SID_BLE_TRACE_L2CAP);
+	err = bt_l2cap_chan_send(&vnd->le.chan, buf);
+	if (err < 0) {
+		sid_ble_trace_tx_cancel(conn, SID_BLE_TRACE_L2CAP);
+		atomic_dec(&vnd->tx_inflight);
+		net_buf_unref(buf);
+		k_sem_give(&tx_credits);
+		LOG_ERR("Send err:%d.", err);
+		return err;
+	}
+
+	/* As for the notifications, the protocol sends the next SDU at once while TX buffers
+	 * are left, so the SDUs of several connection events are queued.
+	 */
+	atomic_set(&ack_pending, 1);
+	if (k_sem_count_get(&tx_credits) && atomic_cas(&ack_pending, 1, 0)) {
+		k_work_submit(&ack_work);
+	}
+
+	return 0;
+}
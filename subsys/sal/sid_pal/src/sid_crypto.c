@@ -9,6 +9,7 @@
  */
 
 #include <sid_pal_crypto_ifc.h>
+#include <sid_crypto_ext.h>
 
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
@@ -25,6 +26,9 @@ LOG_MODULE_REGISTER(sid_crypto, CONFIG_SIDEWALK_CRYPTO_LOG_LEVEL);
 /* AES key length in bytes. */
 #define AES_128_KEY_LENGTH (16)
 
+/* AES block length in bytes. */
+#define AES_BLOCK_LENGTH (16)
+
 /* EC key length in bits. */
 #define CURVE25519_KEY_LEN_BITS (255)
 #define SECP256R1_KEY_LEN_BITS (256)
@@ -63,17 +67,88 @@ LOG_MODULE_REGISTER(sid_crypto, CONFIG_SIDEWALK_CRYPTO_LOG_LEVEL);
 	((SID_PAL_CRYPTO_VERIFY == _mode) ? PSA_KEY_TYPE_ECC_PUBLIC_KEY(_type) :                   \
 					    PSA_KEY_TYPE_ECC_KEY_PAIR(_type))
 
+/* Max. AES-CTR payload encrypted with the single-shot PSA call. */
+#define AES_CTR_SINGLE_SHOT_MAX_LEN (CONFIG_SIDEWALK_CRYPTO_AES_SINGLE_SHOT_MAX_LEN)
+
+// CCM* (IEEE 802.15.4) MIC lengths, encryption-only level (no MIC) is not supported.
+#define CCM_STAR_MIC_SIZE_VALID(_size) ((4 == (_size)) || (8 == (_size)) || (16 == (_size)))
+
 /* Crypto initialization global flag. */
 static bool is_initialized = false;
 
+/* The cached keys are found by a digest, the key itself is only in the PSA key store. */
+#define KEY_DIGEST_ALG (PSA_ALG_SHA_256)
+#define KEY_DIGEST_LENGTH (PSA_HASH_LENGTH(KEY_DIGEST_ALG))
+
+/* Imported key which can be reused by the next operation with the same key. */
+struct key_cache_entry {
+	psa_key_handle_t handle;
+	psa_algorithm_t alg;
+	uint8_t digest[KEY_DIGEST_LENGTH];
+	/* Operations using the key, it is not destroyed while in use. */
+	uint32_t users;
+	bool is_valid;
+};
+
+/* Set of imported keys of one kind. */
+struct key_cache {
+	struct key_cache_entry *entries;
+	size_t size;
+	size_t next;
+	struct k_mutex *mutex;
+};
+
+#define KEY_CACHE_DEFINE(_name, _size)                                                             \
+	static struct key_cache_entry _name##_entries[MAX(1, _size)];                              \
+	static K_MUTEX_DEFINE(_name##_mutex);                                                      \
+	static struct key_cache _name = {                                                          \
+		.entries = _name##_entries,                                                        \
+		.size = (_size),                                                                   \
+		.mutex = &_name##_mutex,                                                           \
+	}
+
+/* AES-CTR, AES-CMAC and AEAD keys. */
+KEY_CACHE_DEFINE(aes_key_cache, CONFIG_SIDEWALK_CRYPTO_KEY_CACHE_SIZE);
+
+/* Public keys used for the signature verification. */
+KEY_CACHE_DEFINE(verify_key_cache, CONFIG_SIDEWALK_CRYPTO_VERIFY_KEY_CACHE_SIZE);
+
 /* Prefix for uncompressed public key */
 static const uint8_t secpxxx_key_prefix[SECPxxx_KEY_PREFIX_LEN] = { 0x04 };
 
+#if defined(CONFIG_SIDEWALK_CRYPTO_STATS)
+static struct sid_crypto_stats crypto_stats;
+static struct k_spinlock crypto_stats_lock;
+#endif /* CONFIG_SIDEWALK_CRYPTO_STATS */
+
+static const char *const crypto_stats_op_names[SID_CRYPTO_STATS_OP_COUNT] = {
+	[SID_CRYPTO_STATS_OP_HASH] = "hash",
+	[SID_CRYPTO_STATS_OP_HMAC] = "hmac",
+	[SID_CRYPTO_STATS_OP_AES_CTR] = "aes_ctr",
+	[SID_CRYPTO_STATS_OP_AES_CMAC] = "aes_cmac",
+	[SID_CRYPTO_STATS_OP_AEAD_GCM] = "gcm",
+	[SID_CRYPTO_STATS_OP_AEAD_CCM] = "ccm",
+	[SID_CRYPTO_STATS_OP_EDDSA] = "eddsa",
+	[SID_CRYPTO_STATS_OP_ECDSA] = "ecdsa",
+	[SID_CRYPTO_STATS_OP_ECDH] = "ecdh",
+	[SID_CRYPTO_STATS_OP_KEY_GEN] = "key_gen",
+};
+
 static sid_error_t get_error(psa_status_t psa_erc);
 static psa_status_t prepare_key(const uint8_t *key, size_t key_length, size_t key_bits,
 				psa_key_usage_t usage_flags, psa_algorithm_t alg,
 				psa_key_type_t type, psa_key_handle_t *key_handle);
+static psa_status_t key_acquire(struct key_cache *cache, const uint8_t *key, size_t key_size,
+				const uint8_t *prefix, size_t prefix_size, size_t key_bits,
+				psa_key_usage_t usage_flags, psa_algorithm_t alg,
+				psa_key_type_t type, psa_key_handle_t *key_handle,
+				struct key_cache_entry **cached);
+static void key_release(struct key_cache *cache, psa_key_handle_t key_handle,
+			struct key_cache_entry *cached);
+static void key_cache_flush(struct key_cache *cache);
+static bool buffers_overlap_partially(const uint8_t *in, const uint8_t *out, size_t size);
 static psa_status_t aes_execute(psa_cipher_operation_t *operation, sid_pal_aes_params_t *params);
+static psa_status_t aes_ctr_single_shot(psa_key_handle_t key_handle, sid_pal_aes_params_t *params);
 static psa_status_t aes_encrypt(psa_key_handle_t key_handle, sid_pal_aes_params_t *params);
 static psa_status_t aes_decrypt(psa_key_handle_t key_handle, sid_pal_aes_params_t *params);
 static psa_status_t aead_execute(psa_aead_operation_t *op, sid_pal_aead_params_t *params);
@@ -165,6 +240,252 @@ static psa_status_t prepare_key(const uint8_t *key, size_t key_length, size_t ke
 	return status;
 }
 
+/**
+ * @brief Clear a buffer which held key material, the compiler can not skip the stores.
+ *
+ * @param buf - buffer to clear.
+ * @param size - buffer size in bytes.
+ */
+static void key_wipe(void *buf, size_t size)
+{
+	volatile uint8_t *byte = buf;
+
+	while (size--) {
+		*byte++ = 0;
+	}
+}
+
+/**
+ * @brief Compare key digests in a time which does not depend on their content.
+ *
+ * @param a - first digest.
+ * @param b - second digest.
+ *
+ * @return true when the digests are equal.
+ */
+static bool key_digest_equal(const uint8_t *a, const uint8_t *b)
+{
+	uint8_t diff = 0;
+
+	for (size_t i = 0; i < KEY_DIGEST_LENGTH; i++) {
+		diff |= a[i] ^ b[i];
+	}
+
+	return !diff;
+}
+
+/**
+ * @brief Find a key in the cache.
+ * NOTE: Called with the cache mutex locked.
+ *
+ * @param cache - key cache.
+ * @param alg - key permitted-algorithm policy.
+ * @param digest - key digest.
+ *
+ * @return cache entry, NULL when the key is not cached.
+ */
+static struct key_cache_entry *key_cache_find(struct key_cache *cache, psa_algorithm_t alg,
+					      const uint8_t *digest)
+{
+	for (size_t i = 0; i < cache->size; i++) {
+		struct key_cache_entry *entry = &cache->entries[i];
+
+		if (entry->is_valid && entry->alg == alg && key_digest_equal(entry->digest, digest)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Take the oldest cache entry which is not in use and destroy its key.
+ * NOTE: Called with the cache mutex locked.
+ *
+ * @param cache - key cache.
+ *
+ * @return cleared cache entry, NULL when all keys are in use.
+ */
+static struct key_cache_entry *key_cache_evict(struct key_cache *cache)
+{
+	for (size_t i = 0; i < cache->size; i++) {
+		size_t index = (cache->next + i) % cache->size;
+		struct key_cache_entry *entry = &cache->entries[index];
+
+		if (entry->users) {
+			continue;
+		}
+
+		cache->next = (index + 1) % cache->size;
+		if (entry->is_valid && PSA_SUCCESS != psa_destroy_key(entry->handle)) {
+			LOG_WRN("Destroy key failed!");
+		}
+		key_wipe(entry, sizeof(*entry));
+
+		return entry;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Get the PSA handle of a key.
+ * The key is taken from the cache when it was imported before for the same algorithm,
+ * otherwise it is imported and stored in the cache. The cache is locked only to look up or
+ * insert the key, a cached key is not destroyed until key_release() is called.
+ *
+ * @param cache - key cache.
+ * @param key - binary key buffer.
+ * @param key_size - key length in bytes.
+ * @param prefix - bytes added in front of the key on import (can be NULL).
+ * @param prefix_size - prefix length in bytes.
+ * @param key_bits - key length in bits.
+ * @param usage_flags - define which opeartions are permitted with te key.
+ * @param alg - key permitted-algorithm policy.
+ * @param type - key type.
+ * @param key_handle - handle to key.
+ * @param cached - set to the cache entry owning the key handle, NULL when the key is not cached.
+ *
+ * @return PSA_SUCCESS when success, otherwise error code.
+ */
+static psa_status_t key_acquire(struct key_cache *cache, const uint8_t *key, size_t key_size,
+				const uint8_t *prefix, size_t prefix_size, size_t key_bits,
+				psa_key_usage_t usage_flags, psa_algorithm_t alg,
+				psa_key_type_t type, psa_key_handle_t *key_handle,
+				struct key_cache_entry **cached)
+{
+	uint8_t import_key[EC_MAX_KEY_LENGTH];
+	uint8_t digest[KEY_DIGEST_LENGTH] = { 0 };
+	struct key_cache_entry *entry;
+	size_t digest_len;
+	psa_status_t status;
+	bool use_cache;
+
+	*cached = NULL;
+	if (key_size > sizeof(import_key) - prefix_size) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	// A key which can not be hashed is imported for this operation only.
+	use_cache = cache->size && (PSA_SUCCESS == psa_hash_compute(KEY_DIGEST_ALG, key, key_size,
+								  digest, sizeof(digest),
+								  &digest_len));
+
+	if (use_cache) {
+		k_mutex_lock(cache->mutex, K_FOREVER);
+		entry = key_cache_find(cache, alg, digest);
+		if (entry) {
+			entry->users++;
+			*key_handle = entry->handle;
+			*cached = entry;
+		}
+		k_mutex_unlock(cache->mutex);
+
+		if (entry) {
+			LOG_DBG("Key cache hit.");
+			return PSA_SUCCESS;
+		}
+	}
+
+	if (prefix_size) {
+		memcpy(import_key, prefix, prefix_size);
+		memcpy(&import_key[prefix_size], key, key_size);
+		status = prepare_key(import_key, prefix_size + key_size, key_bits, usage_flags, alg,
+				     type, key_handle);
+		key_wipe(import_key, sizeof(import_key));
+	} else {
+		status = prepare_key(key, key_size, key_bits, usage_flags, alg, type, key_handle);
+	}
+
+	if (PSA_SUCCESS != status || !use_cache) {
+		return status;
+	}
+
+	k_mutex_lock(cache->mutex, K_FOREVER);
+	// Other thread could import the same key meanwhile, then this one is not cached.
+	entry = key_cache_find(cache, alg, digest) ? NULL : key_cache_evict(cache);
+	if (entry) {
+		entry->handle = *key_handle;
+		entry->alg = alg;
+		memcpy(entry->digest, digest, sizeof(entry->digest));
+		entry->users = 1;
+		entry->is_valid = true;
+		*cached = entry;
+	}
+	k_mutex_unlock(cache->mutex);
+
+	return status;
+}
+
+/**
+ * @brief Release the key taken by key_acquire().
+ *
+ * @param cache - key cache.
+ * @param key_handle - handle to key.
+ * @param cached - cache entry owning the key handle, NULL when the key is not cached.
+ */
+static void key_release(struct key_cache *cache, psa_key_handle_t key_handle,
+			struct key_cache_entry *cached)
+{
+	bool destroy = !cached;
+
+	if (cached) {
+		k_mutex_lock(cache->mutex, K_FOREVER);
+		// The key flushed while in use is destroyed by its last user.
+		destroy = !--cached->users && !cached->is_valid;
+		if (destroy) {
+			key_wipe(cached, sizeof(*cached));
+		}
+		k_mutex_unlock(cache->mutex);
+	}
+
+	if (destroy && PSA_SUCCESS != psa_destroy_key(key_handle)) {
+		LOG_WRN("Destroy key failed!");
+	}
+}
+
+/**
+ * @brief Destroy all keys stored in the cache.
+ *
+ * @param cache - key cache.
+ */
+static void key_cache_flush(struct key_cache *cache)
+{
+	k_mutex_lock(cache->mutex, K_FOREVER);
+	for (size_t i = 0; i < cache->size; i++) {
+		struct key_cache_entry *entry = &cache->entries[i];
+
+		if (entry->users) {
+			entry->is_valid = false;
+			continue;
+		}
+		if (entry->is_valid && PSA_SUCCESS != psa_destroy_key(entry->handle)) {
+			LOG_WRN("Destroy key failed!");
+		}
+		key_wipe(entry, sizeof(*entry));
+	}
+	cache->next = 0;
+	k_mutex_unlock(cache->mutex);
+}
+
+/**
+ * @brief Check if the input and output buffers overlap without being the same buffer.
+ *
+ * @param in - input buffer.
+ * @param out - output buffer.
+ * @param size - number of bytes to process.
+ *
+ * @return true when buffers overlap partially.
+ */
+static bool buffers_overlap_partially(const uint8_t *in, const uint8_t *out, size_t size)
+{
+	if (in == out) {
+		return false;
+	}
+
+	return (in < out) ? (in + size > out) : (out + size > in);
+}
+
 /**
  * @brief Perform the AES algorithm.
  * NOTE: The algorithm must be set before calling this function.
@@ -195,6 +516,31 @@ static psa_status_t aes_execute(psa_cipher_operation_t *operation, sid_pal_aes_p
 	return status;
 }
 
+/**
+ * @brief Encrypt or decrypt short data using the AES_CTR with one PSA call.
+ * NOTE: The single-shot PSA encryption generates its own IV, so the IV is placed in front of
+ * the data and the single-shot decryption is used. In the CTR mode it gives the same result
+ * for both directions. The data is copied next to the IV on the stack, so in-place operation
+ * uses the multi-part path instead.
+ *
+ * @param key_handle - key to use for the operation (usage policy must allow decryption).
+ * @param params - AES parameters.
+ *
+ * @return PSA_SUCCESS when success, otherwise error code.
+ */
+static psa_status_t aes_ctr_single_shot(psa_key_handle_t key_handle, sid_pal_aes_params_t *params)
+{
+	uint8_t block[AES_BLOCK_LENGTH + AES_CTR_SINGLE_SHOT_MAX_LEN];
+	size_t out_len;
+
+	memcpy(block, params->iv, params->iv_size);
+	memcpy(&block[params->iv_size], params->in, params->in_size);
+
+	return psa_cipher_decrypt(key_handle, PSA_ALG_CTR, block,
+				  params->iv_size + params->in_size, params->out, params->out_size,
+				  &out_len);
+}
+
 /**
  * @brief Encrypt a raw data using the AES_CTR.
  *
@@ -278,8 +624,12 @@ static psa_status_t aead_execute(psa_aead_operation_t *op, sid_pal_aead_params_t
 
 			if (PSA_SUCCESS == status) {
 				LOG_DBG("psa_aead_update_ad success.");
-				status = psa_aead_update(op, params->in, params->in_size,
-							 params->out, params->out_size, &out_len);
+				out_len = 0;
+				if (params->in_size) {
+					status = psa_aead_update(op, params->in, params->in_size,
+								 params->out, params->out_size,
+								 &out_len);
+				}
 
 				if (PSA_SUCCESS == status) {
 					LOG_DBG("psa_aead_update_ad success (out_len=%d).",
@@ -367,6 +717,9 @@ sid_error_t sid_pal_crypto_init(void)
 {
 	psa_status_t status = psa_crypto_init();
 
+	key_cache_flush(&aes_key_cache);
+	key_cache_flush(&verify_key_cache);
+
 	if (PSA_SUCCESS == status) {
 		is_initialized = true;
 		LOG_DBG("Init success!");
@@ -379,6 +732,8 @@ sid_error_t sid_pal_crypto_init(void)
 
 sid_error_t sid_pal_crypto_deinit(void)
 {
+	key_cache_flush(&aes_key_cache);
+	key_cache_flush(&verify_key_cache);
 	is_initialized = false;
 	return SID_ERROR_NONE;
 }
@@ -400,7 +755,7 @@ sid_error_t sid_pal_crypto_rand(uint8_t *rand, size_t size)
 	return get_error(psa_generate_random(rand, size));
 }
 
-sid_error_t sid_pal_crypto_hash(sid_pal_hash_params_t *params)
+static sid_error_t crypto_hash(sid_pal_hash_params_t *params)
 {
 	psa_algorithm_t alg_sha;
 	size_t hash_length;
@@ -432,7 +787,7 @@ sid_error_t sid_pal_crypto_hash(sid_pal_hash_params_t *params)
 					  params->digest_size, &hash_length));
 }
 
-sid_error_t sid_pal_crypto_hmac(sid_pal_hmac_params_t *params)
+static sid_error_t crypto_hmac(sid_pal_hmac_params_t *params)
 {
 	psa_status_t status;
 	psa_mac_operation_t operation = PSA_MAC_OPERATION_INIT;
@@ -506,12 +861,14 @@ sid_error_t sid_pal_crypto_hmac(sid_pal_hmac_params_t *params)
 	return get_error(status);
 }
 
-sid_error_t sid_pal_crypto_aes_crypt(sid_pal_aes_params_t *params)
+static sid_error_t crypto_aes_crypt(sid_pal_aes_params_t *params)
 {
 	psa_status_t status = PSA_ERROR_NOT_SUPPORTED;
 	psa_algorithm_t alg;
+	psa_key_usage_t usage_flags;
 	size_t key_len = BYTE_TO_BITS(AES_128_KEY_LENGTH);
 	psa_key_handle_t key_handle;
+	struct key_cache_entry *cached_key;
 
 	if (!is_initialized) {
 		return SID_ERROR_UNINITIALIZED;
@@ -530,10 +887,13 @@ sid_error_t sid_pal_crypto_aes_crypt(sid_pal_aes_params_t *params)
 	case SID_PAL_AES_CMAC_128:
 		alg = PSA_ALG_CMAC;
 		key_len = BYTE_TO_BITS(AES_128_KEY_LENGTH);
+		usage_flags = PSA_KEY_USAGE_SIGN_MESSAGE;
 		break;
 	case SID_PAL_AES_CTR_128:
 		alg = PSA_ALG_CTR;
 		key_len = BYTE_TO_BITS(AES_128_KEY_LENGTH);
+		// The same key is used for both directions and by the single-shot path.
+		usage_flags = PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT;
 		break;
 	default:
 		return SID_ERROR_NOSUPPORT;
@@ -547,59 +907,92 @@ sid_error_t sid_pal_crypto_aes_crypt(sid_pal_aes_params_t *params)
 		return SID_ERROR_INVALID_ARGS;
 	}
 
+	// In-place operation is supported, but partially overlapped buffers are not.
+	if (buffers_overlap_partially(params->in, params->out, params->in_size)) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+
+	if ((SID_PAL_CRYPTO_ENCRYPT != params->mode) && (SID_PAL_CRYPTO_DECRYPT != params->mode) &&
+	    (SID_PAL_CRYPTO_MAC_CALCULATE != params->mode)) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+
 	// NOTE: key_size is in bits.
-	status = prepare_key(params->key, BITS_TO_BYTE(params->key_size), params->key_size,
-			     AES_MODE_TO_USAGE(params->mode), alg, PSA_KEY_TYPE_AES, &key_handle);
+	status = key_acquire(&aes_key_cache, params->key, BITS_TO_BYTE(params->key_size), NULL, 0,
+			     params->key_size, usage_flags, alg, PSA_KEY_TYPE_AES, &key_handle,
+			     &cached_key);
 
 	if (PSA_SUCCESS == status) {
 		LOG_DBG("Key import success");
 
-		switch (params->mode) {
-		case SID_PAL_CRYPTO_ENCRYPT:
-			status = aes_encrypt(key_handle, params);
-			LOG_DBG("AES encrypt %s", (PSA_SUCCESS == status) ? "success." : "failed!");
-			break;
-		case SID_PAL_CRYPTO_DECRYPT:
-			status = aes_decrypt(key_handle, params);
-			LOG_DBG("AES decrypt %s", (PSA_SUCCESS == status) ? "success." : "failed!");
-			break;
-		case SID_PAL_CRYPTO_MAC_CALCULATE: {
-			size_t out_len;
-
-			status = psa_mac_compute(key_handle, alg, params->in, params->in_size,
-						 params->out, params->out_size, &out_len);
-			LOG_DBG("Mac calculate %s",
+		// In-place data is processed by the multi-part operation in the caller's buffer,
+		// the single-shot call would need a copy of it.
+		if ((SID_PAL_AES_CTR_128 == params->algo) &&
+		    (SID_PAL_CRYPTO_MAC_CALCULATE != params->mode) &&
+		    (params->in != params->out) &&
+		    (params->in_size <= AES_CTR_SINGLE_SHOT_MAX_LEN)) {
+			status = aes_ctr_single_shot(key_handle, params);
+			LOG_DBG("AES single-shot %s",
 				(PSA_SUCCESS == status) ? "success." : "failed!");
-		} break;
-		default:
-			return SID_ERROR_INVALID_ARGS;
+		} else {
+			switch (params->mode) {
+			case SID_PAL_CRYPTO_ENCRYPT:
+				status = aes_encrypt(key_handle, params);
+				LOG_DBG("AES encrypt %s",
+					(PSA_SUCCESS == status) ? "success." : "failed!");
+				break;
+			case SID_PAL_CRYPTO_DECRYPT:
+				status = aes_decrypt(key_handle, params);
+				LOG_DBG("AES decrypt %s",
+					(PSA_SUCCESS == status) ? "success." : "failed!");
+				break;
+			case SID_PAL_CRYPTO_MAC_CALCULATE: {
+				size_t out_len;
+
+				status = psa_mac_compute(key_handle, alg, params->in,
+							 params->in_size, params->out,
+							 params->out_size, &out_len);
+				LOG_DBG("Mac calculate %s",
+					(PSA_SUCCESS == status) ? "success." : "failed!");
+			} break;
+			default:
+				status = PSA_ERROR_INVALID_ARGUMENT;
+				break;
+			}
 		}
 
-		if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
-			LOG_WRN("Destroy key failed!");
-		}
+		key_release(&aes_key_cache, key_handle, cached_key);
 	}
 
 	return get_error(status);
 }
 
-sid_error_t sid_pal_crypto_aead_crypt(sid_pal_aead_params_t *params)
+static sid_error_t crypto_aead_crypt(sid_pal_aead_params_t *params)
 {
 	psa_status_t status = PSA_ERROR_NOT_SUPPORTED;
 	psa_algorithm_t alg;
 	psa_key_handle_t key_handle;
 	size_t key_len = BYTE_TO_BITS(AES_128_KEY_LENGTH);
+	struct key_cache_entry *cached_key = NULL;
+	bool mic_only;
 
 	if (!is_initialized) {
 		return SID_ERROR_UNINITIALIZED;
 	}
 
-	if (!params || !params->key || !params->in || !params->out || !params->aad ||
+	if (!params) {
+		return SID_ERROR_NULL_POINTER;
+	}
+
+	// CCM* authenticates header without payload (MIC-only security levels).
+	mic_only = (SID_PAL_AEAD_CCM_STAR_128 == params->algo) && !params->in_size;
+
+	if (!params->key || (!mic_only && (!params->in || !params->out)) || !params->aad ||
 	    !params->mac) {
 		return SID_ERROR_NULL_POINTER;
 	}
 
-	if (!params->in_size || !params->aad_size) {
+	if ((!params->in_size && !mic_only) || !params->aad_size) {
 		return SID_ERROR_INVALID_ARGS;
 	}
 
@@ -608,11 +1001,17 @@ sid_error_t sid_pal_crypto_aead_crypt(sid_pal_aead_params_t *params)
 		alg = PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_GCM, params->mac_size);
 		key_len = BYTE_TO_BITS(AES_128_KEY_LENGTH);
 		break;
+	case SID_PAL_AEAD_CCM_STAR_128:
+		if (!CCM_STAR_MIC_SIZE_VALID(params->mac_size)) {
+			return SID_ERROR_INVALID_ARGS;
+		}
+		alg = PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_CCM, params->mac_size);
+		key_len = BYTE_TO_BITS(AES_128_KEY_LENGTH);
+		break;
 	case SID_PAL_AEAD_CCM_128:
 		alg = PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_CCM, params->mac_size);
 		key_len = BYTE_TO_BITS(AES_128_KEY_LENGTH);
 		break;
-	case SID_PAL_AEAD_CCM_STAR_128:
 	default:
 		return SID_ERROR_NOSUPPORT;
 	}
@@ -626,46 +1025,42 @@ sid_error_t sid_pal_crypto_aead_crypt(sid_pal_aead_params_t *params)
 		return SID_ERROR_INVALID_ARGS;
 	}
 
+	if ((SID_PAL_CRYPTO_ENCRYPT != params->mode) && (SID_PAL_CRYPTO_DECRYPT != params->mode)) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+
 	// NOTE: key_size is in bits.
-	status = prepare_key(params->key, BITS_TO_BYTE(params->key_size), params->key_size,
-			     AES_MODE_TO_USAGE(params->mode), alg, PSA_KEY_TYPE_AES, &key_handle);
+	status = key_acquire(&aes_key_cache, params->key, BITS_TO_BYTE(params->key_size), NULL, 0,
+			     params->key_size, PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT, alg,
+			     PSA_KEY_TYPE_AES, &key_handle, &cached_key);
 
 	if (PSA_SUCCESS == status) {
 		LOG_DBG("Key import success.");
 
-		switch (params->mode) {
-		case SID_PAL_CRYPTO_ENCRYPT:
+		if (SID_PAL_CRYPTO_ENCRYPT == params->mode) {
 			status = aead_encrypt(key_handle, params, alg);
-			LOG_DBG("AEAD encrypt %s",
-				(PSA_SUCCESS == status) ? "success." : "failed!");
-			break;
-		case SID_PAL_CRYPTO_DECRYPT:
+			LOG_DBG("AEAD encrypt %s", (PSA_SUCCESS == status) ? "success." : "failed!");
+		} else {
 			status = aead_decrypt(key_handle, params, alg);
-			LOG_DBG("AEAD decrypt %s",
-				(PSA_SUCCESS == status) ? "success." : "failed!");
-			break;
-		default:
-			return SID_ERROR_INVALID_ARGS;
+			LOG_DBG("AEAD decrypt %s", (PSA_SUCCESS == status) ? "success." : "failed!");
 		}
 
-		if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
-			LOG_WRN("Destroy key failed!");
-		}
+		key_release(&aes_key_cache, key_handle, cached_key);
 	}
 
 	return get_error(status);
 }
 
-sid_error_t sid_pal_crypto_ecc_dsa(sid_pal_dsa_params_t *params)
+static sid_error_t crypto_ecc_dsa(sid_pal_dsa_params_t *params)
 {
 	psa_status_t status;
 	psa_key_handle_t key_handle;
 	psa_algorithm_t alg;
 	psa_ecc_family_t type;
 	size_t key_len;
-	uint8_t key[EC_MAX_KEY_LENGTH];
-	uint8_t key_offset = 0;
-	size_t key_size = 0;
+	const uint8_t *key_prefix = NULL;
+	size_t key_prefix_size = 0;
+	struct key_cache_entry *cached_key;
 
 	if (!is_initialized) {
 		return SID_ERROR_UNINITIALIZED;
@@ -679,8 +1074,6 @@ sid_error_t sid_pal_crypto_ecc_dsa(sid_pal_dsa_params_t *params)
 		return SID_ERROR_INVALID_ARGS;
 	}
 
-	key_size = params->key_size;
-
 	switch (params->algo) {
 	case SID_PAL_EDDSA_ED25519:
 		alg = PSA_ALG_PURE_EDDSA;
@@ -696,51 +1089,87 @@ sid_error_t sid_pal_crypto_ecc_dsa(sid_pal_dsa_params_t *params)
 		// but PSA API required 65-byte public key length...
 		if (SID_PAL_CRYPTO_VERIFY == params->mode) {
 			// ... so, add prefix to SECPxxx public key.
-			memcpy(&key[SECPxxx_PREFIX_OFFSET], secpxxx_key_prefix,
-			       MIN(sizeof(key), SECPxxx_KEY_PREFIX_LEN));
-			key_size += SECPxxx_KEY_PREFIX_LEN;
-			key_offset = SECPxxx_KEY_OFFSET;
+			key_prefix = secpxxx_key_prefix;
+			key_prefix_size = SECPxxx_KEY_PREFIX_LEN;
 		}
 		break;
 	default:
 		return SID_ERROR_NOSUPPORT;
 	}
 
-	key_size = MIN(sizeof(key), key_size);
-	memcpy(&key[key_offset], params->key, key_size - key_offset);
-
-	// NOTE: key_size is in bytes.
-	status = prepare_key(key, key_size, key_len, ECDSA_MODE_TO_USAGE(params->mode), alg,
-			     ECC_FAMILY_TYPE(params->mode, type), &key_handle);
+	switch (params->mode) {
+	case SID_PAL_CRYPTO_VERIFY:
+		// Public keys are verified many times (certificate chain), so they are cached.
+		status = key_acquire(&verify_key_cache, params->key, params->key_size, key_prefix,
+				     key_prefix_size, key_len, ECDSA_MODE_TO_USAGE(params->mode),
+				     alg, ECC_FAMILY_TYPE(params->mode, type), &key_handle,
+				     &cached_key);
 
-	if (PSA_SUCCESS == status) {
-		LOG_DBG("Key import success.");
-
-		switch (params->mode) {
-		case SID_PAL_CRYPTO_VERIFY:
+		if (PSA_SUCCESS == status) {
+			LOG_DBG("Key import success.");
 			status = psa_verify_message(key_handle, alg, params->in, params->in_size,
 						    params->signature, params->sig_size);
+			key_release(&verify_key_cache, key_handle, cached_key);
+		}
+		break;
+	case SID_PAL_CRYPTO_SIGN:
+		// NOTE: key_size is in bytes.
+		status = prepare_key(params->key, MIN(params->key_size, EC_MAX_KEY_LENGTH), key_len,
+				     ECDSA_MODE_TO_USAGE(params->mode), alg,
+				     ECC_FAMILY_TYPE(params->mode, type), &key_handle);
 
-			break;
-		case SID_PAL_CRYPTO_SIGN: {
+		if (PSA_SUCCESS == status) {
 			size_t out_len;
 
+			LOG_DBG("Key import success.");
 			status = psa_sign_message(key_handle, alg, params->in, params->in_size,
 						  params->signature, params->sig_size, &out_len);
-		} break;
-		default:
-			return SID_ERROR_INVALID_ARGS;
-		}
 
-		if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
-			LOG_WRN("Destroy key failed!");
+			if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
+				LOG_WRN("Destroy key failed!");
+			}
 		}
+		break;
+	default:
+		return SID_ERROR_INVALID_ARGS;
 	}
 
 	return get_error(status);
 }
 
-sid_error_t sid_pal_crypto_ecc_ecdh(sid_pal_ecdh_params_t *params)
+sid_error_t sid_pal_crypto_ecc_dsa_verify_chain(sid_pal_dsa_params_t *params, size_t count,
+						size_t *failed_index)
+{
+	sid_error_t erc = SID_ERROR_NONE;
+
+	if (!is_initialized) {
+		return SID_ERROR_UNINITIALIZED;
+	}
+
+	if (!params) {
+		return SID_ERROR_NULL_POINTER;
+	}
+
+	if (!count) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		erc = (SID_PAL_CRYPTO_VERIFY == params[i].mode) ? sid_pal_crypto_ecc_dsa(&params[i]) :
+								   SID_ERROR_INVALID_ARGS;
+		if (SID_ERROR_NONE != erc) {
+			LOG_DBG("Signature %d verification failed (erc: %d)", i, erc);
+			if (failed_index) {
+				*failed_index = i;
+			}
+			break;
+		}
+	}
+
+	return erc;
+}
+
+static sid_error_t crypto_ecc_ecdh(sid_pal_ecdh_params_t *params)
 {
 	psa_status_t status;
 	psa_key_handle_t priv_key_handle;
@@ -804,7 +1233,7 @@ sid_error_t sid_pal_crypto_ecc_ecdh(sid_pal_ecdh_params_t *params)
 	return get_error(status);
 }
 
-sid_error_t sid_pal_crypto_ecc_key_gen(sid_pal_ecc_key_gen_params_t *params)
+static sid_error_t crypto_ecc_key_gen(sid_pal_ecc_key_gen_params_t *params)
 {
 	psa_key_attributes_t key_attributes = PSA_KEY_ATTRIBUTES_INIT;
 	psa_algorithm_t alg;
@@ -884,3 +1313,152 @@ sid_error_t sid_pal_crypto_ecc_key_gen(sid_pal_ecc_key_gen_params_t *params)
 
 	return get_error(status);
 }
+
+/**
+ * @brief Start time measurement of the crypto operation.
+ *
+ * @return start timestamp in cycles.
+ */
+static inline uint32_t stats_start(void)
+{
+#if defined(CONFIG_SIDEWALK_CRYPTO_STATS)
+	return k_cycle_get_32();
+#else
+	return 0;
+#endif /* CONFIG_SIDEWALK_CRYPTO_STATS */
+}
+
+/**
+ * @brief Account finished crypto operation.
+ *
+ * @param op - operation.
+ * @param bytes - number of bytes processed by the operation.
+ * @param erc - result of the operation.
+ * @param start - timestamp returned by stats_start.
+ */
+static inline void stats_record(enum sid_crypto_stats_op op, size_t bytes, sid_error_t erc,
+				uint32_t start)
+{
+#if defined(CONFIG_SIDEWALK_CRYPTO_STATS)
+	uint32_t time_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	uint32_t bucket = time_us ? (31 - __builtin_clz(time_us)) : 0;
+	struct sid_crypto_op_stats *entry = &crypto_stats.op[op];
+	k_spinlock_key_t key = k_spin_lock(&crypto_stats_lock);
+
+	entry->calls++;
+	entry->errors += (SID_ERROR_NONE != erc) ? 1 : 0;
+	entry->bytes += bytes;
+	entry->time_total_us += time_us;
+	entry->time_max_us = MAX(entry->time_max_us, time_us);
+	entry->hist[MIN(bucket, SID_CRYPTO_STATS_HIST_BUCKETS - 1)]++;
+
+	k_spin_unlock(&crypto_stats_lock, key);
+#endif /* CONFIG_SIDEWALK_CRYPTO_STATS */
+}
+
+sid_error_t sid_pal_crypto_hash(sid_pal_hash_params_t *params)
+{
+	uint32_t start = stats_start();
+	sid_error_t erc = crypto_hash(params);
+
+	stats_record(SID_CRYPTO_STATS_OP_HASH, params ? params->data_size : 0, erc, start);
+	return erc;
+}
+
+sid_error_t sid_pal_crypto_hmac(sid_pal_hmac_params_t *params)
+{
+	uint32_t start = stats_start();
+	sid_error_t erc = crypto_hmac(params);
+
+	stats_record(SID_CRYPTO_STATS_OP_HMAC, params ? params->data_size : 0, erc, start);
+	return erc;
+}
+
+sid_error_t sid_pal_crypto_aes_crypt(sid_pal_aes_params_t *params)
+{
+	uint32_t start = stats_start();
+	sid_error_t erc = crypto_aes_crypt(params);
+
+	stats_record((params && SID_PAL_AES_CMAC_128 == params->algo) ?
+			     SID_CRYPTO_STATS_OP_AES_CMAC :
+			     SID_CRYPTO_STATS_OP_AES_CTR,
+		     params ? params->in_size : 0, erc, start);
+	return erc;
+}
+
+sid_error_t sid_pal_crypto_aead_crypt(sid_pal_aead_params_t *params)
+{
+	uint32_t start = stats_start();
+	sid_error_t erc = crypto_aead_crypt(params);
+
+	stats_record((params && SID_PAL_AEAD_GCM_128 == params->algo) ?
+			     SID_CRYPTO_STATS_OP_AEAD_GCM :
+			     SID_CRYPTO_STATS_OP_AEAD_CCM,
+		     params ? params->in_size + params->aad_size : 0, erc, start);
+	return erc;
+}
+
+sid_error_t sid_pal_crypto_ecc_dsa(sid_pal_dsa_params_t *params)
+{
+	uint32_t start = stats_start();
+	sid_error_t erc = crypto_ecc_dsa(params);
+
+	stats_record((params && SID_PAL_EDDSA_ED25519 == params->algo) ?
+			     SID_CRYPTO_STATS_OP_EDDSA :
+			     SID_CRYPTO_STATS_OP_ECDSA,
+		     params ? params->in_size : 0, erc, start);
+	return erc;
+}
+
+sid_error_t sid_pal_crypto_ecc_ecdh(sid_pal_ecdh_params_t *params)
+{
+	uint32_t start = stats_start();
+	sid_error_t erc = crypto_ecc_ecdh(params);
+
+	stats_record(SID_CRYPTO_STATS_OP_ECDH, 0, erc, start);
+	return erc;
+}
+
+sid_error_t sid_pal_crypto_ecc_key_gen(sid_pal_ecc_key_gen_params_t *params)
+{
+	uint32_t start = stats_start();
+	sid_error_t erc = crypto_ecc_key_gen(params);
+
+	stats_record(SID_CRYPTO_STATS_OP_KEY_GEN, 0, erc, start);
+	return erc;
+}
+
+sid_error_t sid_crypto_stats_snapshot(struct sid_crypto_stats *stats)
+{
+#if defined(CONFIG_SIDEWALK_CRYPTO_STATS)
+	if (!stats) {
+		return SID_ERROR_NULL_POINTER;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&crypto_stats_lock);
+	*stats = crypto_stats;
+	k_spin_unlock(&crypto_stats_lock, key);
+
+	return SID_ERROR_NONE;
+#else
+	return SID_ERROR_NOSUPPORT;
+#endif /* CONFIG_SIDEWALK_CRYPTO_STATS */
+}
+
+void sid_crypto_stats_reset(void)
+{
+#if defined(CONFIG_SIDEWALK_CRYPTO_STATS)
+	k_spinlock_key_t key = k_spin_lock(&crypto_stats_lock);
+	memset(&crypto_stats, 0, sizeof(crypto_stats));
+	k_spin_unlock(&crypto_stats_lock, key);
+#endif /* CONFIG_SIDEWALK_CRYPTO_STATS */
+}
+
+const char *sid_crypto_stats_op_name(enum sid_crypto_stats_op op)
+{
+	if (op >= SID_CRYPTO_STATS_OP_COUNT) {
+		return "unknown";
+	}
+
+	return crypto_stats_op_names[op];
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <sid_crypto_ext.h>
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+static void print_histogram(const struct shell *shell, const struct sid_crypto_op_stats *stats)
+{
+	for (int i = 0; i < SID_CRYPTO_STATS_HIST_BUCKETS; i++) {
+		if (!stats->hist[i]) {
+			continue;
+		}
+		if (i == SID_CRYPTO_STATS_HIST_BUCKETS - 1) {
+			shell_print(shell, "    >= %8u us: %u", 1U << i, stats->hist[i]);
+		} else {
+			shell_print(shell, "    < %9u us: %u", 1U << (i + 1), stats->hist[i]);
+		}
+	}
+}
+
+static int cmd_crypto_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	static struct sid_crypto_stats stats;
+	bool verbose = (argc > 1 && !strcmp(argv[1], "-v"));
+
+	if (argc > 1 && !verbose) {
+		shell_error(shell, "Unknown option %s", argv[1]);
+		return -EINVAL;
+	}
+
+	if (SID_ERROR_NONE != sid_crypto_stats_snapshot(&stats)) {
+		shell_error(shell, "Crypto stats not available");
+		return -ENOEXEC;
+	}
+
+	shell_print(shell, "%-10s %10s %8s %12s %10s %10s", "op", "calls", "errors", "bytes",
+		    "avg [us]", "max [us]");
+	for (int op = 0; op < SID_CRYPTO_STATS_OP_COUNT; op++) {
+		const struct sid_crypto_op_stats *entry = &stats.op[op];
+
+		if (!entry->calls) {
+			continue;
+		}
+		shell_print(shell, "%-10s %10u %8u %12llu %10llu %10u", sid_crypto_stats_op_name(op),
+			    entry->calls, entry->errors, (unsigned long long)entry->bytes,
+			    (unsigned long long)(entry->time_total_us / entry->calls),
+			    entry->time_max_us);
+		if (verbose) {
+			print_histogram(shell, entry);
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_crypto_stats_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	sid_crypto_stats_reset();
+	shell_print(shell, "Crypto stats cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_sid_crypto,
+	SHELL_CMD_ARG(stats, NULL, "[-v] print crypto counters, -v adds latency histogram",
+		      cmd_crypto_stats, 1, 1),
+	SHELL_CMD_ARG(reset, NULL, "clear crypto counters", cmd_crypto_stats_reset, 1, 0),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(sid_crypto, &sub_sid_crypto, "Sidewalk crypto PAL", NULL);
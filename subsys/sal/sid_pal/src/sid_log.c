@@ -9,18 +9,85 @@
  */
 
 #include <sid_pal_log_ifc.h>
+#include <sid_log_ext.h>
 #include <stddef.h>
 
 #include <zephyr/sys/printk.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend.h>
 
-LOG_MODULE_REGISTER(sidewalk, CONFIG_SIDEWALK_LOG_LEVEL);
+#if defined(CONFIG_SIDEWALK_LOG_RING)
+#include <sid_log_ring.h>
+#endif /* CONFIG_SIDEWALK_LOG_RING */
 
-#define LOG_FLUSH_SLEEP_PERIOD K_MSEC(5)
+LOG_MODULE_REGISTER(sidewalk, CONFIG_SIDEWALK_LOG_LEVEL);
 
 #define MSG_LENGTH_MAX (CONFIG_SIDEWALK_LOG_MSG_LENGTH_MAX)
 
+static const uint8_t severity_to_level[] = {
+	[SID_PAL_LOG_SEVERITY_ERROR] = LOG_LEVEL_ERR,
+	[SID_PAL_LOG_SEVERITY_WARNING] = LOG_LEVEL_WRN,
+	[SID_PAL_LOG_SEVERITY_INFO] = LOG_LEVEL_INF,
+	[SID_PAL_LOG_SEVERITY_DEBUG] = LOG_LEVEL_DBG,
+};
+
+static inline uint8_t level_get(sid_pal_log_severity_t severity)
+{
+	return (severity < ARRAY_SIZE(severity_to_level)) ? severity_to_level[severity] :
+							     LOG_LEVEL_DBG;
+}
+
+/* Compiled and runtime level of the module, checked before any formatting or packaging. */
+static inline bool level_enabled(uint8_t level)
+{
+	if (level > CONFIG_SIDEWALK_LOG_LEVEL) {
+		return false;
+	}
+
+#if defined(CONFIG_LOG_RUNTIME_FILTERING)
+	if (!k_is_user_context() &&
+	    level > log_filter_get(NULL, Z_LOG_LOCAL_DOMAIN_ID, LOG_CURRENT_MODULE_ID(), true)) {
+		return false;
+	}
+#endif /* CONFIG_LOG_RUNTIME_FILTERING */
+
+	return true;
+}
+
+#if defined(CONFIG_SIDEWALK_LOG_DEFERRED)
+void sid_pal_log(sid_pal_log_severity_t severity, uint32_t num_args, const char *fmt, ...)
+{
+	ARG_UNUSED(num_args);
+
+	va_list args;
+	uint8_t level = level_get(severity);
+
+	/* The ring keeps messages the log filter drops. */
+#if defined(CONFIG_SIDEWALK_LOG_RING)
+	va_start(args, fmt);
+	sid_log_ring_put(severity, fmt, args);
+	va_end(args);
+#endif /* CONFIG_SIDEWALK_LOG_RING */
+
+	if (!level_enabled(level)) {
+		return;
+	}
+
+	/* Format string pointer and arguments are packaged into the log message,
+	 * formatting is done by the log processing thread (or on the host with dictionary logging).
+	 * Argument types are taken from the format string, strings in RAM are copied.
+	 * The message has no source, it is already filtered above.
+	 */
+	va_start(args, fmt);
+	log_generic(level, fmt, args);
+	va_end(args);
+
+	if (severity >= ARRAY_SIZE(severity_to_level)) {
+		LOG_WRN("sid pal log unknow severity %d", severity);
+	}
+}
+#else
 void sid_pal_log(sid_pal_log_severity_t severity, uint32_t num_args, const char *fmt, ...)
 {
 	ARG_UNUSED(num_args);
@@ -29,6 +96,17 @@ void sid_pal_log(sid_pal_log_severity_t severity, uint32_t num_args, const char
 	int print_len = 0;
 	char msg_buff[MSG_LENGTH_MAX] = "";
 
+	/* The ring keeps messages the log filter drops. */
+#if defined(CONFIG_SIDEWALK_LOG_RING)
+	va_start(args, fmt);
+	sid_log_ring_put(severity, fmt, args);
+	va_end(args);
+#endif /* CONFIG_SIDEWALK_LOG_RING */
+
+	if (!level_enabled(level_get(severity))) {
+		return;
+	}
+
 	va_start(args, fmt);
 	print_len = vsnprintk(msg_buff, sizeof(msg_buff), fmt, args);
 	va_end(args);
@@ -58,15 +136,97 @@ void sid_pal_log(sid_pal_log_severity_t severity, uint32_t num_args, const char
 		LOG_WRN("sid pal log dropped %d bytes", (print_len - MSG_LENGTH_MAX));
 	}
 }
+#endif /* CONFIG_SIDEWALK_LOG_DEFERRED */
 
-void sid_pal_log_flush(void)
+#if defined(CONFIG_LOG_MODE_DEFERRED)
+static K_SEM_DEFINE(flush_sem, 0, 1);
+static atomic_t flush_waiters;
+
+/* Backends are processed in the order of their names, so messages are already
+ * passed to the console backends when this one sees the buffer empty.
+ */
+static void flush_backend_process(const struct log_backend *const backend,
+				  union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(msg);
+
+	if (atomic_get(&flush_waiters) && !log_buffered_cnt()) {
+		k_sem_give(&flush_sem);
+	}
+}
+
+static void flush_backend_panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+static const struct log_backend_api flush_backend_api = {
+	.process = flush_backend_process,
+	.panic = flush_backend_panic,
+};
+
+LOG_BACKEND_DEFINE(sid_log_flush_notify, flush_backend_api, true);
+
+int sid_log_flush_wait(int32_t timeout_ms)
 {
-#ifndef CONFIG_LOG_MODE_MINIMAL
-	/* Note: log_buffered_cnt is not supported in minimal log mode. */
+	int64_t deadline;
+	int err = 0;
+
+	if (!log_buffered_cnt()) {
+		return 0;
+	}
+
+	if (!IS_ENABLED(CONFIG_LOG_PROCESS_THREAD)) {
+		while (log_process()) {
+		}
+		return 0;
+	}
+
+	if (k_is_in_isr()) {
+		return -EWOULDBLOCK;
+	}
+
+	deadline = k_uptime_get() + timeout_ms;
+	atomic_inc(&flush_waiters);
+	k_sem_reset(&flush_sem);
+	log_thread_trigger();
+
 	while (log_buffered_cnt()) {
-		k_sleep(LOG_FLUSH_SLEEP_PERIOD);
+		int64_t remaining = deadline - k_uptime_get();
+
+		if (remaining <= 0 || k_sem_take(&flush_sem, K_MSEC(remaining))) {
+			err = -EAGAIN;
+			break;
+		}
 	}
-#endif
+
+	/* Wake up the next waiter, only one is woken up by the backend. */
+	if (atomic_dec(&flush_waiters) > 1) {
+		k_sem_give(&flush_sem);
+	}
+
+	return err;
+}
+#else
+int sid_log_flush_wait(int32_t timeout_ms)
+{
+	ARG_UNUSED(timeout_ms);
+
+	/* Messages are not buffered in immediate and minimal modes. */
+	return 0;
+}
+#endif /* CONFIG_LOG_MODE_DEFERRED */
+
+void sid_log_panic_flush(void)
+{
+	/* Pending messages are processed synchronously, backends switch to blocking mode. */
+	log_panic();
+}
+
+void sid_pal_log_flush(void)
+{
+	(void)sid_log_flush_wait(CONFIG_SIDEWALK_LOG_FLUSH_TIMEOUT_MS);
 }
 
 char const *sid_pal_log_push_str(char *string)
@@ -74,6 +234,27 @@ char const *sid_pal_log_push_str(char *string)
 	return string;
 }
 
+#if defined(CONFIG_SIDEWALK_LOG_RING)
+static bool log_buffer_fill(const struct sid_log_record *record, void *ctx)
+{
+	struct sid_pal_log_buffer *log_buffer = ctx;
+
+	log_buffer->size = (uint8_t)sid_log_ring_format(record, (char *)log_buffer->buf,
+							  log_buffer->size);
+	log_buffer->idx = (uint8_t)record->seq;
+
+	return true;
+}
+
+bool sid_pal_log_get_log_buffer(struct sid_pal_log_buffer *const log_buffer)
+{
+	if (!log_buffer || !log_buffer->buf || !log_buffer->size) {
+		return false;
+	}
+
+	return sid_log_ring_drain(log_buffer_fill, log_buffer, 1) == 1;
+}
+#else
 bool sid_pal_log_get_log_buffer(struct sid_pal_log_buffer *const log_buffer)
 {
 	ARG_UNUSED(log_buffer);
@@ -81,8 +262,11 @@ bool sid_pal_log_get_log_buffer(struct sid_pal_log_buffer *const log_buffer)
 
 	return false;
 }
+#endif /* CONFIG_SIDEWALK_LOG_RING */
 
+#if !defined(CONFIG_SIDEWALK_LOG_CONTROL)
 sid_pal_log_severity_t sid_log_control_get_current_log_level(void)
 {
 	return (sid_pal_log_severity_t)SID_PAL_LOG_LEVEL;
 }
+#endif /* CONFIG_SIDEWALK_LOG_CONTROL */
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_log_control.c
+ *  @brief Runtime log level control.
+ */
+
+#include <sid_log_control.h>
+#include <sid_pal_storage_kv_ifc.h>
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(sid_log_control, CONFIG_SIDEWALK_LOG_LEVEL);
+
+#define LOG_CONTROL_KV_GROUP (0)
+#define LOG_CONTROL_KV_KEY (CONFIG_SIDEWALK_LOG_CONTROL_KV_KEY)
+
+struct level_entry {
+	char module[SID_LOG_CONTROL_MODULE_NAME_MAX + 1];
+	uint8_t level;
+};
+
+static void store_work_handler(struct k_work *work);
+
+static atomic_t protocol_level = ATOMIC_INIT(SID_PAL_LOG_LEVEL);
+static struct level_entry stored[CONFIG_SIDEWALK_LOG_CONTROL_MODULES_MAX];
+/* Set when stored has changes which are not written to the KV storage yet. */
+static bool store_pending;
+static K_MUTEX_DEFINE(control_lock);
+static K_WORK_DEFINE(store_work, store_work_handler);
+
+sid_pal_log_severity_t sid_log_control_get_current_log_level(void)
+{
+	/* Called by SID_PAL_LOG before the arguments are evaluated, keep it to a single load. */
+	return (sid_pal_log_severity_t)atomic_get(&protocol_level);
+}
+
+static bool is_protocol(const char *module)
+{
+	return !strcmp(module, SID_LOG_CONTROL_PROTOCOL_MODULE);
+}
+
+static sid_error_t apply_level(const char *module, sid_pal_log_severity_t level)
+{
+	bool protocol = is_protocol(module);
+
+	if (protocol) {
+		atomic_set(&protocol_level, (atomic_val_t)level);
+	}
+
+#if defined(CONFIG_LOG_RUNTIME_FILTERING)
+	int source_id = log_source_id_get(module);
+
+	if (source_id >= 0) {
+		/* Zephyr log levels are Sidewalk severities increased by one. */
+		(void)log_filter_set(NULL, Z_LOG_LOCAL_DOMAIN_ID, source_id, level + 1);
+		return SID_ERROR_NONE;
+	}
+
+	return protocol ? SID_ERROR_NONE : SID_ERROR_NOT_FOUND;
+#else
+	return protocol ? SID_ERROR_NONE : SID_ERROR_NOSUPPORT;
+#endif /* CONFIG_LOG_RUNTIME_FILTERING */
+}
+
+static void restore_level(const char *module)
+{
+	if (is_protocol(module)) {
+		atomic_set(&protocol_level, (atomic_val_t)SID_PAL_LOG_LEVEL);
+	}
+
+#if defined(CONFIG_LOG_RUNTIME_FILTERING)
+	int source_id = log_source_id_get(module);
+
+	if (source_id >= 0) {
+		(void)log_filter_set(
+			NULL, Z_LOG_LOCAL_DOMAIN_ID, source_id,
+			log_filter_get(NULL, Z_LOG_LOCAL_DOMAIN_ID, source_id, false));
+	}
+#endif /* CONFIG_LOG_RUNTIME_FILTERING */
+}
+
+static struct level_entry *stored_entry_get(const char *module)
+{
+	struct level_entry *free_entry = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(stored); i++) {
+		if (!stored[i].module[0]) {
+			if (!free_entry) {
+				free_entry = &stored[i];
+			}
+			continue;
+		}
+		if (!strcmp(stored[i].module, module)) {
+			return &stored[i];
+		}
+	}
+
+	return free_entry;
+}
+
+static bool module_name_valid(const char *module)
+{
+	size_t len = strnlen(module, SID_LOG_CONTROL_MODULE_NAME_MAX + 1);
+
+	return len > 0 && len <= SID_LOG_CONTROL_MODULE_NAME_MAX;
+}
+
+sid_error_t sid_log_control_init(void)
+{
+	sid_error_t erc;
+	uint32_t len = 0;
+
+	k_mutex_lock(&control_lock, K_FOREVER);
+	memset(stored, 0, sizeof(stored));
+
+	erc = sid_pal_storage_kv_record_get_len(LOG_CONTROL_KV_GROUP, LOG_CONTROL_KV_KEY, &len);
+	if (SID_ERROR_NOT_FOUND == erc) {
+		k_mutex_unlock(&control_lock);
+		return SID_ERROR_NONE;
+	}
+
+	if (SID_ERROR_NONE == erc) {
+		len = MIN(len, sizeof(stored));
+		erc = sid_pal_storage_kv_record_get(LOG_CONTROL_KV_GROUP, LOG_CONTROL_KV_KEY, stored,
+						    len - (len % sizeof(stored[0])));
+	}
+
+	if (SID_ERROR_NONE != erc) {
+		LOG_ERR("Failed to read stored log levels, err %d", erc);
+		memset(stored, 0, sizeof(stored));
+		k_mutex_unlock(&control_lock);
+		return erc;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(stored); i++) {
+		stored[i].module[SID_LOG_CONTROL_MODULE_NAME_MAX] = '\0';
+		if (!stored[i].module[0]) {
+			continue;
+		}
+		if (stored[i].level > SID_PAL_LOG_SEVERITY_DEBUG ||
+		    SID_ERROR_NONE != apply_level(stored[i].module, stored[i].level)) {
+			LOG_WRN("Stored log level of %s ignored", stored[i].module);
+			continue;
+		}
+		LOG_DBG("Log level of %s set to %d", stored[i].module, stored[i].level);
+	}
+	k_mutex_unlock(&control_lock);
+
+	return SID_ERROR_NONE;
+}
+
+static void store_work_handler(struct k_work *work)
+{
+	sid_error_t erc;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&control_lock, K_FOREVER);
+	if (store_pending) {
+		store_pending = false;
+		erc = sid_pal_storage_kv_record_set(LOG_CONTROL_KV_GROUP, LOG_CONTROL_KV_KEY,
+						    stored, sizeof(stored));
+		if (SID_ERROR_NONE != erc) {
+			LOG_ERR("Failed to store log levels, err %d", erc);
+		}
+	}
+	k_mutex_unlock(&control_lock);
+}
+
+static sid_error_t set_level(const char *module, sid_pal_log_severity_t level, bool persist,
+			     bool defer)
+{
+	struct level_entry *entry = NULL;
+	struct level_entry previous;
+	sid_error_t erc;
+
+	if (!module) {
+		return SID_ERROR_NULL_POINTER;
+	}
+
+	if (!module_name_valid(module) || level > SID_PAL_LOG_SEVERITY_DEBUG) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+
+	k_mutex_lock(&control_lock, K_FOREVER);
+	if (persist) {
+		entry = stored_entry_get(module);
+		if (!entry) {
+			k_mutex_unlock(&control_lock);
+			return SID_ERROR_OUT_OF_RESOURCES;
+		}
+	}
+
+	erc = apply_level(module, level);
+	if (SID_ERROR_NONE != erc || !entry) {
+		k_mutex_unlock(&control_lock);
+		return erc;
+	}
+
+	if (entry->level == (uint8_t)level && !strcmp(entry->module, module)) {
+		/* Stored value is unchanged, avoid a flash write. */
+		k_mutex_unlock(&control_lock);
+		return SID_ERROR_NONE;
+	}
+
+	previous = *entry;
+	strncpy(entry->module, module, SID_LOG_CONTROL_MODULE_NAME_MAX);
+	entry->level = (uint8_t)level;
+
+	if (defer) {
+		store_pending = true;
+		(void)k_work_submit(&store_work);
+		k_mutex_unlock(&control_lock);
+		return SID_ERROR_NONE;
+	}
+
+	erc = sid_pal_storage_kv_record_set(LOG_CONTROL_KV_GROUP, LOG_CONTROL_KV_KEY, stored,
+					    sizeof(stored));
+	if (SID_ERROR_NONE != erc) {
+		LOG_ERR("Failed to store log level, err %d", erc);
+		*entry = previous;
+	} else {
+		/* Changes of a pending deferred write are stored as well. */
+		store_pending = false;
+	}
+	k_mutex_unlock(&control_lock);
+
+	return erc;
+}
+
+sid_error_t sid_log_control_set_level(const char *module, sid_pal_log_severity_t level,
+				      bool persist)
+{
+	return set_level(module, level, persist, false);
+}
+
+sid_error_t sid_log_control_set_level_deferred(const char *module, sid_pal_log_severity_t level)
+{
+	return set_level(module, level, true, true);
+}
+
+sid_error_t sid_log_control_get_level(const char *module, sid_pal_log_severity_t *level)
+{
+	if (!module || !level) {
+		return SID_ERROR_NULL_POINTER;
+	}
+
+	if (is_protocol(module)) {
+		*level = sid_log_control_get_current_log_level();
+		return SID_ERROR_NONE;
+	}
+
+#if defined(CONFIG_LOG_RUNTIME_FILTERING)
+	int source_id = log_source_id_get(module);
+	uint32_t zephyr_level;
+
+	if (source_id < 0) {
+		return SID_ERROR_NOT_FOUND;
+	}
+
+	zephyr_level = log_filter_get(NULL, Z_LOG_LOCAL_DOMAIN_ID, source_id, true);
+	/* Disabled module is reported with the lowest severity. */
+	*level = (sid_pal_log_severity_t)(zephyr_level ? zephyr_level - 1 : 0);
+
+	return SID_ERROR_NONE;
+#else
+	return SID_ERROR_NOSUPPORT;
+#endif /* CONFIG_LOG_RUNTIME_FILTERING */
+}
+
+sid_error_t sid_log_control_get_stored(size_t index, char *module, sid_pal_log_severity_t *level)
+{
+	sid_error_t erc = SID_ERROR_NOT_FOUND;
+
+	if (!module || !level) {
+		return SID_ERROR_NULL_POINTER;
+	}
+
+	k_mutex_lock(&control_lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(stored); i++) {
+		if (!stored[i].module[0]) {
+			continue;
+		}
+		if (!index--) {
+			memcpy(module, stored[i].module, sizeof(stored[i].module));
+			*level = (sid_pal_log_severity_t)stored[i].level;
+			erc = SID_ERROR_NONE;
+			break;
+		}
+	}
+	k_mutex_unlock(&control_lock);
+
+	return erc;
+}
+
+sid_error_t sid_log_control_reset(void)
+{
+	sid_error_t erc;
+
+	k_mutex_lock(&control_lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(stored); i++) {
+		if (stored[i].module[0]) {
+			restore_level(stored[i].module);
+		}
+	}
+	restore_level(SID_LOG_CONTROL_PROTOCOL_MODULE);
+	memset(stored, 0, sizeof(stored));
+	store_pending = false;
+
+	erc = sid_pal_storage_kv_record_delete(LOG_CONTROL_KV_GROUP, LOG_CONTROL_KV_KEY);
+	k_mutex_unlock(&control_lock);
+
+	return erc;
+}
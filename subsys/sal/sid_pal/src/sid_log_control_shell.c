@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <sid_log_control.h>
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+static const char *const level_names[] = {
+	[SID_PAL_LOG_SEVERITY_ERROR] = "err",
+	[SID_PAL_LOG_SEVERITY_WARNING] = "wrn",
+	[SID_PAL_LOG_SEVERITY_INFO] = "inf",
+	[SID_PAL_LOG_SEVERITY_DEBUG] = "dbg",
+};
+
+static int level_parse(const char *name, sid_pal_log_severity_t *level)
+{
+	for (int i = 0; i < ARRAY_SIZE(level_names); i++) {
+		if (!strcmp(name, level_names[i])) {
+			*level = (sid_pal_log_severity_t)i;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+static int cmd_log_level_get(const struct shell *shell, size_t argc, char **argv)
+{
+	const char *module = (argc > 1) ? argv[1] : SID_LOG_CONTROL_PROTOCOL_MODULE;
+	sid_pal_log_severity_t level;
+	sid_error_t erc;
+
+	erc = sid_log_control_get_level(module, &level);
+	if (SID_ERROR_NONE != erc) {
+		shell_error(shell, "Failed to get log level of %s, err %d", module, erc);
+		return -ENOEXEC;
+	}
+	shell_print(shell, "%s: %s", module, level_names[level]);
+
+	return 0;
+}
+
+static int cmd_log_level_set(const struct shell *shell, size_t argc, char **argv)
+{
+	bool persist = (argc > 3 && !strcmp(argv[3], "-p"));
+	sid_pal_log_severity_t level;
+	sid_error_t erc;
+
+	if ((argc > 3 && !persist) || level_parse(argv[2], &level)) {
+		shell_error(shell, "Usage: %s <module> <err|wrn|inf|dbg> [-p]", argv[0]);
+		return -EINVAL;
+	}
+
+	erc = sid_log_control_set_level(argv[1], level, persist);
+	if (SID_ERROR_NONE != erc) {
+		shell_error(shell, "Failed to set log level of %s, err %d", argv[1], erc);
+		return -ENOEXEC;
+	}
+
+	return 0;
+}
+
+static int cmd_log_level_stored(const struct shell *shell, size_t argc, char **argv)
+{
+	char module[SID_LOG_CONTROL_MODULE_NAME_MAX + 1];
+	sid_pal_log_severity_t level;
+
+	for (size_t i = 0; SID_ERROR_NONE == sid_log_control_get_stored(i, module, &level); i++) {
+		shell_print(shell, "%s: %s", module, level_names[level]);
+	}
+
+	return 0;
+}
+
+static int cmd_log_level_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	sid_error_t erc = sid_log_control_reset();
+
+	if (SID_ERROR_NONE != erc) {
+		shell_error(shell, "Failed to erase stored log levels, err %d", erc);
+		return -ENOEXEC;
+	}
+	shell_print(shell, "Log levels restored");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_sid_log_level,
+	SHELL_CMD_ARG(get, NULL, "[module] print runtime log level, default module is sidewalk",
+		      cmd_log_level_get, 1, 1),
+	SHELL_CMD_ARG(set, NULL, "<module> <err|wrn|inf|dbg> [-p] set log level, -p stores it",
+		      cmd_log_level_set, 3, 1),
+	SHELL_CMD_ARG(stored, NULL, "print stored log levels", cmd_log_level_stored, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "restore compiled log levels and erase stored ones",
+		      cmd_log_level_reset, 1, 0),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(sid_log_level, &sub_sid_log_level, "Sidewalk runtime log levels", NULL);
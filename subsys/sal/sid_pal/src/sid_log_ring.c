@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_log_ring.c
+ *  @brief In-RAM ring of recent Sidewalk log records.
+ */
+
+#include <sid_log_ring.h>
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/cbprintf.h>
+
+#define RING_RECORDS (CONFIG_SIDEWALK_LOG_RING_RECORDS)
+#define RING_PACKAGE_SIZE (CONFIG_SIDEWALK_LOG_RING_RECORD_SIZE)
+
+/* Slot sequence value while the slot is empty or being written. */
+#define SLOT_NOT_READY (0)
+
+struct log_slot {
+	/* Sequence number of the stored record + 1, SLOT_NOT_READY while being written. */
+	atomic_t ready;
+	/* Set while a writer owns the slot. */
+	atomic_t busy;
+	uint32_t timestamp_ms;
+	uint8_t severity;
+	uint16_t package_len;
+	uint8_t package[RING_PACKAGE_SIZE] __aligned(CBPRINTF_PACKAGE_ALIGNMENT);
+};
+
+struct format_ctx {
+	char *buf;
+	size_t size;
+	size_t len;
+};
+
+static struct log_slot slots[RING_RECORDS];
+/* Sequence number of the next record to write. */
+static atomic_t ring_head;
+/* Sequence number of the next record to read. */
+static atomic_t ring_tail;
+static atomic_t ring_dropped;
+
+static const char record_too_long[] = "<log record too long>";
+
+void sid_log_ring_put(sid_pal_log_severity_t severity, const char *fmt, va_list args)
+{
+	uint32_t seq = (uint32_t)atomic_inc(&ring_head);
+	struct log_slot *slot = &slots[seq % RING_RECORDS];
+	va_list args_copy;
+	int len;
+
+	/* A writer a full ring ahead or behind may target the same slot, only one writes it. */
+	if (!atomic_cas(&slot->busy, 0, 1)) {
+		atomic_inc(&ring_dropped);
+		return;
+	}
+
+	if ((int32_t)((uint32_t)atomic_get(&slot->ready) - (seq + 1)) > 0) {
+		/* A newer record is already stored. */
+		atomic_inc(&ring_dropped);
+		atomic_clear(&slot->busy);
+		return;
+	}
+
+	atomic_set(&slot->ready, SLOT_NOT_READY);
+
+	slot->timestamp_ms = k_uptime_get_32();
+	slot->severity = (uint8_t)severity;
+
+	/* Packaged once into the slot, strings in RAM are appended to the package. */
+	va_copy(args_copy, args);
+	len = cbvprintf_package(slot->package, sizeof(slot->package), 0, fmt, args_copy);
+	va_end(args_copy);
+
+	if (len < 0) {
+		atomic_inc(&ring_dropped);
+		len = cbprintf_package(slot->package, sizeof(slot->package), 0, record_too_long);
+	}
+	slot->package_len = (len > 0) ? (uint16_t)len : 0;
+
+	atomic_set(&slot->ready, (atomic_val_t)(seq + 1));
+	atomic_clear(&slot->busy);
+}
+
+size_t sid_log_ring_drain(sid_log_ring_drain_cb_t cb, void *ctx, size_t max_records)
+{
+	struct log_slot copy;
+	struct sid_log_record record;
+	size_t consumed = 0;
+
+	if (!cb) {
+		return 0;
+	}
+
+	while (consumed < max_records) {
+		uint32_t head = (uint32_t)atomic_get(&ring_head);
+		uint32_t tail = (uint32_t)atomic_get(&ring_tail);
+
+		if (head - tail > RING_RECORDS) {
+			/* Oldest records were overwritten. */
+			atomic_add(&ring_dropped, (atomic_val_t)(head - RING_RECORDS - tail));
+			tail = head - RING_RECORDS;
+			atomic_set(&ring_tail, (atomic_val_t)tail);
+		}
+
+		if (tail == head) {
+			break;
+		}
+
+		struct log_slot *slot = &slots[tail % RING_RECORDS];
+		atomic_val_t ready = atomic_get(&slot->ready);
+
+		if (SLOT_NOT_READY == ready) {
+			/* The record is still being written. */
+			break;
+		}
+
+		if ((uint32_t)ready != tail + 1) {
+			/* Overwritten by a newer record. */
+			atomic_inc(&ring_dropped);
+			atomic_set(&ring_tail, (atomic_val_t)(tail + 1));
+			continue;
+		}
+
+		memcpy(&copy, slot, sizeof(copy));
+		if ((uint32_t)atomic_get(&slot->ready) != tail + 1) {
+			/* Overwritten while copied. */
+			atomic_inc(&ring_dropped);
+			atomic_set(&ring_tail, (atomic_val_t)(tail + 1));
+			continue;
+		}
+
+		record.seq = tail;
+		record.timestamp_ms = copy.timestamp_ms;
+		record.severity = (sid_pal_log_severity_t)copy.severity;
+		record.package = copy.package;
+		record.package_len = copy.package_len;
+
+		if (!cb(&record, ctx)) {
+			break;
+		}
+
+		atomic_set(&ring_tail, (atomic_val_t)(tail + 1));
+		consumed++;
+	}
+
+	return consumed;
+}
+
+static int format_out(int c, void *ctx)
+{
+	struct format_ctx *out = ctx;
+
+	if (out->len + 1 < out->size) {
+		out->buf[out->len++] = (char)c;
+	}
+
+	return c;
+}
+
+size_t sid_log_ring_format(const struct sid_log_record *record, char *buf, size_t size)
+{
+	struct format_ctx out = { .buf = buf, .size = size, .len = 0 };
+
+	if (!record || !buf || !size) {
+		return 0;
+	}
+
+	if (record->package_len) {
+		/* Package is copied, cbpprintf may modify it. */
+		uint8_t package[RING_PACKAGE_SIZE] __aligned(CBPRINTF_PACKAGE_ALIGNMENT);
+
+		memcpy(package, record->package, MIN(record->package_len, sizeof(package)));
+		(void)cbpprintf(format_out, &out, package);
+	}
+	buf[out.len] = '\0';
+
+	return out.len;
+}
+
+uint32_t sid_log_ring_dropped(void)
+{
+	return (uint32_t)atomic_get(&ring_dropped);
+}
+
+void sid_log_ring_reset(void)
+{
+	atomic_set(&ring_tail, atomic_get(&ring_head));
+	atomic_clear(&ring_dropped);
+}
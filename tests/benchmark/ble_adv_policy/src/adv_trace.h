@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Connection arrival traces, one entry per advertising session. Times are in ms from the
+ * advertising start. The gateway starts scanning at the arrival time and connects at the
+ * first advertising event after it. A session without arrival ends after its duration.
+ */
+
+#ifndef ADV_TRACE_H
+#define ADV_TRACE_H
+
+#include <stdint.h>
+
+#define ADV_TRACE_UPDATES_MAX (4)
+#define NONE (UINT32_MAX)
+
+struct adv_trace_session {
+	uint32_t duration_ms;
+	uint32_t arrival_ms;
+	/* Advertising data updates, zero terminated. */
+	uint32_t updates_ms[ADV_TRACE_UPDATES_MAX];
+};
+
+#define SESSION(_duration, _arrival, ...)                                                          \
+	{                                                                                          \
+		.duration_ms = (_duration), .arrival_ms = (_arrival), .updates_ms = { __VA_ARGS__ } \
+	}
+
+/* Gateway in range at the advertising start. */
+static const struct adv_trace_session trace_nearby[] = {
+	SESSION(300000, 1532),
+	SESSION(300000, 5893),
+	SESSION(300000, 2175),
+	SESSION(300000, 8823),
+	SESSION(300000, 214),
+	SESSION(300000, 5230),
+	SESSION(300000, 436),
+	SESSION(300000, NONE),
+	SESSION(300000, 10316),
+	SESSION(300000, NONE),
+	SESSION(300000, 10991),
+	SESSION(300000, 509),
+	SESSION(300000, 231),
+	SESSION(300000, 2358),
+	SESSION(300000, 769),
+	SESSION(300000, 4521),
+	SESSION(300000, 338),
+	SESSION(300000, 214),
+	SESSION(300000, 6163),
+	SESSION(300000, 1077),
+	SESSION(300000, 683),
+	SESSION(300000, 855),
+	SESSION(300000, 3731),
+	SESSION(300000, 200),
+	SESSION(300000, 369),
+	SESSION(300000, 1366),
+	SESSION(300000, 2522),
+	SESSION(300000, 564),
+	SESSION(300000, 204),
+	SESSION(300000, 5861),
+	SESSION(300000, 3),
+	SESSION(300000, 615),
+};
+
+/* Gateway rarely in range, most sessions end without a connection. */
+static const struct adv_trace_session trace_sparse[] = {
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, 36737),
+	SESSION(600000, 246043),
+	SESSION(600000, NONE),
+	SESSION(600000, 411007),
+	SESSION(600000, NONE),
+	SESSION(600000, 399584),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, 208863),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, 259345),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, NONE),
+	SESSION(600000, 3256),
+};
+
+/* Gateway connects shortly after it receives updated advertising data. */
+static const struct adv_trace_session trace_update_driven[] = {
+	SESSION(900000, NONE, 41514, 274791, 437212, 568588),
+	SESSION(900000, NONE, 54410, 242799, 318832, 465818),
+	SESSION(900000, NONE, 55898, 119472, 199070, 297004),
+	SESSION(900000, 59362, 59225, 173488, 237683, 395379),
+	SESSION(900000, 57533, 56194, 281092, 445029, 528127),
+	SESSION(900000, 44864, 44065, 276081, 339870, 507078),
+	SESSION(900000, 30656, 30181, 220286, 347173, 509406),
+	SESSION(900000, NONE, 41560, 162547, 300433, 437857),
+	SESSION(900000, 742348, 58744, 276079, 504384, 741129),
+	SESSION(900000, 600310, 37758, 252798, 375728, 599125),
+	SESSION(900000, 157023, 48354, 155526, 364069, 447562),
+	SESSION(900000, NONE, 24163, 195729, 267226, 411460),
+	SESSION(900000, NONE, 24522, 133786, 355914, 501531),
+	SESSION(900000, 328741, 22602, 116748, 327369, 441157),
+	SESSION(900000, 329155, 48197, 229478, 328357, 445710),
+	SESSION(900000, 158104, 42946, 157037, 261275, 412921),
+	SESSION(900000, 355250, 23150, 123617, 271719, 354668),
+	SESSION(900000, NONE, 21410, 122137, 239759, 340905),
+	SESSION(900000, 136522, 43805, 135231, 195854, 318089),
+	SESSION(900000, 467268, 45588, 237877, 466503, 601980),
+	SESSION(900000, 555417, 26890, 172714, 398904, 554973),
+	SESSION(900000, NONE, 27099, 108336, 216364, 332950),
+	SESSION(900000, 191532, 39345, 190742, 352762, 506497),
+	SESSION(900000, NONE, 37852, 198610, 263734, 333435),
+	SESSION(900000, NONE, 32295, 158478, 352699, 511359),
+	SESSION(900000, NONE, 53577, 247277, 416558, 554806),
+	SESSION(900000, 165220, 38718, 164463, 234919, 397315),
+	SESSION(900000, NONE, 23676, 130102, 271050, 410314),
+	SESSION(900000, 328284, 44175, 217763, 327441, 543160),
+	SESSION(900000, NONE, 58121, 154917, 380515, 615494),
+	SESSION(900000, NONE, 46614, 152766, 363822, 569321),
+	SESSION(900000, 280564, 53662, 156755, 279395, 515155),
+};
+
+#endif /* ADV_TRACE_H */
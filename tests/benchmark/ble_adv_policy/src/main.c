@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Replay of connection arrival traces against advertising policies. The time is simulated,
+ * energy is counted in advertising events and latency is the time from the gateway arrival
+ * to the advertising event it connects on.
+ */
+
+#include "kconfig_mock.h"
+#include "adv_trace.h"
+#include <sid_ble_adv_policy.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#define FAST_INTERVAL_MS (CONFIG_SIDEWALK_BLE_ADV_INT_FAST)
+#define SLOW_INTERVAL_MS (CONFIG_SIDEWALK_BLE_ADV_INT_SLOW)
+/* Connection time before the advertising is restarted. */
+#define SESSION_GAP_MS (10 * MSEC_PER_SEC)
+#define WINDOW_INFINITE (UINT32_MAX)
+
+struct sim_policy {
+	const char *name;
+	void (*reset)(void);
+	uint32_t (*start)(uint32_t now_ms);
+	void (*connected)(uint32_t now_ms);
+	void (*stopped)(uint32_t now_ms);
+	uint32_t (*data_updated)(uint32_t now_ms);
+};
+
+struct sim_trace {
+	const char *name;
+	const struct adv_trace_session *sessions;
+	size_t count;
+};
+
+struct sim_result {
+	uint32_t sessions;
+	uint32_t connections;
+	uint32_t adv_events;
+	uint64_t latency_sum_ms;
+	uint32_t latency_max_ms;
+};
+
+static bool first_result = true;
+
+static void policy_none_reset(void)
+{
+}
+
+static void policy_none_event(uint32_t now_ms)
+{
+}
+
+static uint32_t policy_none_data_updated(uint32_t now_ms)
+{
+	return 0;
+}
+
+/* Fast advertising for SIDEWALK_BLE_ADV_INT_TRANSITION, the default. */
+static uint32_t policy_fixed_start(uint32_t now_ms)
+{
+	return CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION * MSEC_PER_SEC;
+}
+
+static uint32_t policy_fast_start(uint32_t now_ms)
+{
+	return WINDOW_INFINITE;
+}
+
+static uint32_t policy_slow_start(uint32_t now_ms)
+{
+	return 0;
+}
+
+static const struct sim_policy policies[] = {
+	{ .name = "fixed",
+	  .reset = policy_none_reset,
+	  .start = policy_fixed_start,
+	  .connected = policy_none_event,
+	  .stopped = policy_none_event,
+	  .data_updated = policy_none_data_updated },
+	{ .name = "fast",
+	  .reset = policy_none_reset,
+	  .start = policy_fast_start,
+	  .connected = policy_none_event,
+	  .stopped = policy_none_event,
+	  .data_updated = policy_none_data_updated },
+	{ .name = "slow",
+	  .reset = policy_none_reset,
+	  .start = policy_slow_start,
+	  .connected = policy_none_event,
+	  .stopped = policy_none_event,
+	  .data_updated = policy_none_data_updated },
+	{ .name = "adaptive",
+	  .reset = sid_ble_adv_policy_reset,
+	  .start = sid_ble_adv_policy_start,
+	  .connected = sid_ble_adv_policy_connected,
+	  .stopped = sid_ble_adv_policy_stopped,
+	  .data_updated = sid_ble_adv_policy_data_updated },
+};
+
+static const struct sim_trace traces[] = {
+	{ .name = "nearby", .sessions = trace_nearby, .count = ARRAY_SIZE(trace_nearby) },
+	{ .name = "sparse", .sessions = trace_sparse, .count = ARRAY_SIZE(trace_sparse) },
+	{ .name = "update_driven",
+	  .sessions = trace_update_driven,
+	  .count = ARRAY_SIZE(trace_update_driven) },
+};
+
+/* Returns the session length, times are relative to the advertising start. */
+static uint32_t sim_session(const struct sim_policy *policy,
+			    const struct adv_trace_session *session, uint32_t start_ms,
+			    struct sim_result *result)
+{
+	uint32_t fast_end_ms = policy->start(start_ms);
+	size_t update = 0;
+	uint32_t t = 0;
+
+	result->sessions++;
+	while (t < session->duration_ms) {
+		result->adv_events++;
+		if (t >= session->arrival_ms) {
+			uint32_t latency_ms = t - session->arrival_ms;
+
+			result->connections++;
+			result->latency_sum_ms += latency_ms;
+			result->latency_max_ms = MAX(result->latency_max_ms, latency_ms);
+			policy->connected(start_ms + t);
+			return t;
+		}
+
+		uint32_t next = t + ((t < fast_end_ms) ? FAST_INTERVAL_MS : SLOW_INTERVAL_MS);
+
+		/* A burst starts advertising at the update. */
+		while (update < ADV_TRACE_UPDATES_MAX && session->updates_ms[update] &&
+		       session->updates_ms[update] <= next) {
+			uint32_t burst_ms = policy->data_updated(start_ms + session->updates_ms[update]);
+
+			if (burst_ms) {
+				next = session->updates_ms[update];
+				fast_end_ms = next + burst_ms;
+			}
+			update++;
+		}
+		t = next;
+	}
+
+	policy->stopped(start_ms + session->duration_ms);
+
+	return session->duration_ms;
+}
+
+static void sim_report(const struct sim_trace *trace, const struct sim_policy *policy,
+		       const struct sim_result *result)
+{
+	uint64_t charge_uc =
+		(uint64_t)result->adv_events * CONFIG_BLE_ADV_POLICY_SIM_EVENT_CHARGE / 1000;
+	uint32_t latency_avg_ms =
+		result->connections ? (uint32_t)(result->latency_sum_ms / result->connections) : 0;
+
+	printk("%s  {\"trace\": \"%s\", \"policy\": \"%s\", \"sessions\": %u, "
+	       "\"connections\": %u, \"latency_avg_ms\": %u, \"latency_max_ms\": %u, "
+	       "\"adv_events\": %u, \"charge_uc\": %llu}",
+	       first_result ? "" : ",\n", trace->name, policy->name, result->sessions,
+	       result->connections, latency_avg_ms, result->latency_max_ms, result->adv_events,
+	       (unsigned long long)charge_uc);
+	first_result = false;
+}
+
+static void sim_run(const struct sim_trace *trace, const struct sim_policy *policy)
+{
+	struct sim_result result = { 0 };
+	uint32_t clock_ms = 0;
+
+	policy->reset();
+	for (size_t i = 0; i < trace->count; i++) {
+		clock_ms += sim_session(policy, &trace->sessions[i], clock_ms, &result);
+		clock_ms += SESSION_GAP_MS;
+	}
+
+	sim_report(trace, policy, &result);
+}
+
+int main(void)
+{
+	printk("{\"benchmark\": \"sid_ble_adv_policy\", \"board\": \"%s\", \"results\": [\n",
+	       CONFIG_BOARD);
+
+	for (size_t i = 0; i < ARRAY_SIZE(traces); i++) {
+		for (size_t j = 0; j < ARRAY_SIZE(policies); j++) {
+			sim_run(&traces[i], &policies[j]);
+		}
+	}
+
+	printk("\n]}\n");
+
+	return 0;
+}
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Default vendor channel and notification configuration. */
+#define CONFIG_BT_MAX_CONN 1
+#define CONFIG_BT_L2CAP_DYNAMIC_CHANNEL 1
+#define CONFIG_BT_CONN_TX_USER_DATA_SIZE 8
+#define CONFIG_SIDEWALK_VENDOR_SERVICE 1
+#define CONFIG_SIDEWALK_BLE_NOTIFY_TX_CREDITS 3
+#define CONFIG_SIDEWALK_BLE_VND_L2CAP 1
+#define CONFIG_SIDEWALK_BLE_VND_L2CAP_PSM 0x80
+#define CONFIG_SIDEWALK_BLE_VND_L2CAP_SEC_LEVEL 2
+#define CONFIG_SIDEWALK_BLE_VND_L2CAP_MTU 512
+#define CONFIG_SIDEWALK_BLE_VND_L2CAP_TX_COUNT 2
@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Vendor data throughput of the vendor service notifications and of the vendor L2CAP channel.
+ * The adapter send paths run against a link layer model: PDUs are sent in connection events
+ * of the peripheral, each exchange takes an empty central PDU, a data PDU and two T_IFS. The
+ * time is simulated, the protocol sends the next fragment when the previous one is
+ * acknowledged.
+ */
+
+#include "kconfig_mock.h"
+#include <sid_ble_service.h>
+#include <sid_ble_vnd_l2cap.h>
+#include <sid_ble_adapter_callbacks.h>
+
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/l2cap.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/sys/util.h>
+
+#include <string.h>
+
+#define BLOB_SIZE (CONFIG_BLE_VND_THROUGHPUT_BLOB_SIZE)
+#define ATT_MTU (247)
+#define ATT_NOTIFY_HDR (3)
+#define L2CAP_HDR (4)
+#define L2CAP_SDU_HDR (2)
+/* MPS of the peer, a K-frame fits in one PDU of the longest data length. */
+#define PEER_MPS (247)
+#define T_IFS_US (150)
+/* Access address, header and CRC of a LL PDU. */
+#define LL_PDU_OVERHEAD (4 + 2 + 3)
+/* L2CAP PDUs in flight, bound by the notification credits and by the TX buffers. */
+#define LINK_QUEUE_SIZE (16)
+
+struct sim_phy {
+	const char *name;
+	/* Bits per us. */
+	uint32_t rate;
+	uint32_t preamble;
+};
+
+struct sim_link {
+	const struct sim_phy *phy;
+	uint16_t data_len;
+	uint32_t interval_us;
+};
+
+struct sim_path {
+	const char *name;
+	uint16_t fragment;
+	int (*send)(const uint8_t *data, uint16_t length);
+};
+
+/* Notification or K-frame in the controller. The completion is given with the last one. */
+struct link_pdu {
+	uint16_t len;
+	bool last;
+	bt_gatt_complete_func_t func;
+	void *user_data;
+	struct bt_l2cap_chan *chan;
+	struct net_buf *buf;
+};
+
+struct sim_result {
+	uint32_t events;
+	uint32_t packets;
+	uint32_t send_errors;
+};
+
+struct bt_conn {
+	uint8_t index;
+};
+
+static struct bt_conn sim_conn;
+static struct bt_l2cap_server *sim_server;
+static struct bt_l2cap_chan *sim_chan;
+
+static struct link_pdu link_queue[LINK_QUEUE_SIZE];
+static size_t link_head;
+static size_t link_count;
+
+static const struct sim_path *sim_path_active;
+static uint8_t blob[BLOB_SIZE];
+static size_t blob_offset;
+static uint32_t send_errors;
+
+static bool first_result = true;
+
+static struct bt_gatt_attr notify_attr;
+static const struct bt_gatt_service_static notify_service = {
+	.attrs = &notify_attr,
+	.attr_count = 1,
+};
+
+/******************************************************************
+* Bluetooth host
+* ****************************************************************/
+
+uint8_t bt_conn_index(const struct bt_conn *conn)
+{
+	return conn->index;
+}
+
+void bt_conn_cb_register(struct bt_conn_cb *cb)
+{
+	ARG_UNUSED(cb);
+}
+
+uint16_t bt_gatt_get_mtu(struct bt_conn *conn)
+{
+	return ATT_MTU;
+}
+
+bool bt_gatt_is_subscribed(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			   uint16_t ccc_value)
+{
+	return true;
+}
+
+struct bt_gatt_attr *bt_gatt_find_by_uuid(const struct bt_gatt_attr *attr, uint16_t attr_count,
+					  const struct bt_uuid *uuid)
+{
+	return &notify_attr;
+}
+
+const struct bt_gatt_service_static *sid_ble_get_ama_service(void)
+{
+	return &notify_service;
+}
+
+const struct bt_gatt_service_static *sid_ble_get_vnd_service(void)
+{
+	return &notify_service;
+}
+
+bool sid_ble_conn_rx(struct bt_conn *conn)
+{
+	ARG_UNUSED(conn);
+
+	return true;
+}
+
+static struct link_pdu *link_push(uint16_t len)
+{
+	struct link_pdu *pdu;
+
+	__ASSERT(link_count < ARRAY_SIZE(link_queue), "link queue full");
+	pdu = &link_queue[(link_head + link_count) % ARRAY_SIZE(link_queue)];
+	link_count++;
+	memset(pdu, 0, sizeof(*pdu));
+	pdu->len = len;
+
+	return pdu;
+}
+
+int bt_gatt_notify_cb(struct bt_conn *conn, struct bt_gatt_notify_params *params)
+{
+	struct link_pdu *pdu = link_push(params->len + ATT_NOTIFY_HDR + L2CAP_HDR);
+
+	pdu->last = true;
+	pdu->func = params->func;
+	pdu->user_data = params->user_data;
+
+	return 0;
+}
+
+int bt_l2cap_chan_send(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	struct bt_l2cap_le_chan *le = CONTAINER_OF(chan, struct bt_l2cap_le_chan, chan);
+	uint32_t left = buf->len + L2CAP_SDU_HDR;
+
+	/* The host segments the SDU into K-frames of the peer MPS. */
+	while (left) {
+		uint16_t payload = MIN(left, le->tx.mps);
+		struct link_pdu *pdu = link_push(payload + L2CAP_HDR);
+
+		left -= payload;
+		if (!left) {
+			pdu->last = true;
+			pdu->chan = chan;
+			pdu->buf = buf;
+		}
+	}
+
+	return 0;
+}
+
+int bt_l2cap_chan_recv_complete(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	ARG_UNUSED(chan);
+
+	net_buf_unref(buf);
+
+	return 0;
+}
+
+int bt_l2cap_server_register(struct bt_l2cap_server *server)
+{
+	sim_server = server;
+
+	return 0;
+}
+
+/******************************************************************
+* Link layer
+* ****************************************************************/
+
+static uint32_t ll_airtime_us(const struct sim_phy *phy, uint16_t payload)
+{
+	return (phy->preamble + LL_PDU_OVERHEAD + payload) * 8 / phy->rate;
+}
+
+/* One connection event, PDUs are sent while they fit in the event and the peer has credits
+ * for the K-frames. Returns the LL data PDUs sent.
+ */
+static uint32_t link_event(const struct sim_link *link)
+{
+	struct link_pdu done[LINK_QUEUE_SIZE];
+	size_t done_count = 0;
+	uint32_t budget_us = MIN(link->interval_us - T_IFS_US, CONFIG_BLE_VND_THROUGHPUT_EVENT_LEN);
+	uint32_t peer_credits = CONFIG_BLE_VND_THROUGHPUT_PEER_CREDITS;
+	uint32_t elapsed_us = 0;
+	uint32_t packets = 0;
+
+	while (link_count) {
+		struct link_pdu *pdu = &link_queue[link_head];
+		bool k_frame = (pdu->func == NULL);
+		/* Only the rest of the PDU is left if it was cut by the end of the last event. */
+		uint16_t sent = 0;
+
+		if (k_frame && !peer_credits) {
+			break;
+		}
+
+		while (sent < pdu->len) {
+			uint16_t payload = MIN(pdu->len - sent, link->data_len);
+			uint32_t exchange_us = ll_airtime_us(link->phy, 0) +
+					       ll_airtime_us(link->phy, payload) + 2 * T_IFS_US;
+
+			if (elapsed_us + exchange_us > budget_us) {
+				break;
+			}
+			elapsed_us += exchange_us;
+			sent += payload;
+			packets++;
+		}
+
+		if (sent < pdu->len) {
+			pdu->len -= sent;
+			break;
+		}
+
+		if (k_frame) {
+			peer_credits--;
+		}
+		if (pdu->last) {
+			done[done_count++] = *pdu;
+		}
+		link_head = (link_head + 1) % ARRAY_SIZE(link_queue);
+		link_count--;
+	}
+
+	/* Completions are given after the event, as the host does on Number Of Completed
+	 * Packets.
+	 */
+	for (size_t i = 0; i < done_count; i++) {
+		if (done[i].func) {
+			done[i].func(&sim_conn, done[i].user_data);
+		} else {
+			done[i].chan->ops->sent(done[i].chan);
+			net_buf_unref(done[i].buf);
+		}
+	}
+
+	return packets;
+}
+
+/******************************************************************
+* Protocol
+* ****************************************************************/
+
+static int send_gatt(const uint8_t *data, uint16_t length)
+{
+	sid_ble_srv_params_t params = { .conn = &sim_conn, .id = VENDOR_SERVICE };
+
+	return sid_ble_send_data(&params, (uint8_t *)data, length);
+}
+
+static int send_l2cap(const uint8_t *data, uint16_t length)
+{
+	return sid_ble_vnd_l2cap_send(&sim_conn, data, length);
+}
+
+static const struct sim_path paths[] = {
+	{ .name = "gatt", .fragment = ATT_MTU - ATT_NOTIFY_HDR, .send = send_gatt },
+	{ .name = "l2cap", .fragment = CONFIG_SIDEWALK_BLE_VND_L2CAP_MTU, .send = send_l2cap },
+};
+
+static void protocol_send_next(void)
+{
+	size_t offset = blob_offset;
+	uint16_t length;
+
+	if (offset >= sizeof(blob)) {
+		return;
+	}
+
+	/* The acknowledge of this send may come before it returns. */
+	length = MIN(sizeof(blob) - offset, sim_path_active->fragment);
+	blob_offset += length;
+	if (sim_path_active->send(&blob[offset], length)) {
+		blob_offset = offset;
+		send_errors++;
+	}
+}
+
+static void protocol_notification_sent(bool sent)
+{
+	ARG_UNUSED(sent);
+
+	protocol_send_next();
+}
+
+static void l2cap_connect(void)
+{
+	struct bt_l2cap_le_chan *le;
+
+	__ASSERT(sim_server, "L2CAP server not registered");
+	if (sim_server->accept(&sim_conn, &sim_chan)) {
+		return;
+	}
+
+	le = CONTAINER_OF(sim_chan, struct bt_l2cap_le_chan, chan);
+	sim_chan->conn = &sim_conn;
+	le->tx.mtu = CONFIG_SIDEWALK_BLE_VND_L2CAP_MTU;
+	le->tx.mps = PEER_MPS;
+	sim_chan->ops->connected(sim_chan);
+}
+
+/******************************************************************
+* Benchmark
+* ****************************************************************/
+
+static const struct sim_phy phys[] = {
+	{ .name = "1M", .rate = 1, .preamble = 1 },
+	{ .name = "2M", .rate = 2, .preamble = 2 },
+};
+
+static const uint16_t data_lens[] = { 27, 251 };
+static const uint32_t intervals_us[] = { 15000, 45000 };
+
+static void sim_report(const struct sim_link *link, const struct sim_path *path,
+		       const struct sim_result *result)
+{
+	uint64_t duration_us = (uint64_t)result->events * link->interval_us;
+	uint32_t throughput_kbps = 0;
+
+	if (duration_us) {
+		throughput_kbps = (uint32_t)((uint64_t)BLOB_SIZE * 8 * 1000 / duration_us);
+	}
+
+	printk("%s  {\"path\": \"%s\", \"phy\": \"%s\", \"data_len\": %u, \"interval_us\": %u, "
+	       "\"throughput_kbps\": %u, \"events\": %u, \"packets\": %u, \"send_errors\": %u}",
+	       first_result ? "" : ",\n", path->name, link->phy->name, link->data_len,
+	       link->interval_us, throughput_kbps, result->events, result->packets,
+	       result->send_errors);
+	first_result = false;
+}
+
+static void sim_run(const struct sim_link *link, const struct sim_path *path)
+{
+	struct sim_result result = { 0 };
+
+	sid_ble_service_init();
+	sim_path_active = path;
+	blob_offset = 0;
+	send_errors = 0;
+
+	protocol_send_next();
+	/* The acknowledges of queued fragments come from the system work queue. */
+	k_sleep(K_MSEC(1));
+	while (link_count) {
+		result.packets += link_event(link);
+		result.events++;
+		k_sleep(K_MSEC(1));
+	}
+	result.send_errors = send_errors;
+
+	sim_report(link, path, &result);
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(blob); i++) {
+		blob[i] = (uint8_t)i;
+	}
+	sid_ble_adapter_notification_cb_set(protocol_notification_sent);
+	sid_ble_vnd_l2cap_init();
+	l2cap_connect();
+
+	printk("{\"benchmark\": \"sid_ble_vnd_throughput\", \"board\": \"%s\", \"results\": [\n",
+	       CONFIG_BOARD);
+
+	for (size_t i = 0; i < ARRAY_SIZE(paths); i++) {
+		for (size_t j = 0; j < ARRAY_SIZE(phys); j++) {
+			for (size_t k = 0; k < ARRAY_SIZE(data_lens); k++) {
+				for (size_t l = 0; l < ARRAY_SIZE(intervals_us); l++) {
+					struct sim_link link = {
+						.phy = &phys[j],
+						.data_len = data_lens[k],
+						.interval_us = intervals_us[l],
+					};
+
+					sim_run(&link, &paths[i]);
+				}
+			}
+		}
+	}
+
+	printk("\n]}\n");
+
+	return 0;
+}
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <sid_pal_crypto_ifc.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#if defined(CONFIG_ARCH_POSIX)
+#include <native_rtc.h>
+#else
+#include <zephyr/timing/timing.h>
+#endif /* CONFIG_ARCH_POSIX */
+
+#define BENCH_ITERATIONS (CONFIG_CRYPTO_BENCHMARK_ITERATIONS)
+#define BENCH_ECC_ITERATIONS (CONFIG_CRYPTO_BENCHMARK_ECC_ITERATIONS)
+
+#define BENCH_DATA_MAX_SIZE (255)
+#define BENCH_SIGN_DATA_SIZE (64)
+
+#define SHA256_LEN (32)
+#define SHA512_LEN (64)
+
+#define AES_KEY_SIZE (16)
+#define AES_BLOCK_SIZE (16)
+#define AES_GCM_IV_SIZE (12)
+#define AES_CCM_IV_SIZE (13)
+#define AEAD_AAD_SIZE (8)
+#define AEAD_MAC_SIZE (16)
+#define CCM_STAR_MIC_SIZE (8)
+#define HMAC_KEY_SIZE (32)
+
+#define EC_PRIV_KEY_LEN (32)
+#define EC_PUB_KEY_MAX_LEN (64)
+#define EC_SIGNATURE_SIZE (64)
+#define ECDH_SECRET_SIZE (32)
+
+typedef sid_error_t (*bench_op_t)(void *params);
+
+/* Sidewalk frame sizes: short beacon, 19 byte payload, typical, max. BLE and max. frame. */
+static const size_t data_sizes[] = { 16, 19, 64, 128, 255 };
+
+static const uint8_t aes_key[AES_KEY_SIZE] = { 0xAC, 0x1D, 0x05, 0x22, 0xAC, 0x1D, 0x05, 0x22,
+					       0xFA, 0xD4, 0xCC, 0x29, 0xFA, 0xD4, 0xCC, 0x29 };
+
+static const uint8_t hmac_key[HMAC_KEY_SIZE] = { 0xAC, 0x1D, 0x05, 0x22, 0xAC, 0x1D, 0x05, 0x22,
+						 0xFA, 0xD4, 0xCC, 0x29, 0xFA, 0xD4, 0xCC, 0x29,
+						 0xDA, 0x3C, 0xEE, 0xA4, 0x82, 0x0D, 0xAA, 0x50,
+						 0xAC, 0xFE, 0xBB, 0x34, 0x1D, 0x05, 0x22, 0xAC };
+
+static uint8_t data_in[BENCH_DATA_MAX_SIZE];
+static uint8_t data_out[BENCH_DATA_MAX_SIZE];
+static uint8_t aad[AEAD_AAD_SIZE];
+static uint8_t iv[AES_BLOCK_SIZE];
+static uint8_t mac[AEAD_MAC_SIZE];
+static uint8_t digest[SHA512_LEN];
+
+static bool first_result = true;
+
+#if defined(CONFIG_ARCH_POSIX)
+/* Simulated time does not advance during the computation, so the host clock is used. */
+typedef uint64_t bench_time_t;
+
+static void bench_clock_init(void)
+{
+}
+
+static bench_time_t bench_clock_get(void)
+{
+	return native_rtc_gettime_us(RTC_CLOCK_REAL);
+}
+
+static uint64_t bench_clock_elapsed_ns(bench_time_t start, bench_time_t end)
+{
+	return (end - start) * NSEC_PER_USEC;
+}
+
+/* Host clock is reported as a nominal 1 GHz clock, so one cycle is one nanosecond. */
+static uint64_t bench_clock_hz(void)
+{
+	return NSEC_PER_SEC;
+}
+#else
+typedef timing_t bench_time_t;
+
+static void bench_clock_init(void)
+{
+	timing_init();
+	timing_start();
+}
+
+static bench_time_t bench_clock_get(void)
+{
+	return timing_counter_get();
+}
+
+static uint64_t bench_clock_elapsed_ns(bench_time_t start, bench_time_t end)
+{
+	return timing_cycles_to_ns(timing_cycles_get(&start, &end));
+}
+
+static uint64_t bench_clock_hz(void)
+{
+	return (uint64_t)timing_freq_get_mhz() * 1000000ULL;
+}
+#endif /* CONFIG_ARCH_POSIX */
+
+static void bench_report(const char *op, size_t size, uint32_t iterations, uint32_t errors,
+			 uint64_t elapsed_ns)
+{
+	uint64_t ns_per_op = elapsed_ns / iterations;
+	uint64_t ops_per_sec = elapsed_ns ? ((uint64_t)NSEC_PER_SEC * iterations / elapsed_ns) : 0;
+	uint64_t cycles_per_op = ns_per_op * bench_clock_hz() / NSEC_PER_SEC;
+
+	printk("%s  {\"op\": \"%s\", \"size\": %u, \"iterations\": %u, \"errors\": %u, "
+	       "\"ns_per_op\": %llu, \"ops_per_sec\": %llu, \"cycles_per_op\": %llu, ",
+	       first_result ? "" : ",\n", op, (unsigned int)size, iterations, errors,
+	       (unsigned long long)ns_per_op, (unsigned long long)ops_per_sec,
+	       (unsigned long long)cycles_per_op);
+	if (size) {
+		uint64_t cycles_per_byte_x100 = cycles_per_op * 100 / size;
+
+		printk("\"cycles_per_byte\": %llu.%02u}",
+		       (unsigned long long)(cycles_per_byte_x100 / 100),
+		       (unsigned int)(cycles_per_byte_x100 % 100));
+	} else {
+		printk("\"cycles_per_byte\": null}");
+	}
+	first_result = false;
+}
+
+static void bench_run(const char *op, size_t size, uint32_t iterations, bench_op_t fn,
+		      void *params)
+{
+	uint32_t errors = 0;
+	bench_time_t start;
+	bench_time_t end;
+
+	/* Warm up, so the key caches are filled as in the steady state. */
+	(void)fn(params);
+
+	start = bench_clock_get();
+	for (uint32_t i = 0; i < iterations; i++) {
+		if (SID_ERROR_NONE != fn(params)) {
+			errors++;
+		}
+	}
+	end = bench_clock_get();
+
+	bench_report(op, size, iterations, errors, bench_clock_elapsed_ns(start, end));
+}
+
+static sid_error_t op_hash(void *params)
+{
+	return sid_pal_crypto_hash(params);
+}
+
+static sid_error_t op_hmac(void *params)
+{
+	return sid_pal_crypto_hmac(params);
+}
+
+static sid_error_t op_aes(void *params)
+{
+	return sid_pal_crypto_aes_crypt(params);
+}
+
+static sid_error_t op_aead(void *params)
+{
+	return sid_pal_crypto_aead_crypt(params);
+}
+
+static sid_error_t op_dsa(void *params)
+{
+	return sid_pal_crypto_ecc_dsa(params);
+}
+
+static sid_error_t op_ecdh(void *params)
+{
+	return sid_pal_crypto_ecc_ecdh(params);
+}
+
+static sid_error_t op_key_gen(void *params)
+{
+	return sid_pal_crypto_ecc_key_gen(params);
+}
+
+static void bench_hash(size_t size)
+{
+	sid_pal_hash_params_t params = { .algo = SID_PAL_HASH_SHA256,
+					 .data = data_in,
+					 .data_size = size,
+					 .digest = digest,
+					 .digest_size = SHA256_LEN };
+
+	bench_run("sha256", size, BENCH_ITERATIONS, op_hash, &params);
+
+	params.algo = SID_PAL_HASH_SHA512;
+	params.digest_size = SHA512_LEN;
+	bench_run("sha512", size, BENCH_ITERATIONS, op_hash, &params);
+}
+
+static void bench_hmac(size_t size)
+{
+	sid_pal_hmac_params_t params = { .algo = SID_PAL_HASH_SHA256,
+					 .key = hmac_key,
+					 .key_size = sizeof(hmac_key),
+					 .data = data_in,
+					 .data_size = size,
+					 .digest = digest,
+					 .digest_size = SHA256_LEN };
+
+	bench_run("hmac_sha256", size, BENCH_ITERATIONS, op_hmac, &params);
+}
+
+static void bench_aes(size_t size)
+{
+	sid_pal_aes_params_t params = { .algo = SID_PAL_AES_CTR_128,
+					.mode = SID_PAL_CRYPTO_ENCRYPT,
+					.key = aes_key,
+					.key_size = sizeof(aes_key) * 8,
+					.iv = iv,
+					.iv_size = sizeof(iv),
+					.in = data_in,
+					.in_size = size,
+					.out = data_out,
+					.out_size = size };
+
+	bench_run("aes_ctr", size, BENCH_ITERATIONS, op_aes, &params);
+
+	params.algo = SID_PAL_AES_CMAC_128;
+	params.mode = SID_PAL_CRYPTO_MAC_CALCULATE;
+	params.out = mac;
+	params.out_size = sizeof(mac);
+	bench_run("aes_cmac", size, BENCH_ITERATIONS, op_aes, &params);
+}
+
+static void bench_aead(size_t size)
+{
+	sid_pal_aead_params_t params = { .algo = SID_PAL_AEAD_GCM_128,
+					 .mode = SID_PAL_CRYPTO_ENCRYPT,
+					 .key = aes_key,
+					 .key_size = sizeof(aes_key) * 8,
+					 .iv = iv,
+					 .iv_size = AES_GCM_IV_SIZE,
+					 .aad = aad,
+					 .aad_size = sizeof(aad),
+					 .in = data_in,
+					 .in_size = size,
+					 .out = data_out,
+					 .out_size = size,
+					 .mac = mac,
+					 .mac_size = sizeof(mac) };
+
+	bench_run("aes_gcm", size, BENCH_ITERATIONS, op_aead, &params);
+
+	params.algo = SID_PAL_AEAD_CCM_128;
+	params.iv_size = AES_CCM_IV_SIZE;
+	bench_run("aes_ccm", size, BENCH_ITERATIONS, op_aead, &params);
+
+	params.algo = SID_PAL_AEAD_CCM_STAR_128;
+	params.mac_size = CCM_STAR_MIC_SIZE;
+	bench_run("aes_ccm_star", size, BENCH_ITERATIONS, op_aead, &params);
+
+	/* MIC-only: the whole frame is authenticated header. */
+	params.aad = data_in;
+	params.aad_size = size;
+	params.in = NULL;
+	params.in_size = 0;
+	params.out = NULL;
+	params.out_size = 0;
+	bench_run("aes_ccm_star_mic", size, BENCH_ITERATIONS, op_aead, &params);
+}
+
+static void bench_dsa(const char *sign_name, const char *verify_name, sid_pal_ecc_algo_t algo)
+{
+	uint8_t prk[EC_PRIV_KEY_LEN];
+	uint8_t puk[EC_PUB_KEY_MAX_LEN];
+	uint8_t signature[EC_SIGNATURE_SIZE];
+	size_t puk_size = (SID_PAL_EDDSA_ED25519 == algo) ? 32 : EC_PUB_KEY_MAX_LEN;
+	sid_pal_ecc_key_gen_params_t key_params = {
+		.algo = algo, .prk = prk, .prk_size = sizeof(prk), .puk = puk, .puk_size = puk_size
+	};
+	sid_pal_dsa_params_t params = { .algo = algo,
+					.mode = SID_PAL_CRYPTO_SIGN,
+					.key = prk,
+					.key_size = sizeof(prk),
+					.in = data_in,
+					.in_size = BENCH_SIGN_DATA_SIZE,
+					.signature = signature,
+					.sig_size = sizeof(signature) };
+
+	if (SID_ERROR_NONE != sid_pal_crypto_ecc_key_gen(&key_params)) {
+		printk("Key generation for %s failed\n", sign_name);
+		return;
+	}
+
+	bench_run(sign_name, BENCH_SIGN_DATA_SIZE, BENCH_ECC_ITERATIONS, op_dsa, &params);
+
+	params.mode = SID_PAL_CRYPTO_VERIFY;
+	params.key = puk;
+	params.key_size = puk_size;
+	bench_run(verify_name, BENCH_SIGN_DATA_SIZE, BENCH_ECC_ITERATIONS, op_dsa, &params);
+}
+
+static void bench_ecdh(const char *name, sid_pal_ecc_algo_t algo)
+{
+	uint8_t prk[EC_PRIV_KEY_LEN];
+	uint8_t puk[EC_PUB_KEY_MAX_LEN];
+	uint8_t peer_prk[EC_PRIV_KEY_LEN];
+	uint8_t peer_puk[EC_PUB_KEY_MAX_LEN];
+	uint8_t secret[ECDH_SECRET_SIZE];
+	size_t puk_size = (SID_PAL_ECDH_CURVE25519 == algo) ? 32 : EC_PUB_KEY_MAX_LEN;
+	sid_pal_ecc_key_gen_params_t key_params = {
+		.algo = algo, .prk = prk, .prk_size = sizeof(prk), .puk = puk, .puk_size = puk_size
+	};
+	sid_pal_ecdh_params_t params = { .algo = algo,
+					 .prk = prk,
+					 .prk_size = sizeof(prk),
+					 .puk = peer_puk,
+					 .puk_size = puk_size,
+					 .shared_secret = secret,
+					 .shared_secret_sz = sizeof(secret) };
+	sid_error_t erc = sid_pal_crypto_ecc_key_gen(&key_params);
+
+	if (SID_ERROR_NONE == erc) {
+		key_params.prk = peer_prk;
+		key_params.puk = peer_puk;
+		erc = sid_pal_crypto_ecc_key_gen(&key_params);
+	}
+	if (SID_ERROR_NONE != erc) {
+		printk("Key generation for %s failed\n", name);
+		return;
+	}
+
+	bench_run(name, 0, BENCH_ECC_ITERATIONS, op_ecdh, &params);
+}
+
+static void bench_key_gen(const char *name, sid_pal_ecc_algo_t algo, size_t puk_size)
+{
+	uint8_t prk[EC_PRIV_KEY_LEN];
+	uint8_t puk[EC_PUB_KEY_MAX_LEN];
+	sid_pal_ecc_key_gen_params_t params = {
+		.algo = algo, .prk = prk, .prk_size = sizeof(prk), .puk = puk, .puk_size = puk_size
+	};
+
+	bench_run(name, 0, BENCH_ECC_ITERATIONS, op_key_gen, &params);
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(data_in); i++) {
+		data_in[i] = (uint8_t)i;
+	}
+	memset(iv, 0xB1, sizeof(iv));
+	memset(aad, 0xAD, sizeof(aad));
+
+	bench_clock_init();
+
+	if (SID_ERROR_NONE != sid_pal_crypto_init()) {
+		printk("Crypto init failed\n");
+		return 0;
+	}
+
+	printk("{\"benchmark\": \"sid_pal_crypto\", \"board\": \"%s\", \"clock_hz\": %llu, "
+	       "\"results\": [\n",
+	       CONFIG_BOARD, (unsigned long long)bench_clock_hz());
+
+	for (size_t i = 0; i < ARRAY_SIZE(data_sizes); i++) {
+		bench_hash(data_sizes[i]);
+		bench_hmac(data_sizes[i]);
+		bench_aes(data_sizes[i]);
+		bench_aead(data_sizes[i]);
+	}
+
+	bench_key_gen("key_gen_ed25519", SID_PAL_EDDSA_ED25519, 32);
+	bench_key_gen("key_gen_x25519", SID_PAL_ECDH_CURVE25519, 32);
+	bench_key_gen("key_gen_secp256r1", SID_PAL_ECDSA_SECP256R1, EC_PUB_KEY_MAX_LEN);
+
+	bench_dsa("sign_ed25519", "verify_ed25519", SID_PAL_EDDSA_ED25519);
+	bench_dsa("sign_secp256r1", "verify_secp256r1", SID_PAL_ECDSA_SECP256R1);
+
+	bench_ecdh("ecdh_x25519", SID_PAL_ECDH_CURVE25519);
+	bench_ecdh("ecdh_secp256r1", SID_PAL_ECDH_SECP256R1);
+
+	printk("\n]}\n");
+
+	sid_pal_crypto_deinit();
+
+	return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <sid_hal_memory_ifc.h>
+#include <sid_hal_memory_slab.h>
+#include <alloc_trace.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/sys_heap.h>
+
+#if defined(CONFIG_ARCH_POSIX)
+#include <native_rtc.h>
+#else
+#include <zephyr/timing/timing.h>
+#endif /* CONFIG_ARCH_POSIX */
+
+#define BENCH_ITERATIONS (CONFIG_HAL_MEMORY_BENCHMARK_ITERATIONS)
+#define TRACE_ITERATIONS (BENCH_ITERATIONS / ARRAY_SIZE(alloc_trace) + 1)
+
+/* Same capacity as the slab classes. */
+#define HEAP_SIZE                                                                                  \
+	(16 * CONFIG_SIDEWALK_HAL_MEMORY_SLAB_16_BLOCKS +                                          \
+	 32 * CONFIG_SIDEWALK_HAL_MEMORY_SLAB_32_BLOCKS +                                          \
+	 64 * CONFIG_SIDEWALK_HAL_MEMORY_SLAB_64_BLOCKS +                                          \
+	 128 * CONFIG_SIDEWALK_HAL_MEMORY_SLAB_128_BLOCKS +                                        \
+	 256 * CONFIG_SIDEWALK_HAL_MEMORY_SLAB_256_BLOCKS)
+
+struct bench_allocator {
+	const char *name;
+	void *(*alloc)(size_t size);
+	void (*free)(void *ptr);
+};
+
+static const size_t alloc_sizes[] = { 16, 64, 256 };
+
+static uint8_t heap_mem[HEAP_SIZE] __aligned(8);
+static struct sys_heap heap;
+static void *slots[ALLOC_TRACE_SLOTS];
+static bool first_result = true;
+
+#if defined(CONFIG_ARCH_POSIX)
+/* Simulated time does not advance during the computation, so the host clock is used. */
+typedef uint64_t bench_time_t;
+
+static void bench_clock_init(void)
+{
+}
+
+static bench_time_t bench_clock_get(void)
+{
+	return native_rtc_gettime_us(RTC_CLOCK_REAL);
+}
+
+static uint64_t bench_clock_elapsed_ns(bench_time_t start, bench_time_t end)
+{
+	return (end - start) * NSEC_PER_USEC;
+}
+#else
+typedef timing_t bench_time_t;
+
+static void bench_clock_init(void)
+{
+	timing_init();
+	timing_start();
+}
+
+static bench_time_t bench_clock_get(void)
+{
+	return timing_counter_get();
+}
+
+static uint64_t bench_clock_elapsed_ns(bench_time_t start, bench_time_t end)
+{
+	return timing_cycles_to_ns(timing_cycles_get(&start, &end));
+}
+#endif /* CONFIG_ARCH_POSIX */
+
+/* Baseline: one heap guarded by the interrupt lock, as the memory pool path. */
+static void *heap_alloc(size_t size)
+{
+	unsigned int key = irq_lock();
+	void *ptr = sys_heap_alloc(&heap, size);
+
+	irq_unlock(key);
+
+	return ptr;
+}
+
+static void heap_free(void *ptr)
+{
+	unsigned int key = irq_lock();
+
+	sys_heap_free(&heap, ptr);
+	irq_unlock(key);
+}
+
+static const struct bench_allocator allocators[] = {
+	{ .name = "slab", .alloc = sid_hal_malloc, .free = sid_hal_free },
+	{ .name = "heap", .alloc = heap_alloc, .free = heap_free },
+};
+
+static void bench_report(const char *allocator, const char *pattern, size_t size, uint32_t ops,
+			 uint32_t errors, uint64_t elapsed_ns)
+{
+	printk("%s  {\"allocator\": \"%s\", \"pattern\": \"%s\", \"size\": %u, \"ops\": %u, "
+	       "\"errors\": %u, \"ns_per_op\": %llu}",
+	       first_result ? "" : ",\n", allocator, pattern, (unsigned int)size, ops, errors,
+	       (unsigned long long)(elapsed_ns / ops));
+	first_result = false;
+}
+
+/* Allocation immediately followed by free, the cost of the hot path. */
+static void bench_pair(const struct bench_allocator *allocator, size_t size)
+{
+	uint32_t errors = 0;
+	bench_time_t start;
+	bench_time_t end;
+
+	start = bench_clock_get();
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		void *ptr = allocator->alloc(size);
+
+		if (!ptr) {
+			errors++;
+			continue;
+		}
+		allocator->free(ptr);
+	}
+	end = bench_clock_get();
+
+	bench_report(allocator->name, "pair", size, 2 * BENCH_ITERATIONS, errors,
+		     bench_clock_elapsed_ns(start, end));
+}
+
+/* Replay of the protocol allocation trace, failed allocations show fragmentation. */
+static void bench_trace(const struct bench_allocator *allocator)
+{
+	uint32_t errors = 0;
+	bench_time_t start;
+	bench_time_t end;
+
+	start = bench_clock_get();
+	for (uint32_t round = 0; round < TRACE_ITERATIONS; round++) {
+		for (size_t i = 0; i < ARRAY_SIZE(alloc_trace); i++) {
+			const struct alloc_trace_event *event = &alloc_trace[i];
+
+			if (event->size) {
+				slots[event->slot] = allocator->alloc(event->size);
+				if (!slots[event->slot]) {
+					errors++;
+				}
+			} else if (slots[event->slot]) {
+				allocator->free(slots[event->slot]);
+				slots[event->slot] = NULL;
+			}
+		}
+	}
+	end = bench_clock_get();
+
+	bench_report(allocator->name, "trace", 0, TRACE_ITERATIONS * ARRAY_SIZE(alloc_trace),
+		     errors, bench_clock_elapsed_ns(start, end));
+}
+
+int main(void)
+{
+	sys_heap_init(&heap, heap_mem, sizeof(heap_mem));
+	bench_clock_init();
+
+	printk("{\"benchmark\": \"sid_hal_memory\", \"board\": \"%s\", \"results\": [\n",
+	       CONFIG_BOARD);
+
+	for (size_t i = 0; i < ARRAY_SIZE(allocators); i++) {
+		for (size_t j = 0; j < ARRAY_SIZE(alloc_sizes); j++) {
+			bench_pair(&allocators[i], alloc_sizes[j]);
+		}
+		bench_trace(&allocators[i]);
+	}
+
+	printk("\n]}\n");
+
+	return 0;
+}
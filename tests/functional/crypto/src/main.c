@@ -1510,6 +1510,117 @@ ZTEST(crypto, test_sid_pal_crypto_aead_ccm_external_encrypted_data)
 	}
 }
 
+ZTEST(crypto, test_sid_pal_crypto_aead_ccm_star_mic_only)
+{
+	sid_pal_aead_params_t params;
+	// IEEE 802.15.4-2011 Annex C.2.1, beacon frame with MIC-64 security level.
+	uint8_t key[AES_MAX_BLOCK_SIZE] = { 0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7,
+					    0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF };
+	uint8_t nonce[AES_CCM_IV_SIZE] = { 0xAC, 0xDE, 0x48, 0x00, 0x00, 0x00, 0x00,
+					   0x01, 0x00, 0x00, 0x00, 0x05, 0x02 };
+	uint8_t header[] = { 0x08, 0xD0, 0x84, 0x21, 0x43, 0x01, 0x00, 0x00, 0x00,
+			     0x00, 0x48, 0xDE, 0xAC, 0x02, 0x05, 0x00, 0x00, 0x00,
+			     0x55, 0xCF, 0x00, 0x00, 0x51, 0x52, 0x53, 0x54 };
+	uint8_t expected_mic[] = { 0x22, 0x3B, 0xC1, 0xEC, 0x84, 0x1A, 0xB5, 0x53 };
+	uint8_t mic[sizeof(expected_mic)];
+
+	memset(&params, 0x00, sizeof(params));
+	memset(mic, 0x00, sizeof(mic));
+
+	// Initialize crypto module
+	zassert_equal(SID_ERROR_NONE, sid_pal_crypto_init());
+
+	params.algo = SID_PAL_AEAD_CCM_STAR_128;
+	params.mode = SID_PAL_CRYPTO_ENCRYPT;
+	params.key = key;
+	params.key_size = sizeof(key) * 8;
+	params.iv = nonce;
+	params.iv_size = sizeof(nonce);
+	params.aad = header;
+	params.aad_size = sizeof(header);
+	params.mac = mic;
+	params.mac_size = sizeof(mic);
+
+	zassert_equal(SID_ERROR_NONE, sid_pal_crypto_aead_crypt(&params));
+	zassert_equal(0, memcmp(expected_mic, mic, sizeof(mic)));
+
+	params.mode = SID_PAL_CRYPTO_DECRYPT;
+	zassert_equal(SID_ERROR_NONE, sid_pal_crypto_aead_crypt(&params));
+
+	// Modified header shall be rejected
+	header[0] ^= 0x01;
+	zassert_not_equal(SID_ERROR_NONE, sid_pal_crypto_aead_crypt(&params));
+}
+
+ZTEST(crypto, test_sid_pal_crypto_aead_ccm_star_encrypt_mic)
+{
+	sid_pal_aead_params_t params;
+	// Key, nonce, header and payload from IEEE 802.15.4-2011 Annex C.2.2 data frame,
+	// secured with ENC-MIC-32, ENC-MIC-64 and ENC-MIC-128 security levels.
+	uint8_t key[AES_MAX_BLOCK_SIZE] = { 0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7,
+					    0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF };
+	uint8_t nonce[AES_CCM_IV_SIZE] = { 0xAC, 0xDE, 0x48, 0x00, 0x00, 0x00, 0x00,
+					   0x01, 0x00, 0x00, 0x00, 0x05, 0x04 };
+	uint8_t header[] = { 0x69, 0xDC, 0x84, 0x21, 0x43, 0x02, 0x00, 0x00, 0x00,
+			     0x00, 0x48, 0xDE, 0xAC, 0x01, 0x00, 0x00, 0x00, 0x00,
+			     0x48, 0xDE, 0xAC, 0x04, 0x05, 0x00, 0x00, 0x00 };
+	uint8_t payload[] = { 0x61, 0x62, 0x63, 0x64 };
+	uint8_t expected_payload[] = { 0xD4, 0x3E, 0x02, 0x2B };
+	size_t mic_len_test_vector[] = { 4, 8, 16 };
+	uint8_t expected_mic_vector[][AES_MAX_BLOCK_SIZE] = {
+		{ 0x56, 0x78, 0x8B, 0xC7 },
+		{ 0xAB, 0x1F, 0xF9, 0x30, 0x43, 0x8A, 0x63, 0xED },
+		{ 0xD2, 0x6C, 0xC3, 0xC4, 0x44, 0x15, 0x63, 0x1F, 0xB0, 0xFB, 0xA5, 0xDE, 0x99,
+		  0x37, 0x6F, 0x1B },
+	};
+	uint8_t encrypted_data[sizeof(payload)];
+	uint8_t decrypted_data[sizeof(payload)];
+	uint8_t mic[AES_MAX_BLOCK_SIZE];
+
+	memset(&params, 0x00, sizeof(params));
+
+	// Initialize crypto module
+	zassert_equal(SID_ERROR_NONE, sid_pal_crypto_init());
+
+	params.algo = SID_PAL_AEAD_CCM_STAR_128;
+	params.key = key;
+	params.key_size = sizeof(key) * 8;
+	params.iv = nonce;
+	params.iv_size = sizeof(nonce);
+	params.aad = header;
+	params.aad_size = sizeof(header);
+	params.mac = mic;
+
+	for (int test_it = 0; test_it < ARRAY_SIZE(mic_len_test_vector); test_it++) {
+		memset(encrypted_data, 0x00, sizeof(encrypted_data));
+		memset(decrypted_data, 0x00, sizeof(decrypted_data));
+		memset(mic, 0x00, sizeof(mic));
+
+		params.mode = SID_PAL_CRYPTO_ENCRYPT;
+		params.in = payload;
+		params.in_size = sizeof(payload);
+		params.out = encrypted_data;
+		params.out_size = sizeof(encrypted_data);
+		params.mac_size = mic_len_test_vector[test_it];
+
+		zassert_equal(SID_ERROR_NONE, sid_pal_crypto_aead_crypt(&params));
+		zassert_equal(0, memcmp(expected_payload, encrypted_data, sizeof(encrypted_data)));
+		zassert_equal(0, memcmp(expected_mic_vector[test_it], mic, params.mac_size));
+
+		params.mode = SID_PAL_CRYPTO_DECRYPT;
+		params.in = encrypted_data;
+		params.out = decrypted_data;
+		params.out_size = sizeof(decrypted_data);
+
+		zassert_equal(SID_ERROR_NONE, sid_pal_crypto_aead_crypt(&params));
+		zassert_equal(0, memcmp(payload, decrypted_data, sizeof(payload)));
+	}
+
+	// Encryption-only security level is not supported
+	params.mac_size = 0;
+	zassert_equal(SID_ERROR_INVALID_ARGS, sid_pal_crypto_aead_crypt(&params));
+}
+
 ZTEST(crypto, test_sid_pal_crypto_aead_ccm_bad_key)
 {
 	sid_pal_aead_params_t params;
@@ -0,0 +1,8 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define CONFIG_SIDEWALK_ALLOC_TRACE 1
+#define CONFIG_SIDEWALK_ALLOC_TRACE_RECORDS 4
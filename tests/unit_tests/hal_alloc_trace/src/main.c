@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include "kconfig_mock.h"
+
+#include <sid_alloc_trace.h>
+
+#include <zephyr/sys/util.h>
+
+static uint8_t blocks[8][16];
+
+void setUp(void)
+{
+	sid_alloc_trace_reset();
+}
+
+/******************************************************************
+* sid_alloc_trace
+* ****************************************************************/
+
+void test_alloc_trace_records(void)
+{
+	struct sid_alloc_trace_record records[CONFIG_SIDEWALK_ALLOC_TRACE_RECORDS];
+
+	sid_alloc_trace_alloc(SID_ALLOC_TRACE_POOL_HAL, blocks[0], 12);
+	sid_alloc_trace_alloc(SID_ALLOC_TRACE_POOL_ACE_NETWORK, NULL, 300);
+	sid_alloc_trace_free(SID_ALLOC_TRACE_POOL_HAL, blocks[0]);
+	sid_alloc_trace_free(SID_ALLOC_TRACE_POOL_HAL, NULL);
+
+	TEST_ASSERT_EQUAL(3, sid_alloc_trace_read(records, ARRAY_SIZE(records)));
+	TEST_ASSERT_EQUAL(0, records[0].seq);
+	TEST_ASSERT_EQUAL(SID_ALLOC_TRACE_OP_ALLOC, records[0].op);
+	TEST_ASSERT_EQUAL(SID_ALLOC_TRACE_POOL_HAL, records[0].pool);
+	TEST_ASSERT_EQUAL((uint32_t)(uintptr_t)blocks[0], records[0].ptr);
+	TEST_ASSERT_EQUAL(12, records[0].size);
+
+	/* Failed allocation. */
+	TEST_ASSERT_EQUAL(SID_ALLOC_TRACE_POOL_ACE_NETWORK, records[1].pool);
+	TEST_ASSERT_EQUAL(0, records[1].ptr);
+	TEST_ASSERT_EQUAL(300, records[1].size);
+
+	TEST_ASSERT_EQUAL(SID_ALLOC_TRACE_OP_FREE, records[2].op);
+	TEST_ASSERT_EQUAL(records[0].ptr, records[2].ptr);
+	TEST_ASSERT_EQUAL(2, records[2].seq);
+
+	TEST_ASSERT_EQUAL(0, sid_alloc_trace_read(records, ARRAY_SIZE(records)));
+}
+
+void test_alloc_trace_overwrite_oldest(void)
+{
+	struct sid_alloc_trace_record records[ARRAY_SIZE(blocks)];
+	size_t read;
+
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		sid_alloc_trace_alloc(SID_ALLOC_TRACE_POOL_HAL, blocks[i], i + 1);
+	}
+
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(blocks) - CONFIG_SIDEWALK_ALLOC_TRACE_RECORDS,
+			  sid_alloc_trace_dropped());
+
+	/* Read in two parts, the sequence numbers show the gap. */
+	read = sid_alloc_trace_read(records, 1);
+	read += sid_alloc_trace_read(&records[1], ARRAY_SIZE(records) - 1);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_ALLOC_TRACE_RECORDS, read);
+	for (size_t i = 0; i < read; i++) {
+		size_t expected = ARRAY_SIZE(blocks) - CONFIG_SIDEWALK_ALLOC_TRACE_RECORDS + i;
+
+		TEST_ASSERT_EQUAL(expected, records[i].seq);
+		TEST_ASSERT_EQUAL(expected + 1, records[i].size);
+	}
+}
+
+void test_alloc_trace_reset(void)
+{
+	struct sid_alloc_trace_record record;
+
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		sid_alloc_trace_free(SID_ALLOC_TRACE_POOL_ACE_GENERIC, blocks[i]);
+	}
+	sid_alloc_trace_reset();
+
+	TEST_ASSERT_EQUAL(0, sid_alloc_trace_dropped());
+	TEST_ASSERT_EQUAL(0, sid_alloc_trace_read(&record, 1));
+
+	sid_alloc_trace_alloc(SID_ALLOC_TRACE_POOL_HAL, blocks[0], 1);
+	TEST_ASSERT_EQUAL(1, sid_alloc_trace_read(&record, 1));
+	TEST_ASSERT_EQUAL(0, record.seq);
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Allocation sequence modelled on a Bluetooth low energy connection: long-lived protocol
+ * state is allocated first, then receive descriptors, frames, transmit messages and
+ * timer contexts are allocated and released out of order.
+ */
+
+#ifndef ALLOC_TRACE_H
+#define ALLOC_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ALLOC_TRACE_SLOTS (24)
+
+struct alloc_trace_event {
+	uint8_t slot;
+	/* Zero for free. */
+	uint16_t size;
+};
+
+#define ALLOC(_slot, _size) { .slot = (_slot), .size = (_size) }
+#define FREE(_slot) { .slot = (_slot), .size = 0 }
+
+static const struct alloc_trace_event alloc_trace[] = {
+	ALLOC(0, 200), ALLOC(1, 96), ALLOC(2, 48), ALLOC(3, 48),
+	ALLOC(4, 24), ALLOC(5, 12), ALLOC(6, 120), ALLOC(7, 32),
+	FREE(7), ALLOC(8, 32), FREE(8), FREE(6),
+	ALLOC(9, 32), FREE(9), ALLOC(10, 8), FREE(10),
+	ALLOC(11, 40), ALLOC(12, 24), FREE(12), ALLOC(13, 60),
+	ALLOC(14, 24), FREE(14), FREE(11), ALLOC(15, 8),
+	ALLOC(16, 27), FREE(15), ALLOC(17, 80), ALLOC(18, 16),
+	ALLOC(19, 100), FREE(18), FREE(19), FREE(13),
+	ALLOC(20, 16), ALLOC(21, 19), FREE(20), FREE(17),
+	ALLOC(22, 40), ALLOC(23, 24), FREE(23), ALLOC(7, 16),
+	FREE(7), ALLOC(8, 16), ALLOC(6, 19), FREE(8),
+	FREE(22), ALLOC(9, 8), FREE(9), ALLOC(10, 80),
+	FREE(6), FREE(16), FREE(10), FREE(21),
+	ALLOC(12, 40), ALLOC(14, 24), FREE(14), ALLOC(11, 8),
+	ALLOC(15, 64), FREE(11), FREE(12), FREE(15),
+	ALLOC(18, 60), ALLOC(19, 24), FREE(19), ALLOC(13, 12),
+	ALLOC(20, 100), FREE(13), ALLOC(17, 16), ALLOC(23, 64),
+	FREE(17), ALLOC(7, 8), ALLOC(8, 100), FREE(7),
+	FREE(8), ALLOC(22, 64), FREE(18), ALLOC(9, 60),
+	ALLOC(6, 24), FREE(6), FREE(20), FREE(23),
+	ALLOC(16, 60), ALLOC(10, 24), FREE(10), FREE(16),
+	ALLOC(21, 8), FREE(21), FREE(9), ALLOC(14, 32),
+	FREE(14), FREE(22), ALLOC(11, 32), FREE(11),
+	ALLOC(12, 12), ALLOC(15, 64), FREE(12), FREE(15),
+	ALLOC(19, 16), FREE(19), ALLOC(13, 40), ALLOC(17, 24),
+	FREE(17), ALLOC(7, 8), ALLOC(8, 27), FREE(7),
+	ALLOC(18, 19), ALLOC(6, 24), FREE(6), ALLOC(20, 19),
+	ALLOC(23, 24), FREE(23), FREE(8), ALLOC(10, 120),
+	FREE(20), ALLOC(16, 16), ALLOC(21, 27), FREE(16),
+	FREE(13), ALLOC(9, 19), ALLOC(14, 24), FREE(14),
+	FREE(18), ALLOC(22, 64), FREE(22), ALLOC(11, 32),
+	FREE(11), FREE(10), ALLOC(12, 16), ALLOC(15, 100),
+	FREE(12), FREE(9), FREE(21), FREE(15),
+	FREE(0), FREE(1), FREE(2), FREE(3),
+	FREE(4), FREE(5),
+};
+
+#undef ALLOC
+#undef FREE
+
+#endif /* ALLOC_TRACE_H */
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define CONFIG_SIDEWALK_LOG_LEVEL 4
+#define CONFIG_SIDEWALK_HAL_MEMORY_SLAB_16_BLOCKS 16
+#define CONFIG_SIDEWALK_HAL_MEMORY_SLAB_32_BLOCKS 12
+#define CONFIG_SIDEWALK_HAL_MEMORY_SLAB_64_BLOCKS 8
+#define CONFIG_SIDEWALK_HAL_MEMORY_SLAB_128_BLOCKS 4
+#define CONFIG_SIDEWALK_HAL_MEMORY_SLAB_256_BLOCKS 2
+#define CONFIG_SIDEWALK_HAL_MEMORY_SLAB_FALLBACK_SIZE 1024
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <zephyr/fff.h>
+#include "kconfig_mock.h"
+#include "alloc_trace.h"
+
+#include <sid_hal_memory_ifc.h>
+#include <sid_hal_memory_slab.h>
+#include <sid_memory_pool.h>
+#include <sid_memory_stats.h>
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/util.h>
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VOID_FUNC(sid_pal_enter_critical_region);
+FAKE_VOID_FUNC(sid_pal_exit_critical_region);
+
+#define FFF_FAKES_LIST(FAKE)                                                                       \
+	FAKE(sid_pal_enter_critical_region)                                                        \
+	FAKE(sid_pal_exit_critical_region)
+
+#define CLASS_16 (0)
+#define CLASS_32 (1)
+#define CLASS_256 (4)
+
+/* Fallback pool backed by the system heap, the Sidewalk pool is not available on the host. */
+struct sid_memory_pool {
+	struct sys_heap heap;
+};
+
+static struct sid_memory_pool pool;
+
+sid_error_t sid_memory_pool_init(struct sid_memory_pool **memory_pool,
+				 const struct sid_memory_pool_config *const config)
+{
+	sys_heap_init(&pool.heap, config->buffer, config->size);
+	*memory_pool = &pool;
+	return SID_ERROR_NONE;
+}
+
+void *sid_memory_pool_allocate(struct sid_memory_pool *const memory_pool, size_t size)
+{
+	return sys_heap_alloc(&memory_pool->heap, size);
+}
+
+void sid_memory_pool_free(struct sid_memory_pool *const memory_pool, void *const buffer)
+{
+	sys_heap_free(&memory_pool->heap, buffer);
+}
+
+static struct sid_hal_memory_slab_stats stats_get(size_t index)
+{
+	struct sid_hal_memory_slab_stats stats;
+
+	TEST_ASSERT_EQUAL(0, sid_hal_memory_slab_stats_get(index, &stats));
+	return stats;
+}
+
+static void assert_all_free(void)
+{
+	for (size_t i = 0; i < SID_HAL_MEMORY_SLAB_CLASSES; i++) {
+		TEST_ASSERT_EQUAL(0, stats_get(i).used);
+	}
+}
+
+void setUp(void)
+{
+	FFF_FAKES_LIST(RESET_FAKE);
+	FFF_RESET_HISTORY();
+}
+
+void tearDown(void)
+{
+	assert_all_free();
+}
+
+/******************************************************************
+* sid_hal_malloc
+* ****************************************************************/
+
+void test_memory_slab_class_selection(void)
+{
+	const size_t sizes[] = { 1, 16, 17, 32, 33, 64, 65, 128, 129, 256 };
+	const size_t expected[] = { 0, 0, 1, 1, 2, 2, 3, 3, 4, 4 };
+	void *ptr[ARRAY_SIZE(sizes)];
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		uint32_t used = stats_get(expected[i]).used;
+
+		ptr[i] = sid_hal_malloc(sizes[i]);
+		TEST_ASSERT_NOT_NULL(ptr[i]);
+		TEST_ASSERT_EQUAL(0, (uintptr_t)ptr[i] % 8);
+		memset(ptr[i], 0xA5, sizes[i]);
+		TEST_ASSERT_EQUAL(used + 1, stats_get(expected[i]).used);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		sid_hal_free(ptr[i]);
+	}
+
+	/* Slab classes do not use the critical region. */
+	TEST_ASSERT_EQUAL(0, sid_pal_enter_critical_region_fake.call_count);
+}
+
+void test_memory_slab_spill_and_exhaust(void)
+{
+	void *small[CONFIG_SIDEWALK_HAL_MEMORY_SLAB_16_BLOCKS];
+	void *large[CONFIG_SIDEWALK_HAL_MEMORY_SLAB_256_BLOCKS];
+	uint32_t spilled_cnt = stats_get(CLASS_16).spilled;
+	uint32_t failed_cnt = stats_get(CLASS_256).failed;
+	void *spilled;
+
+	for (size_t i = 0; i < ARRAY_SIZE(small); i++) {
+		small[i] = sid_hal_malloc(16);
+		TEST_ASSERT_NOT_NULL(small[i]);
+	}
+
+	spilled = sid_hal_malloc(16);
+	TEST_ASSERT_NOT_NULL(spilled);
+	TEST_ASSERT_EQUAL(spilled_cnt + 1, stats_get(CLASS_16).spilled);
+	TEST_ASSERT_EQUAL(1, stats_get(CLASS_32).used);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_HAL_MEMORY_SLAB_16_BLOCKS, stats_get(CLASS_16).peak);
+
+	for (size_t i = 0; i < ARRAY_SIZE(large); i++) {
+		large[i] = sid_hal_malloc(256);
+		TEST_ASSERT_NOT_NULL(large[i]);
+	}
+	TEST_ASSERT_NULL(sid_hal_malloc(256));
+	TEST_ASSERT_EQUAL(failed_cnt + 1, stats_get(CLASS_256).failed);
+
+	sid_hal_free(spilled);
+	for (size_t i = 0; i < ARRAY_SIZE(small); i++) {
+		sid_hal_free(small[i]);
+	}
+	for (size_t i = 0; i < ARRAY_SIZE(large); i++) {
+		sid_hal_free(large[i]);
+	}
+}
+
+void test_memory_slab_fallback(void)
+{
+	uint32_t count = sid_hal_memory_slab_fallback_count();
+	void *ptr = sid_hal_malloc(300);
+
+	TEST_ASSERT_NOT_NULL(ptr);
+	TEST_ASSERT_EQUAL(count + 1, sid_hal_memory_slab_fallback_count());
+	sid_hal_free(ptr);
+	TEST_ASSERT_EQUAL(2, sid_pal_enter_critical_region_fake.call_count);
+	TEST_ASSERT_EQUAL(2, sid_pal_exit_critical_region_fake.call_count);
+
+	TEST_ASSERT_NULL(sid_hal_malloc(CONFIG_SIDEWALK_HAL_MEMORY_SLAB_FALLBACK_SIZE));
+	sid_hal_free(NULL);
+}
+
+void test_memory_slab_invalid_args(void)
+{
+	struct sid_hal_memory_slab_stats stats;
+
+	TEST_ASSERT_EQUAL(-EINVAL,
+			  sid_hal_memory_slab_stats_get(SID_HAL_MEMORY_SLAB_CLASSES, &stats));
+	TEST_ASSERT_EQUAL(-EINVAL, sid_hal_memory_slab_stats_get(0, NULL));
+}
+
+void test_memory_slab_memory_stats(void)
+{
+	struct sid_memory_stats before;
+	struct sid_memory_stats stats;
+	void *small;
+	void *large;
+
+	TEST_ASSERT_EQUAL(0, sid_hal_memory_stats_get(&before));
+	TEST_ASSERT_EQUAL(2176 + CONFIG_SIDEWALK_HAL_MEMORY_SLAB_FALLBACK_SIZE, before.size);
+	TEST_ASSERT_EQUAL(0, before.current_bytes);
+
+	small = sid_hal_malloc(17);
+	large = sid_hal_malloc(300);
+	TEST_ASSERT_NOT_NULL(small);
+	TEST_ASSERT_NOT_NULL(large);
+
+	TEST_ASSERT_EQUAL(0, sid_hal_memory_stats_get(&stats));
+	/* Class block size, fallback request with its size header. */
+	TEST_ASSERT_EQUAL(32 + 300 + 8, stats.current_bytes);
+	TEST_ASSERT_GREATER_OR_EQUAL(stats.current_bytes, stats.peak_bytes);
+	TEST_ASSERT_EQUAL(before.alloc_count + 2, stats.alloc_count);
+	TEST_ASSERT_LESS_THAN(before.largest_free, stats.largest_free);
+	TEST_ASSERT_GREATER_OR_EQUAL(256, stats.largest_free);
+
+	sid_hal_free(small);
+	sid_hal_free(large);
+	RESET_FAKE(sid_pal_enter_critical_region);
+	RESET_FAKE(sid_pal_exit_critical_region);
+	TEST_ASSERT_EQUAL(0, sid_hal_memory_stats_get(&stats));
+	/* The fallback pool is probed in a single critical region. */
+	TEST_ASSERT_EQUAL(1, sid_pal_enter_critical_region_fake.call_count);
+	TEST_ASSERT_EQUAL(1, sid_pal_exit_critical_region_fake.call_count);
+	TEST_ASSERT_EQUAL(0, stats.current_bytes);
+	TEST_ASSERT_EQUAL(before.largest_free, stats.largest_free);
+
+	TEST_ASSERT_EQUAL(-EINVAL, sid_hal_memory_stats_get(NULL));
+}
+
+void test_memory_slab_trace_replay(void)
+{
+	void *slots[ALLOC_TRACE_SLOTS] = { 0 };
+	uint32_t failed[SID_HAL_MEMORY_SLAB_CLASSES];
+	uint32_t peak[SID_HAL_MEMORY_SLAB_CLASSES];
+	size_t requested = 0;
+	size_t reserved = 0;
+
+	for (size_t i = 0; i < SID_HAL_MEMORY_SLAB_CLASSES; i++) {
+		failed[i] = stats_get(i).failed;
+	}
+
+	/* Replayed several times, a fragmenting allocator would fail in later rounds. */
+	for (int round = 0; round < 3; round++) {
+		for (size_t i = 0; i < ARRAY_SIZE(alloc_trace); i++) {
+			const struct alloc_trace_event *event = &alloc_trace[i];
+
+			if (event->size) {
+				TEST_ASSERT_NULL(slots[event->slot]);
+				slots[event->slot] = sid_hal_malloc(event->size);
+				TEST_ASSERT_NOT_NULL(slots[event->slot]);
+				memset(slots[event->slot], event->slot, event->size);
+				requested += event->size;
+				reserved += MAX(16, 1 << (32 - __builtin_clz(event->size - 1)));
+			} else {
+				sid_hal_free(slots[event->slot]);
+				slots[event->slot] = NULL;
+			}
+		}
+		assert_all_free();
+
+		for (size_t i = 0; i < SID_HAL_MEMORY_SLAB_CLASSES; i++) {
+			if (round == 0) {
+				peak[i] = stats_get(i).peak;
+			}
+			/* Steady state, the footprint does not grow with the replays. */
+			TEST_ASSERT_EQUAL(peak[i], stats_get(i).peak);
+			TEST_ASSERT_EQUAL(failed[i], stats_get(i).failed);
+		}
+	}
+
+	/* Internal fragmentation of the power of two classes stays below one half. */
+	TEST_ASSERT_LESS_THAN(requested, 2 * (reserved - requested));
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
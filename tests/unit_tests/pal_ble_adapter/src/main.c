@@ -144,10 +144,12 @@ void test_sid_pal_ble_adapter_init(void)
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_ble_adapter_create(&p_test_ble_ifc));
 
 	__cmock_settings_load_ExpectAndReturn(0);
+	__cmock_sid_ble_service_init_ExpectAndReturn(0);
 	__cmock_sid_ble_conn_init_Expect();
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, p_test_ble_ifc->init(&test_ble_cfg));
 
 	__cmock_settings_load_ExpectAndReturn(0);
+	__cmock_sid_ble_service_init_ExpectAndReturn(0);
 	__cmock_sid_ble_conn_init_Expect();
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, p_test_ble_ifc->init(NULL));
 
@@ -157,6 +159,10 @@ void test_sid_pal_ble_adapter_init(void)
 	bt_enable_fake.return_val = ESUCCESS;
 	__cmock_settings_load_ExpectAndReturn(-ENOENT);
 	TEST_ASSERT_EQUAL(SID_ERROR_GENERIC, p_test_ble_ifc->init(&test_ble_cfg));
+
+	__cmock_settings_load_ExpectAndReturn(0);
+	__cmock_sid_ble_service_init_ExpectAndReturn(-ENOENT);
+	TEST_ASSERT_EQUAL(SID_ERROR_GENERIC, p_test_ble_ifc->init(&test_ble_cfg));
 }
 
 void test_sid_pal_ble_adapter_deinit(void)
@@ -165,10 +171,12 @@ void test_sid_pal_ble_adapter_deinit(void)
 
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_ble_adapter_create(&p_test_ble_ifc));
 	__cmock_settings_load_ExpectAndReturn(ESUCCESS);
+	__cmock_sid_ble_service_init_ExpectAndReturn(0);
 	__cmock_sid_ble_conn_init_Expect();
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, p_test_ble_ifc->init(&test_ble_cfg));
 
 	__cmock_sid_ble_conn_deinit_Expect();
+	__cmock_sid_ble_advert_deinit_Expect();
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, p_test_ble_ifc->deinit());
 }
 
@@ -304,26 +312,42 @@ void test_ble_adapter_adapter_callback_fail(void)
 void test_ble_adapter_send_data_pass(void)
 {
 	uint8_t data[TEST_DATA_CHUNK];
-	const sid_ble_conn_params_t test_conn_params;
+	struct bt_conn test_conn;
 	sid_pal_ble_adapter_interface_t p_test_ble_ifc;
 
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_ble_adapter_create(&p_test_ble_ifc));
 
-	__cmock_sid_ble_conn_params_get_IgnoreAndReturn(&test_conn_params);
+	__cmock_sid_ble_conn_active_ref_IgnoreAndReturn(&test_conn);
 	__cmock_sid_ble_send_data_IgnoreAndReturn(0);
 
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, p_test_ble_ifc->send(AMA_SERVICE, data, sizeof(data)));
+	/* The reference taken for the send is released. */
+	TEST_ASSERT_EQUAL(1, bt_conn_unref_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(&test_conn, bt_conn_unref_fake.arg0_val);
+}
+
+void test_ble_adapter_send_data_not_connected(void)
+{
+	uint8_t data[TEST_DATA_CHUNK];
+	sid_pal_ble_adapter_interface_t p_test_ble_ifc;
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_ble_adapter_create(&p_test_ble_ifc));
+
+	__cmock_sid_ble_conn_active_ref_IgnoreAndReturn(NULL);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_GENERIC, p_test_ble_ifc->send(AMA_SERVICE, data, sizeof(data)));
+	TEST_ASSERT_EQUAL(0, bt_conn_unref_fake.call_count);
 }
 
 void test_ble_adapter_send_data_fail(void)
 {
 	uint8_t data[TEST_DATA_CHUNK];
-	const sid_ble_conn_params_t test_conn_params;
+	struct bt_conn test_conn;
 	sid_pal_ble_adapter_interface_t p_test_ble_ifc;
 
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_ble_adapter_create(&p_test_ble_ifc));
 
-	__cmock_sid_ble_conn_params_get_IgnoreAndReturn(&test_conn_params);
+	__cmock_sid_ble_conn_active_ref_IgnoreAndReturn(&test_conn);
 	__cmock_sid_ble_send_data_IgnoreAndReturn(-EINVAL);
 
 	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS,
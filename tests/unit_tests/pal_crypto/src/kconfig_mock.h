@@ -5,3 +5,7 @@
  */
 
 #define CONFIG_SIDEWALK_CRYPTO_LOG_LEVEL 0
+#define CONFIG_SIDEWALK_CRYPTO_AES_SINGLE_SHOT_MAX_LEN 64
+#define CONFIG_SIDEWALK_CRYPTO_KEY_CACHE_SIZE 2
+#define CONFIG_SIDEWALK_CRYPTO_VERIFY_KEY_CACHE_SIZE 2
+#define CONFIG_SIDEWALK_CRYPTO_STATS 1
@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <sid_pal_crypto_ifc.h>
+#include <sid_crypto_ext.h>
 #include <zephyr/sys/util.h>
 
 #include <zephyr/fff.h>
@@ -47,6 +48,8 @@ FAKE_VALUE_FUNC(psa_status_t, psa_cipher_update, psa_cipher_operation_t *, const
 		uint8_t *, size_t, size_t *);
 FAKE_VALUE_FUNC(psa_status_t, psa_cipher_finish, psa_cipher_operation_t *, uint8_t *, size_t,
 		size_t *);
+FAKE_VALUE_FUNC(psa_status_t, psa_cipher_decrypt, mbedtls_svc_key_id_t, psa_algorithm_t,
+		const uint8_t *, size_t, uint8_t *, size_t, size_t *);
 FAKE_VALUE_FUNC(psa_status_t, psa_verify_message, psa_key_handle_t, psa_algorithm_t,
 		const uint8_t *, size_t, const uint8_t *, size_t);
 FAKE_VALUE_FUNC(psa_status_t, psa_sign_message, psa_key_handle_t, psa_algorithm_t, const uint8_t *,
@@ -94,6 +97,7 @@ FAKE_VALUE_FUNC(psa_status_t, psa_raw_key_agreement, psa_algorithm_t, mbedtls_sv
 	FAKE(psa_cipher_set_iv)                                                                    \
 	FAKE(psa_cipher_update)                                                                    \
 	FAKE(psa_cipher_finish)                                                                    \
+	FAKE(psa_cipher_decrypt)                                                                   \
 	FAKE(psa_verify_message)                                                                   \
 	FAKE(psa_sign_message)                                                                     \
 	FAKE(psa_generate_key)                                                                     \
@@ -123,6 +127,8 @@ FAKE_VALUE_FUNC(psa_status_t, psa_raw_key_agreement, psa_algorithm_t, mbedtls_sv
 #define AES_TEST_DATA_BLOCK_SIZE (128)
 #define HMAC_TEST_DATA_BLOCK_SIZE (128)
 
+#define AES_SINGLE_SHOT_DATA_SIZE (19)
+
 #define AES_IV_SIZE (16)
 #define AES_GCM_IV_SIZE (12)
 #define AES_CCM_IV_SIZE (13)
@@ -222,10 +228,25 @@ struct mock_psa_aead_update_output {
 /*************************************************************************
 * setUp & tearDown
 * ***********************************************************************/
+/* Digest which differs for different input, the key cache finds the keys by it. */
+static psa_status_t fake_psa_hash_compute(psa_algorithm_t alg, const uint8_t *input,
+					  size_t input_length, uint8_t *hash, size_t hash_size,
+					  size_t *hash_length)
+{
+	memset(hash, 0x00, hash_size);
+	for (size_t i = 0; i < input_length; i++) {
+		hash[i % hash_size] ^= input[i] + i;
+	}
+	*hash_length = hash_size;
+
+	return psa_hash_compute_fake.return_val;
+}
+
 void setUp(void)
 {
 	FFF_FAKES_LIST(RESET_FAKE);
 	FFF_RESET_HISTORY();
+	psa_hash_compute_fake.custom_fake = fake_psa_hash_compute;
 }
 
 void tearDown(void)
@@ -891,6 +912,8 @@ void test_sid_pal_crypto_aes_cmac_pass(void)
 
 	psa_crypto_init_fake.return_val = PSA_SUCCESS;
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+	// Keys cached by previous tests are destroyed on init.
+	RESET_FAKE(psa_destroy_key);
 
 	params.mode = SID_PAL_CRYPTO_MAC_CALCULATE;
 	params.algo = SID_PAL_AES_CMAC_128;
@@ -922,6 +945,8 @@ void test_sid_pal_crypto_aes_cmac_false_positives(void)
 
 	psa_crypto_init_fake.return_val = PSA_SUCCESS;
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+	// Keys cached by previous tests are destroyed on init.
+	RESET_FAKE(psa_destroy_key);
 
 	params.mode = SID_PAL_CRYPTO_MAC_CALCULATE;
 	params.algo = SID_PAL_AES_CMAC_128;
@@ -1147,6 +1172,206 @@ void test_sid_pal_crypto_aes_decrypt_false_positives(void)
 	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_STATE, sid_pal_crypto_aes_crypt(&params));
 }
 
+void test_sid_pal_crypto_aes_ctr_single_shot_pass(void)
+{
+	sid_pal_aes_params_t params;
+	uint8_t data[AES_SINGLE_SHOT_DATA_SIZE];
+	uint8_t iv[AES_MAX_BLOCK_SIZE];
+	uint8_t encrypted_data[AES_SINGLE_SHOT_DATA_SIZE];
+	uint8_t aes_128_test_key[AES_MAX_BLOCK_SIZE];
+	sid_pal_aes_mode_t modes[] = { SID_PAL_CRYPTO_ENCRYPT, SID_PAL_CRYPTO_DECRYPT };
+
+	memset(&params, 0x00, sizeof(params));
+
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+
+	params.algo = SID_PAL_AES_CTR_128;
+	params.in = data;
+	params.in_size = sizeof(data);
+	params.out = encrypted_data;
+	params.out_size = sizeof(encrypted_data);
+	params.key = aes_128_test_key;
+	params.key_size = sizeof(aes_128_test_key) * 8;
+	params.iv = iv;
+	params.iv_size = sizeof(iv);
+
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	psa_cipher_decrypt_fake.return_val = PSA_SUCCESS;
+
+	for (int test_it = 0; test_it < ARRAY_SIZE(modes); test_it++) {
+		params.mode = modes[test_it];
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+		TEST_ASSERT_EQUAL(test_it + 1, psa_cipher_decrypt_fake.call_count);
+		TEST_ASSERT_EQUAL(PSA_ALG_CTR, psa_cipher_decrypt_fake.arg1_val);
+		TEST_ASSERT_EQUAL(sizeof(iv) + sizeof(data), psa_cipher_decrypt_fake.arg3_val);
+		TEST_ASSERT_EQUAL_PTR(encrypted_data, psa_cipher_decrypt_fake.arg4_val);
+	}
+
+	// Multi-part operation is not used for short data.
+	TEST_ASSERT_EQUAL(0, psa_cipher_encrypt_setup_fake.call_count);
+	TEST_ASSERT_EQUAL(0, psa_cipher_decrypt_setup_fake.call_count);
+	TEST_ASSERT_EQUAL(0, psa_cipher_update_fake.call_count);
+	TEST_ASSERT_EQUAL(0, psa_cipher_finish_fake.call_count);
+
+	psa_cipher_decrypt_fake.return_val = PSA_ERROR_BUFFER_TOO_SMALL;
+	TEST_ASSERT_EQUAL(SID_ERROR_OUT_OF_RESOURCES, sid_pal_crypto_aes_crypt(&params));
+}
+
+void test_sid_pal_crypto_aes_ctr_in_place(void)
+{
+	sid_pal_aes_params_t params;
+	uint8_t data[AES_TEST_DATA_BLOCK_SIZE];
+	uint8_t iv[AES_MAX_BLOCK_SIZE];
+	uint8_t aes_128_test_key[AES_MAX_BLOCK_SIZE];
+
+	memset(&params, 0x00, sizeof(params));
+
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+
+	params.mode = SID_PAL_CRYPTO_ENCRYPT;
+	params.algo = SID_PAL_AES_CTR_128;
+	params.in = data;
+	params.out = data;
+	params.key = aes_128_test_key;
+	params.key_size = sizeof(aes_128_test_key) * 8;
+	params.iv = iv;
+	params.iv_size = sizeof(iv);
+
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	psa_cipher_decrypt_fake.return_val = PSA_SUCCESS;
+	psa_cipher_encrypt_setup_fake.return_val = PSA_SUCCESS;
+	psa_cipher_set_iv_fake.return_val = PSA_SUCCESS;
+	psa_cipher_update_fake.return_val = PSA_SUCCESS;
+	psa_cipher_finish_fake.return_val = PSA_SUCCESS;
+
+	// Short in-place data is not copied for the single-shot call, it is processed in the
+	// caller's buffer.
+	params.in_size = AES_SINGLE_SHOT_DATA_SIZE;
+	params.out_size = AES_SINGLE_SHOT_DATA_SIZE;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(0, psa_cipher_decrypt_fake.call_count);
+	TEST_ASSERT_EQUAL(1, psa_cipher_update_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(data, psa_cipher_update_fake.arg1_val);
+	TEST_ASSERT_EQUAL_PTR(data, psa_cipher_update_fake.arg3_val);
+
+	params.in_size = sizeof(data);
+	params.out_size = sizeof(data);
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(2, psa_cipher_update_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(data, psa_cipher_update_fake.arg1_val);
+	TEST_ASSERT_EQUAL_PTR(data, psa_cipher_update_fake.arg3_val);
+
+	// Partially overlapped buffers are not supported.
+	params.in_size = AES_SINGLE_SHOT_DATA_SIZE;
+	params.out_size = AES_SINGLE_SHOT_DATA_SIZE;
+	params.out = &data[1];
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS, sid_pal_crypto_aes_crypt(&params));
+	params.in = &data[1];
+	params.out = data;
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS, sid_pal_crypto_aes_crypt(&params));
+
+	// Adjacent buffers do not overlap.
+	params.in = data;
+	params.out = &data[AES_SINGLE_SHOT_DATA_SIZE];
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(1, psa_cipher_decrypt_fake.call_count);
+}
+
+void test_sid_pal_crypto_aes_key_cache(void)
+{
+	sid_pal_aes_params_t params;
+	uint8_t data[AES_TEST_DATA_BLOCK_SIZE];
+	uint8_t mac[AES_MAX_BLOCK_SIZE];
+	uint8_t iv[AES_MAX_BLOCK_SIZE];
+	uint8_t aes_128_test_key[AES_MAX_BLOCK_SIZE];
+	uint8_t aes_128_test_key_2[AES_MAX_BLOCK_SIZE];
+	uint8_t aes_128_test_key_3[AES_MAX_BLOCK_SIZE];
+
+	memset(&params, 0x00, sizeof(params));
+	memset(aes_128_test_key, 0xA1, sizeof(aes_128_test_key));
+	memset(aes_128_test_key_2, 0xA2, sizeof(aes_128_test_key_2));
+	memset(aes_128_test_key_3, 0xA3, sizeof(aes_128_test_key_3));
+
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+	// Keys cached by previous tests are destroyed on init.
+	RESET_FAKE(psa_destroy_key);
+
+	params.mode = SID_PAL_CRYPTO_MAC_CALCULATE;
+	params.algo = SID_PAL_AES_CMAC_128;
+	params.in = data;
+	params.in_size = sizeof(data);
+	params.out = mac;
+	params.out_size = sizeof(mac);
+	params.key = aes_128_test_key;
+	params.key_size = sizeof(aes_128_test_key) * 8;
+
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	psa_mac_compute_fake.return_val = PSA_SUCCESS;
+	psa_cipher_decrypt_fake.return_val = PSA_SUCCESS;
+
+	// The key is imported once for the CMAC operations.
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(1, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(3, psa_mac_compute_fake.call_count);
+	TEST_ASSERT_EQUAL(0, psa_destroy_key_fake.call_count);
+
+	// The same key used with the other algorithm has different usage policy.
+	params.mode = SID_PAL_CRYPTO_ENCRYPT;
+	params.algo = SID_PAL_AES_CTR_128;
+	params.in_size = AES_SINGLE_SHOT_DATA_SIZE;
+	params.out = data;
+	params.out_size = sizeof(data);
+	params.iv = iv;
+	params.iv_size = sizeof(iv);
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(2, psa_import_key_fake.call_count);
+	params.mode = SID_PAL_CRYPTO_DECRYPT;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(2, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(0, psa_destroy_key_fake.call_count);
+
+	// The oldest key is replaced when the cache is full.
+	params.key = aes_128_test_key_2;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(3, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(1, psa_destroy_key_fake.call_count);
+
+	// Failed import is not cached.
+	params.key = aes_128_test_key_3;
+	psa_import_key_fake.return_val = PSA_ERROR_NOT_PERMITTED;
+	TEST_ASSERT_EQUAL(SID_ERROR_NO_PERMISSION, sid_pal_crypto_aes_crypt(&params));
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(5, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(2, psa_destroy_key_fake.call_count);
+
+	// The keys are found by their digest, the key bytes are not kept.
+	TEST_ASSERT_EQUAL(8, psa_hash_compute_fake.call_count);
+	TEST_ASSERT_EQUAL(PSA_ALG_SHA_256, psa_hash_compute_fake.arg0_val);
+
+	// A key which can not be hashed is used for one operation only.
+	params.key = aes_128_test_key;
+	psa_hash_compute_fake.return_val = PSA_ERROR_NOT_SUPPORTED;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(6, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(3, psa_destroy_key_fake.call_count);
+	psa_hash_compute_fake.return_val = PSA_SUCCESS;
+
+	// Cached keys are destroyed on deinit.
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_deinit());
+	TEST_ASSERT_EQUAL(5, psa_destroy_key_fake.call_count);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	TEST_ASSERT_EQUAL(7, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(5, psa_destroy_key_fake.call_count);
+}
+
 /*************************************************************************
 * END AES & CMAC
 * ***********************************************************************/
@@ -1515,6 +1740,142 @@ void test_sid_pal_crypto_ecc_dsa_SECP256R1_buffer_overflow(void)
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_ecc_dsa(&params));
 }
 
+void test_sid_pal_crypto_ecc_dsa_verify_key_cache(void)
+{
+	sid_pal_dsa_params_t params;
+	uint8_t data[AES_TEST_DATA_BLOCK_SIZE];
+	uint8_t signature[ECDSA_SIGNATURE_SIZE];
+	uint8_t public_ED[EC_ED25519_PUB_KEY_LEN];
+	uint8_t public_SECP256R1[EC_SECP256R1_PUB_KEY_LEN];
+	uint8_t private_SECP256R1[EC_SECP256R1_PRIV_KEY_LEN];
+
+	memset(&params, 0x00, sizeof(params));
+	memset(public_ED, 0xE1, sizeof(public_ED));
+	memset(public_SECP256R1, 0xE2, sizeof(public_SECP256R1));
+
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+	// Keys cached by previous tests are destroyed on init.
+	RESET_FAKE(psa_destroy_key);
+
+	params.algo = SID_PAL_EDDSA_ED25519;
+	params.mode = SID_PAL_CRYPTO_VERIFY;
+	params.key = public_ED;
+	params.key_size = sizeof(public_ED);
+	params.in = data;
+	params.in_size = sizeof(data);
+	params.signature = signature;
+	params.sig_size = sizeof(signature);
+
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	psa_verify_message_fake.return_val = PSA_SUCCESS;
+	psa_sign_message_fake.return_val = PSA_SUCCESS;
+
+	// The public key is imported once.
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_ecc_dsa(&params));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_ecc_dsa(&params));
+	TEST_ASSERT_EQUAL(1, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(EC_ED25519_PUB_KEY_LEN, psa_import_key_fake.arg2_val);
+	TEST_ASSERT_EQUAL(2, psa_verify_message_fake.call_count);
+
+	// The SECP256R1 public key is imported with the prefix.
+	params.algo = SID_PAL_ECDSA_SECP256R1;
+	params.key = public_SECP256R1;
+	params.key_size = sizeof(public_SECP256R1);
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_ecc_dsa(&params));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_ecc_dsa(&params));
+	TEST_ASSERT_EQUAL(2, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(EC_SECP256R1_PUB_KEY_LEN + 1, psa_import_key_fake.arg2_val);
+
+	// Failed verification does not drop the key.
+	psa_verify_message_fake.return_val = PSA_ERROR_INVALID_SIGNATURE;
+	TEST_ASSERT_EQUAL(SID_ERROR_GENERIC, sid_pal_crypto_ecc_dsa(&params));
+	TEST_ASSERT_EQUAL(2, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(0, psa_destroy_key_fake.call_count);
+
+	// Private keys are not cached.
+	params.mode = SID_PAL_CRYPTO_SIGN;
+	params.key = private_SECP256R1;
+	params.key_size = sizeof(private_SECP256R1);
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_ecc_dsa(&params));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_ecc_dsa(&params));
+	TEST_ASSERT_EQUAL(4, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(2, psa_destroy_key_fake.call_count);
+
+	// A public key longer than the import buffer is rejected, not truncated.
+	params.mode = SID_PAL_CRYPTO_VERIFY;
+	params.key = public_SECP256R1;
+	params.key_size = EC_SECP256R1_PUB_KEY_LEN + 1;
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS, sid_pal_crypto_ecc_dsa(&params));
+	TEST_ASSERT_EQUAL(4, psa_import_key_fake.call_count);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_deinit());
+	TEST_ASSERT_EQUAL(4, psa_destroy_key_fake.call_count);
+}
+
+void test_sid_pal_crypto_ecc_dsa_verify_chain(void)
+{
+	sid_pal_dsa_params_t params[3];
+	size_t failed_index = 0;
+	psa_status_t psa_verify_message_ret[] = { PSA_SUCCESS, PSA_ERROR_INVALID_SIGNATURE };
+	uint8_t data[AES_TEST_DATA_BLOCK_SIZE];
+	uint8_t signature[ARRAY_SIZE(params)][ECDSA_SIGNATURE_SIZE];
+	uint8_t public_SECP256R1[2][EC_SECP256R1_PUB_KEY_LEN];
+
+	memset(params, 0x00, sizeof(params));
+	memset(public_SECP256R1[0], 0xC1, sizeof(public_SECP256R1[0]));
+	memset(public_SECP256R1[1], 0xC2, sizeof(public_SECP256R1[1]));
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_deinit());
+	TEST_ASSERT_EQUAL(SID_ERROR_UNINITIALIZED,
+			  sid_pal_crypto_ecc_dsa_verify_chain(params, ARRAY_SIZE(params), NULL));
+
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NULL_POINTER,
+			  sid_pal_crypto_ecc_dsa_verify_chain(NULL, ARRAY_SIZE(params), NULL));
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS,
+			  sid_pal_crypto_ecc_dsa_verify_chain(params, 0, NULL));
+
+	// The first and the last signatures are verified with the same key.
+	for (int i = 0; i < ARRAY_SIZE(params); i++) {
+		params[i].algo = SID_PAL_ECDSA_SECP256R1;
+		params[i].mode = SID_PAL_CRYPTO_VERIFY;
+		params[i].key = public_SECP256R1[i % 2];
+		params[i].key_size = EC_SECP256R1_PUB_KEY_LEN;
+		params[i].in = data;
+		params[i].in_size = sizeof(data);
+		params[i].signature = signature[i];
+		params[i].sig_size = ECDSA_SIGNATURE_SIZE;
+	}
+
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	psa_verify_message_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_ecc_dsa_verify_chain(
+						  params, ARRAY_SIZE(params), &failed_index));
+	TEST_ASSERT_EQUAL(3, psa_verify_message_fake.call_count);
+	TEST_ASSERT_EQUAL(2, psa_import_key_fake.call_count);
+
+	// Verification stops on the first failure.
+	RESET_FAKE(psa_verify_message);
+	SET_RETURN_SEQ(psa_verify_message, psa_verify_message_ret,
+		       ARRAY_SIZE(psa_verify_message_ret));
+	TEST_ASSERT_EQUAL(SID_ERROR_GENERIC, sid_pal_crypto_ecc_dsa_verify_chain(
+						     params, ARRAY_SIZE(params), &failed_index));
+	TEST_ASSERT_EQUAL(1, failed_index);
+	TEST_ASSERT_EQUAL(2, psa_verify_message_fake.call_count);
+	TEST_ASSERT_EQUAL(2, psa_import_key_fake.call_count);
+
+	// Only verification is allowed.
+	RESET_FAKE(psa_verify_message);
+	params[2].mode = SID_PAL_CRYPTO_SIGN;
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS, sid_pal_crypto_ecc_dsa_verify_chain(
+							  params, ARRAY_SIZE(params), &failed_index));
+	TEST_ASSERT_EQUAL(2, failed_index);
+	TEST_ASSERT_EQUAL(2, psa_verify_message_fake.call_count);
+}
+
 /*************************************************************************
 * ECDSA
 * ***********************************************************************/
@@ -2070,6 +2431,153 @@ void test_sid_pal_crypto_aead_ccm_128_decrypt_pass(void)
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aead_crypt(&params));
 }
 
+void test_sid_pal_crypto_aead_ccm_star_pass(void)
+{
+	sid_pal_aead_params_t params;
+
+	uint8_t data[AES_TEST_DATA_BLOCK_SIZE];
+	uint8_t additional_data[AES_TEST_DATA_BLOCK_SIZE] = { "Additional data..." };
+	uint8_t iv[AES_CCM_IV_SIZE];
+	uint8_t encrypted_data[AES_TEST_DATA_BLOCK_SIZE];
+	uint8_t mac[AES_MAX_BLOCK_SIZE];
+	uint8_t aes_128_test_key[AES_MAX_BLOCK_SIZE];
+
+	memset(&params, 0x00, sizeof(params));
+
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+
+	params.algo = SID_PAL_AEAD_CCM_STAR_128;
+	params.mode = SID_PAL_CRYPTO_ENCRYPT;
+	params.key = aes_128_test_key;
+	params.key_size = sizeof(aes_128_test_key) * 8;
+	params.iv = iv;
+	params.iv_size = AES_CCM_IV_SIZE;
+	params.aad = additional_data;
+	params.aad_size = sizeof(additional_data);
+	params.in = data;
+	params.in_size = sizeof(data);
+	params.out = encrypted_data;
+	params.out_size = sizeof(encrypted_data);
+	params.mac = mac;
+	params.mac_size = 8;
+
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	psa_aead_encrypt_setup_fake.return_val = PSA_SUCCESS;
+	psa_aead_decrypt_setup_fake.return_val = PSA_SUCCESS;
+	psa_aead_set_lengths_fake.return_val = PSA_SUCCESS;
+	psa_aead_set_nonce_fake.return_val = PSA_SUCCESS;
+	psa_aead_update_ad_fake.return_val = PSA_SUCCESS;
+
+	memset(&mock_psa_aead_update_values, 0, sizeof(mock_psa_aead_update_values));
+	MOCK_PSA_AEAD_UPDATE_SET_RETURN(PSA_SUCCESS, PSA_SUCCESS);
+	MOCK_PSA_AEAD_UPDATE_SET_OUT_OUTPUT_LENGTH(params.out_size, params.out_size);
+
+	custom_psa_aead_update_t custom_psa_aead_update[] = { mock_psa_aead_update };
+
+	SET_CUSTOM_FAKE_SEQ(psa_aead_update, custom_psa_aead_update,
+			    ARRAY_SIZE(custom_psa_aead_update));
+
+	psa_aead_finish_fake.return_val = PSA_SUCCESS;
+	psa_aead_verify_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aead_crypt(&params));
+	TEST_ASSERT_EQUAL(1, psa_aead_finish_fake.call_count);
+
+	params.mode = SID_PAL_CRYPTO_DECRYPT;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aead_crypt(&params));
+	TEST_ASSERT_EQUAL(1, psa_aead_verify_fake.call_count);
+
+	// Both directions share one imported key.
+	TEST_ASSERT_EQUAL(1, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(2, psa_aead_update_fake.call_count);
+}
+
+void test_sid_pal_crypto_aead_ccm_star_mic_only(void)
+{
+	sid_pal_aead_params_t params;
+
+	uint8_t additional_data[AES_TEST_DATA_BLOCK_SIZE] = { "Additional data..." };
+	uint8_t iv[AES_CCM_IV_SIZE];
+	uint8_t mac[AES_MAX_BLOCK_SIZE];
+	uint8_t aes_128_test_key[AES_MAX_BLOCK_SIZE];
+
+	memset(&params, 0x00, sizeof(params));
+
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+
+	params.algo = SID_PAL_AEAD_CCM_STAR_128;
+	params.mode = SID_PAL_CRYPTO_ENCRYPT;
+	params.key = aes_128_test_key;
+	params.key_size = sizeof(aes_128_test_key) * 8;
+	params.iv = iv;
+	params.iv_size = AES_CCM_IV_SIZE;
+	params.aad = additional_data;
+	params.aad_size = sizeof(additional_data);
+	params.mac = mac;
+	params.mac_size = 4;
+
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	psa_aead_encrypt_setup_fake.return_val = PSA_SUCCESS;
+	psa_aead_decrypt_setup_fake.return_val = PSA_SUCCESS;
+	psa_aead_set_lengths_fake.return_val = PSA_SUCCESS;
+	psa_aead_set_nonce_fake.return_val = PSA_SUCCESS;
+	psa_aead_update_ad_fake.return_val = PSA_SUCCESS;
+	psa_aead_finish_fake.return_val = PSA_SUCCESS;
+	psa_aead_verify_fake.return_val = PSA_SUCCESS;
+
+	// No payload, MIC over the header only.
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aead_crypt(&params));
+	params.mode = SID_PAL_CRYPTO_DECRYPT;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aead_crypt(&params));
+	TEST_ASSERT_EQUAL(0, psa_aead_update_fake.call_count);
+	TEST_ASSERT_EQUAL(1, psa_aead_finish_fake.call_count);
+	TEST_ASSERT_EQUAL(1, psa_aead_verify_fake.call_count);
+	TEST_ASSERT_EQUAL(0, psa_aead_set_lengths_fake.arg2_val);
+
+	// MIC-only is not available for CCM.
+	params.algo = SID_PAL_AEAD_CCM_128;
+	TEST_ASSERT_EQUAL(SID_ERROR_NULL_POINTER, sid_pal_crypto_aead_crypt(&params));
+}
+
+void test_sid_pal_crypto_aead_ccm_star_invalid_mic_size(void)
+{
+	sid_pal_aead_params_t params;
+
+	uint8_t data[AES_TEST_DATA_BLOCK_SIZE];
+	uint8_t additional_data[AES_TEST_DATA_BLOCK_SIZE] = { "Additional data..." };
+	uint8_t iv[AES_CCM_IV_SIZE];
+	uint8_t encrypted_data[AES_TEST_DATA_BLOCK_SIZE];
+	uint8_t mac[AES_MAX_BLOCK_SIZE];
+	uint8_t aes_128_test_key[AES_MAX_BLOCK_SIZE];
+	size_t invalid_mic_sizes[] = { 0, 2, 6, 10, 12, 14 };
+
+	memset(&params, 0x00, sizeof(params));
+
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+
+	params.algo = SID_PAL_AEAD_CCM_STAR_128;
+	params.mode = SID_PAL_CRYPTO_ENCRYPT;
+	params.key = aes_128_test_key;
+	params.key_size = sizeof(aes_128_test_key) * 8;
+	params.iv = iv;
+	params.iv_size = AES_CCM_IV_SIZE;
+	params.aad = additional_data;
+	params.aad_size = sizeof(additional_data);
+	params.in = data;
+	params.in_size = sizeof(data);
+	params.out = encrypted_data;
+	params.out_size = sizeof(encrypted_data);
+	params.mac = mac;
+
+	for (int i = 0; i < ARRAY_SIZE(invalid_mic_sizes); i++) {
+		params.mac_size = invalid_mic_sizes[i];
+		TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS, sid_pal_crypto_aead_crypt(&params));
+	}
+	TEST_ASSERT_EQUAL(0, psa_import_key_fake.call_count);
+}
+
 void test_sid_pal_crypto_aead_no_iv(void)
 {
 	sid_pal_aead_params_t params;
@@ -2175,6 +2683,8 @@ void test_sid_pal_crypto_aead_decrypt_false_positives(void)
 
 	psa_crypto_init_fake.return_val = PSA_SUCCESS;
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+	// Keys cached by previous tests are destroyed on init.
+	RESET_FAKE(psa_destroy_key);
 
 	params.algo = SID_PAL_AEAD_GCM_128;
 	params.mode = SID_PAL_CRYPTO_DECRYPT;
@@ -2271,6 +2781,8 @@ void test_sid_pal_crypto_aead_encrypt_false_positives(void)
 
 	psa_crypto_init_fake.return_val = PSA_SUCCESS;
 	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+	// Keys cached by previous tests are destroyed on init.
+	RESET_FAKE(psa_destroy_key);
 
 	params.algo = SID_PAL_AEAD_GCM_128;
 	params.mode = SID_PAL_CRYPTO_ENCRYPT;
@@ -2505,6 +3017,79 @@ void test_sid_pal_crypto_ecc_ecdh_SECP256R1_buffer_overflow(void)
 * END ECDH
 * ***********************************************************************/
 
+/*************************************************************************
+* STATS
+* ***********************************************************************/
+void test_sid_pal_crypto_stats(void)
+{
+	struct sid_crypto_stats stats;
+	sid_pal_hash_params_t hash_params;
+	sid_pal_aes_params_t aes_params;
+	uint8_t data[HASH_TEST_DATA_BLOCK_SIZE];
+	uint8_t digest[SHA_MAX_DIGEST_LEN];
+	uint8_t iv[AES_MAX_BLOCK_SIZE];
+	uint8_t key[AES_MAX_BLOCK_SIZE];
+	uint32_t hist_sum = 0;
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NULL_POINTER, sid_crypto_stats_snapshot(NULL));
+
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+	sid_crypto_stats_reset();
+
+	memset(&hash_params, 0x00, sizeof(hash_params));
+	hash_params.algo = SID_PAL_HASH_SHA256;
+	hash_params.data = data;
+	hash_params.data_size = sizeof(data);
+	hash_params.digest = digest;
+	hash_params.digest_size = SHA256_LEN;
+
+	psa_hash_compute_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_hash(&hash_params));
+	psa_hash_compute_fake.return_val = PSA_ERROR_GENERIC_ERROR;
+	TEST_ASSERT_EQUAL(SID_ERROR_GENERIC, sid_pal_crypto_hash(&hash_params));
+
+	memset(&aes_params, 0x00, sizeof(aes_params));
+	aes_params.algo = SID_PAL_AES_CMAC_128;
+	aes_params.mode = SID_PAL_CRYPTO_MAC_CALCULATE;
+	aes_params.key = key;
+	aes_params.key_size = sizeof(key) * 8;
+	aes_params.iv = iv;
+	aes_params.iv_size = sizeof(iv);
+	aes_params.in = data;
+	aes_params.in_size = sizeof(data);
+	aes_params.out = digest;
+	aes_params.out_size = sizeof(digest);
+
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	psa_mac_compute_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&aes_params));
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_crypto_stats_snapshot(&stats));
+	TEST_ASSERT_EQUAL(2, stats.op[SID_CRYPTO_STATS_OP_HASH].calls);
+	TEST_ASSERT_EQUAL(1, stats.op[SID_CRYPTO_STATS_OP_HASH].errors);
+	TEST_ASSERT_EQUAL(2 * sizeof(data), stats.op[SID_CRYPTO_STATS_OP_HASH].bytes);
+	for (int i = 0; i < SID_CRYPTO_STATS_HIST_BUCKETS; i++) {
+		hist_sum += stats.op[SID_CRYPTO_STATS_OP_HASH].hist[i];
+	}
+	TEST_ASSERT_EQUAL(2, hist_sum);
+	TEST_ASSERT_EQUAL(1, stats.op[SID_CRYPTO_STATS_OP_AES_CMAC].calls);
+	TEST_ASSERT_EQUAL(0, stats.op[SID_CRYPTO_STATS_OP_AES_CMAC].errors);
+	TEST_ASSERT_EQUAL(0, stats.op[SID_CRYPTO_STATS_OP_AES_CTR].calls);
+
+	sid_crypto_stats_reset();
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_crypto_stats_snapshot(&stats));
+	TEST_ASSERT_EQUAL(0, stats.op[SID_CRYPTO_STATS_OP_HASH].calls);
+	TEST_ASSERT_EQUAL(0, stats.op[SID_CRYPTO_STATS_OP_AES_CMAC].calls);
+
+	TEST_ASSERT_EQUAL_STRING("aes_cmac", sid_crypto_stats_op_name(SID_CRYPTO_STATS_OP_AES_CMAC));
+	TEST_ASSERT_EQUAL_STRING("unknown", sid_crypto_stats_op_name(SID_CRYPTO_STATS_OP_COUNT));
+}
+
+/*************************************************************************
+* END STATS
+* ***********************************************************************/
+
 /* It is required to be added to each test. That is because unity is using
  * different main signature (returns int) and zephyr expects main which does
  * not return value.
@@ -5,9 +5,25 @@
  */
 #include <unity.h>
 #include <sid_pal_log_ifc.h>
+#include <sid_log_ring.h>
+#include <sid_log_ext.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/logging/log_ctrl.h>
+
+static void sidewalk_filter_set(uint32_t level)
+{
+	int source_id = log_source_id_get("sidewalk");
+
+	TEST_ASSERT_GREATER_OR_EQUAL(0, source_id);
+	(void)log_filter_set(NULL, Z_LOG_LOCAL_DOMAIN_ID, source_id, level);
+}
 
 void setUp(void)
 {
+	sidewalk_filter_set(LOG_LEVEL_DBG);
+	sid_log_ring_reset();
 }
 
 /******************************************************************
@@ -42,6 +58,22 @@ void test_log_flush(void)
 	TEST_PASS();
 }
 
+void test_log_flush_wait_empty(void)
+{
+	sid_pal_log_flush();
+	TEST_ASSERT_EQUAL(0, sid_log_flush_wait(0));
+}
+
+void test_log_flush_wait(void)
+{
+	for (int i = 0; i < 10; i++) {
+		sid_pal_log(SID_PAL_LOG_SEVERITY_INFO, 1, "Sidewalk log flush %d", i);
+	}
+
+	TEST_ASSERT_EQUAL(0, sid_log_flush_wait(1000));
+	TEST_ASSERT_EQUAL(0, log_buffered_cnt());
+}
+
 void test_log_push_string(void)
 {
 	char test_string[] = "test message 123";
@@ -55,10 +87,156 @@ void test_log_get_buffer(void)
 {
 	bool ret;
 	struct sid_pal_log_buffer *const test_log_buffer = NULL;
+	struct sid_pal_log_buffer empty_log_buffer = { .buf = NULL, .size = 0 };
 
 	ret = sid_pal_log_get_log_buffer(test_log_buffer);
-	TEST_ASSERT_FALSE_MESSAGE(
-		ret, "sid_pal_log_get_log_buffer not implemented, should always return false.");
+	TEST_ASSERT_FALSE(ret);
+
+	sid_pal_log(SID_PAL_LOG_SEVERITY_INFO, 0, "Sidewalk log");
+	ret = sid_pal_log_get_log_buffer(&empty_log_buffer);
+	TEST_ASSERT_FALSE(ret);
+}
+
+void test_log_get_buffer_empty(void)
+{
+	uint8_t buf[64];
+	struct sid_pal_log_buffer log_buffer = { .buf = buf, .size = sizeof(buf) };
+
+	TEST_ASSERT_FALSE(sid_pal_log_get_log_buffer(&log_buffer));
+}
+
+void test_log_get_buffer_message(void)
+{
+	uint8_t buf[64];
+	struct sid_pal_log_buffer log_buffer = { .buf = buf, .size = sizeof(buf) };
+	uint8_t first_idx;
+
+	sid_pal_log(SID_PAL_LOG_SEVERITY_INFO, 2, "value %d, %s", 5, "text");
+	sid_pal_log(SID_PAL_LOG_SEVERITY_DEBUG, 0, "second");
+
+	TEST_ASSERT_TRUE(sid_pal_log_get_log_buffer(&log_buffer));
+	TEST_ASSERT_EQUAL_STRING("value 5, text", (char *)buf);
+	TEST_ASSERT_EQUAL(strlen("value 5, text"), log_buffer.size);
+	first_idx = log_buffer.idx;
+
+	log_buffer.size = sizeof(buf);
+	TEST_ASSERT_TRUE(sid_pal_log_get_log_buffer(&log_buffer));
+	TEST_ASSERT_EQUAL_STRING("second", (char *)buf);
+	TEST_ASSERT_EQUAL((uint8_t)(first_idx + 1), log_buffer.idx);
+
+	log_buffer.size = sizeof(buf);
+	TEST_ASSERT_FALSE(sid_pal_log_get_log_buffer(&log_buffer));
+}
+
+void test_log_get_buffer_truncated(void)
+{
+	uint8_t buf[8];
+	struct sid_pal_log_buffer log_buffer = { .buf = buf, .size = sizeof(buf) };
+
+	sid_pal_log(SID_PAL_LOG_SEVERITY_INFO, 0, "Sidewalk log longer than buffer");
+
+	TEST_ASSERT_TRUE(sid_pal_log_get_log_buffer(&log_buffer));
+	TEST_ASSERT_EQUAL(sizeof(buf) - 1, log_buffer.size);
+	TEST_ASSERT_EQUAL_STRING("Sidewal", (char *)buf);
+}
+
+void test_log_ring_ram_string_copied(void)
+{
+	uint8_t buf[64];
+	struct sid_pal_log_buffer log_buffer = { .buf = buf, .size = sizeof(buf) };
+	char text[] = "ram string";
+
+	sid_pal_log(SID_PAL_LOG_SEVERITY_INFO, 1, "%s", text);
+	memset(text, 'x', sizeof(text) - 1);
+
+	TEST_ASSERT_TRUE(sid_pal_log_get_log_buffer(&log_buffer));
+	TEST_ASSERT_EQUAL_STRING("ram string", (char *)buf);
+}
+
+struct drain_ctx {
+	size_t count;
+	char first[32];
+};
+
+static bool drain_cb(const struct sid_log_record *record, void *ctx)
+{
+	struct drain_ctx *drain = ctx;
+
+	if (!drain->count) {
+		sid_log_ring_format(record, drain->first, sizeof(drain->first));
+	}
+	drain->count++;
+
+	return true;
+}
+
+static bool drain_stop_cb(const struct sid_log_record *record, void *ctx)
+{
+	return false;
+}
+
+void test_log_ring_overwrite_oldest(void)
+{
+	struct drain_ctx drain = { 0 };
+
+	for (int i = 0; i < CONFIG_SIDEWALK_LOG_RING_RECORDS + 3; i++) {
+		sid_pal_log(SID_PAL_LOG_SEVERITY_DEBUG, 1, "record %d", i);
+	}
+
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_LOG_RING_RECORDS,
+			  sid_log_ring_drain(drain_cb, &drain, SIZE_MAX));
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_LOG_RING_RECORDS, drain.count);
+	TEST_ASSERT_EQUAL_STRING("record 3", drain.first);
+	TEST_ASSERT_EQUAL(3, sid_log_ring_dropped());
+
+	sid_log_ring_reset();
+	TEST_ASSERT_EQUAL(0, sid_log_ring_dropped());
+}
+
+void test_log_ring_drain_limit(void)
+{
+	struct drain_ctx drain = { 0 };
+
+	for (int i = 0; i < 4; i++) {
+		sid_pal_log(SID_PAL_LOG_SEVERITY_DEBUG, 1, "record %d", i);
+	}
+
+	TEST_ASSERT_EQUAL(0, sid_log_ring_drain(NULL, NULL, SIZE_MAX));
+	TEST_ASSERT_EQUAL(0, sid_log_ring_drain(drain_stop_cb, NULL, SIZE_MAX));
+	TEST_ASSERT_EQUAL(2, sid_log_ring_drain(drain_cb, &drain, 2));
+	TEST_ASSERT_EQUAL_STRING("record 0", drain.first);
+
+	drain.count = 0;
+	TEST_ASSERT_EQUAL(2, sid_log_ring_drain(drain_cb, &drain, SIZE_MAX));
+	TEST_ASSERT_EQUAL_STRING("record 2", drain.first);
+	TEST_ASSERT_EQUAL(0, sid_log_ring_dropped());
+}
+
+void test_log_runtime_filter(void)
+{
+	struct drain_ctx drain = { 0 };
+
+	sidewalk_filter_set(LOG_LEVEL_WRN);
+	sid_pal_log(SID_PAL_LOG_SEVERITY_INFO, 1, "filtered %d", 1);
+	sid_pal_log(SID_PAL_LOG_SEVERITY_DEBUG, 1, "filtered %d", 2);
+	sid_pal_log(SID_PAL_LOG_SEVERITY_WARNING, 1, "passed %d", 3);
+
+	/* The ring keeps the messages the log filter drops. */
+	TEST_ASSERT_EQUAL(3, sid_log_ring_drain(drain_cb, &drain, SIZE_MAX));
+	TEST_ASSERT_EQUAL_STRING("filtered 1", drain.first);
+	TEST_ASSERT_EQUAL(0, sid_log_ring_dropped());
+}
+
+/* Logging stays in panic mode, keep this test last. */
+void test_log_panic_flush(void)
+{
+	for (int i = 0; i < 10; i++) {
+		sid_pal_log(SID_PAL_LOG_SEVERITY_ERROR, 1, "Sidewalk log panic %d", i);
+	}
+
+	sid_log_panic_flush();
+	TEST_ASSERT_EQUAL(0, log_buffered_cnt());
+	TEST_ASSERT_EQUAL(0, sid_log_flush_wait(0));
 }
 
 /* It is required to be added to each test. That is because unity is using
@@ -0,0 +1,9 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define CONFIG_SIDEWALK_LOG_LEVEL 4
+#define CONFIG_SIDEWALK_LOG_CONTROL_MODULES_MAX 2
+#define CONFIG_SIDEWALK_LOG_CONTROL_KV_KEY 0x7f00
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <sid_log_control.h>
+
+#include <cmock_sid_pal_storage_kv_ifc.h>
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#define ZEPHYR_MODULE "sid_log_control"
+
+static uint8_t kv_data[128];
+static uint32_t kv_len;
+static uint32_t kv_writes;
+
+static sid_error_t kv_get_len(uint16_t group, uint16_t key, uint32_t *p_len, int cmock_num_calls)
+{
+	if (!kv_len) {
+		return SID_ERROR_NOT_FOUND;
+	}
+	*p_len = kv_len;
+	return SID_ERROR_NONE;
+}
+
+static sid_error_t kv_get(uint16_t group, uint16_t key, void *p_data, uint32_t len,
+			  int cmock_num_calls)
+{
+	if (!kv_len) {
+		return SID_ERROR_NOT_FOUND;
+	}
+	memcpy(p_data, kv_data, MIN(len, kv_len));
+	return SID_ERROR_NONE;
+}
+
+static sid_error_t kv_set(uint16_t group, uint16_t key, void const *p_data, uint32_t len,
+			  int cmock_num_calls)
+{
+	TEST_ASSERT_LESS_OR_EQUAL(sizeof(kv_data), len);
+	memcpy(kv_data, p_data, len);
+	kv_len = len;
+	kv_writes++;
+	return SID_ERROR_NONE;
+}
+
+static sid_error_t kv_delete(uint16_t group, uint16_t key, int cmock_num_calls)
+{
+	kv_len = 0;
+	return SID_ERROR_NONE;
+}
+
+void setUp(void)
+{
+	__cmock_sid_pal_storage_kv_record_get_len_StubWithCallback(kv_get_len);
+	__cmock_sid_pal_storage_kv_record_get_StubWithCallback(kv_get);
+	__cmock_sid_pal_storage_kv_record_set_StubWithCallback(kv_set);
+	__cmock_sid_pal_storage_kv_record_delete_StubWithCallback(kv_delete);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_reset());
+	kv_writes = 0;
+}
+
+/******************************************************************
+* sid_log_control
+* ****************************************************************/
+
+void test_log_control_default_level(void)
+{
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_init());
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_LEVEL, sid_log_control_get_current_log_level());
+}
+
+void test_log_control_set_protocol_level(void)
+{
+	sid_pal_log_severity_t level;
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_log_control_set_level(SID_LOG_CONTROL_PROTOCOL_MODULE,
+						    SID_PAL_LOG_SEVERITY_ERROR, false));
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_ERROR, sid_log_control_get_current_log_level());
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_log_control_get_level(SID_LOG_CONTROL_PROTOCOL_MODULE, &level));
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_ERROR, level);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_log_control_set_level(SID_LOG_CONTROL_PROTOCOL_MODULE,
+						    SID_PAL_LOG_SEVERITY_DEBUG, false));
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_DEBUG, sid_log_control_get_current_log_level());
+	TEST_ASSERT_EQUAL(0, kv_writes);
+}
+
+void test_log_control_set_zephyr_module_level(void)
+{
+	sid_pal_log_severity_t level;
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_set_level(
+						  ZEPHYR_MODULE, SID_PAL_LOG_SEVERITY_WARNING, false));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_get_level(ZEPHYR_MODULE, &level));
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_WARNING, level);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_set_level(
+						  ZEPHYR_MODULE, SID_PAL_LOG_SEVERITY_INFO, true));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_reset());
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_get_level(ZEPHYR_MODULE, &level));
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_DEBUG, level);
+}
+
+void test_log_control_persist_and_restore(void)
+{
+	char module[SID_LOG_CONTROL_MODULE_NAME_MAX + 1];
+	sid_pal_log_severity_t level;
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_log_control_set_level(SID_LOG_CONTROL_PROTOCOL_MODULE,
+						    SID_PAL_LOG_SEVERITY_WARNING, true));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_set_level(
+						  ZEPHYR_MODULE, SID_PAL_LOG_SEVERITY_ERROR, true));
+	TEST_ASSERT_EQUAL(2, kv_writes);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_log_control_set_level(SID_LOG_CONTROL_PROTOCOL_MODULE,
+						    SID_PAL_LOG_SEVERITY_DEBUG, false));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_set_level(
+						  ZEPHYR_MODULE, SID_PAL_LOG_SEVERITY_DEBUG, false));
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_init());
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_WARNING, sid_log_control_get_current_log_level());
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_get_level(ZEPHYR_MODULE, &level));
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_ERROR, level);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_get_stored(0, module, &level));
+	TEST_ASSERT_EQUAL_STRING(SID_LOG_CONTROL_PROTOCOL_MODULE, module);
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_WARNING, level);
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_get_stored(1, module, &level));
+	TEST_ASSERT_EQUAL_STRING(ZEPHYR_MODULE, module);
+	TEST_ASSERT_EQUAL(SID_ERROR_NOT_FOUND, sid_log_control_get_stored(2, module, &level));
+}
+
+void test_log_control_reset(void)
+{
+	char module[SID_LOG_CONTROL_MODULE_NAME_MAX + 1];
+	sid_pal_log_severity_t level;
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_log_control_set_level(SID_LOG_CONTROL_PROTOCOL_MODULE,
+						    SID_PAL_LOG_SEVERITY_ERROR, true));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_reset());
+
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_LEVEL, sid_log_control_get_current_log_level());
+	TEST_ASSERT_EQUAL(SID_ERROR_NOT_FOUND, sid_log_control_get_stored(0, module, &level));
+	TEST_ASSERT_EQUAL(0, kv_len);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_init());
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_LEVEL, sid_log_control_get_current_log_level());
+}
+
+void test_log_control_invalid_args(void)
+{
+	sid_pal_log_severity_t level;
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NULL_POINTER,
+			  sid_log_control_set_level(NULL, SID_PAL_LOG_SEVERITY_ERROR, false));
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS,
+			  sid_log_control_set_level("", SID_PAL_LOG_SEVERITY_ERROR, false));
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS,
+			  sid_log_control_set_level("module_name_longer_than_allowed",
+						    SID_PAL_LOG_SEVERITY_ERROR, false));
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS,
+			  sid_log_control_set_level(SID_LOG_CONTROL_PROTOCOL_MODULE,
+						    SID_PAL_LOG_SEVERITY_DEBUG + 1, false));
+	TEST_ASSERT_EQUAL(SID_ERROR_NOT_FOUND,
+			  sid_log_control_set_level("unknown", SID_PAL_LOG_SEVERITY_ERROR, false));
+	TEST_ASSERT_EQUAL(SID_ERROR_NOT_FOUND, sid_log_control_get_level("unknown", &level));
+	TEST_ASSERT_EQUAL(SID_ERROR_NULL_POINTER,
+			  sid_log_control_get_level(SID_LOG_CONTROL_PROTOCOL_MODULE, NULL));
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_LEVEL, sid_log_control_get_current_log_level());
+}
+
+void test_log_control_stored_full(void)
+{
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_log_control_set_level(SID_LOG_CONTROL_PROTOCOL_MODULE,
+						    SID_PAL_LOG_SEVERITY_ERROR, true));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_set_level(
+						  ZEPHYR_MODULE, SID_PAL_LOG_SEVERITY_ERROR, true));
+	TEST_ASSERT_EQUAL(SID_ERROR_OUT_OF_RESOURCES,
+			  sid_log_control_set_level("unknown", SID_PAL_LOG_SEVERITY_ERROR, true));
+
+	/* Stored entry is updated in place. */
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_log_control_set_level(SID_LOG_CONTROL_PROTOCOL_MODULE,
+						    SID_PAL_LOG_SEVERITY_INFO, true));
+	TEST_ASSERT_EQUAL(3, kv_writes);
+
+	/* Unchanged value is not written again. */
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_log_control_set_level(SID_LOG_CONTROL_PROTOCOL_MODULE,
+						    SID_PAL_LOG_SEVERITY_INFO, true));
+	TEST_ASSERT_EQUAL(3, kv_writes);
+}
+
+void test_log_control_set_level_deferred(void)
+{
+	char module[SID_LOG_CONTROL_MODULE_NAME_MAX + 1];
+	sid_pal_log_severity_t level;
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_log_control_set_level_deferred(SID_LOG_CONTROL_PROTOCOL_MODULE,
+							     SID_PAL_LOG_SEVERITY_WARNING));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_set_level_deferred(
+						  ZEPHYR_MODULE, SID_PAL_LOG_SEVERITY_ERROR));
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_WARNING, sid_log_control_get_current_log_level());
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_get_stored(1, module, &level));
+	TEST_ASSERT_EQUAL_STRING(ZEPHYR_MODULE, module);
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_ERROR, level);
+	TEST_ASSERT_EQUAL(SID_ERROR_OUT_OF_RESOURCES,
+			  sid_log_control_set_level_deferred("unknown", SID_PAL_LOG_SEVERITY_ERROR));
+
+	/* Both levels are stored by the work item. */
+	k_sleep(K_MSEC(10));
+	TEST_ASSERT_NOT_EQUAL(0, kv_writes);
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_init());
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_get_stored(0, module, &level));
+	TEST_ASSERT_EQUAL_STRING(SID_LOG_CONTROL_PROTOCOL_MODULE, module);
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_WARNING, level);
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_log_control_get_stored(1, module, &level));
+	TEST_ASSERT_EQUAL_STRING(ZEPHYR_MODULE, module);
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_ERROR, level);
+}
+
+void test_log_control_storage_error(void)
+{
+	__cmock_sid_pal_storage_kv_record_get_len_StubWithCallback(NULL);
+	__cmock_sid_pal_storage_kv_record_get_len_ExpectAnyArgsAndReturn(
+		SID_ERROR_STORAGE_READ_FAIL);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_STORAGE_READ_FAIL, sid_log_control_init());
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_LEVEL, sid_log_control_get_current_log_level());
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
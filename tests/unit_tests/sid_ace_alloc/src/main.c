@@ -6,14 +6,39 @@
 
 #include <zephyr/ztest.h>
 #include <osal_alloc.h>
+#include <osal_alloc_stats.h>
 #include <ace/ace_status.h>
+#include <errno.h>
+#include <string.h>
 
 typedef struct {
 	uint32_t field32b;
 	uint8_t field8b;
 } test_struct_t;
 
+struct test_allocator_ctx {
+	uint8_t buf[16];
+	uint32_t alloc_cnt;
+	uint32_t free_cnt;
+};
+
 static void *mem[CONFIG_SIDEWALK_HEAP_SIZE];
+static struct test_allocator_ctx test_allocator_ctx;
+
+static void *test_alloc(size_t size, void *ctx)
+{
+	struct test_allocator_ctx *test_ctx = ctx;
+
+	test_ctx->alloc_cnt++;
+	return (size <= sizeof(test_ctx->buf)) ? test_ctx->buf : NULL;
+}
+
+static void test_free(void *p, void *ctx)
+{
+	struct test_allocator_ctx *test_ctx = ctx;
+
+	test_ctx->free_cnt++;
+}
 
 ZTEST(sid_ace_alloc, test_ace_alloc_init_deinit)
 {
@@ -21,12 +46,87 @@ ZTEST(sid_ace_alloc, test_ace_alloc_init_deinit)
 	zassert_equal(ACE_STATUS_OK, aceAlloc_deInit());
 }
 
-ZTEST(sid_ace_alloc, test_ace_alloc_init_with_allocator_not_supported)
+ZTEST(sid_ace_alloc, test_ace_alloc_init_with_allocator_default)
 {
 	aceAlloc_allocator_t *p_allocators = NULL;
 	size_t count = 0;
 
-	zassert_equal(ACE_STATUS_NOT_SUPPORTED, aceAlloc_initWithAllocator(p_allocators, count));
+	zassert_equal(ACE_STATUS_OK, aceAlloc_initWithAllocator(p_allocators, count));
+	zassert_equal(ACE_STATUS_OK, aceAlloc_deInit());
+}
+
+ZTEST(sid_ace_alloc, test_ace_alloc_init_with_allocator_negative)
+{
+	aceAlloc_allocator_t allocator = { .buf_type = ACE_ALLOC_BUFFER_MAX,
+					   .alloc = test_alloc,
+					   .free = test_free };
+
+	zassert_equal(ACE_STATUS_BAD_PARAM, aceAlloc_initWithAllocator(&allocator, 1));
+
+	allocator.buf_type = ACE_ALLOC_BUFFER_NETWORK;
+	allocator.free = NULL;
+	zassert_equal(ACE_STATUS_BAD_PARAM, aceAlloc_initWithAllocator(&allocator, 1));
+
+	zassert_is_null(aceAlloc_alloc(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_MAX, 4));
+}
+
+ZTEST(sid_ace_alloc, test_ace_alloc_init_with_allocator)
+{
+	aceAlloc_allocator_t allocator = { .buf_type = ACE_ALLOC_BUFFER_NETWORK,
+					   .alloc = test_alloc,
+					   .free = test_free,
+					   .ctx = &test_allocator_ctx };
+	void *p;
+
+	memset(&test_allocator_ctx, 0, sizeof(test_allocator_ctx));
+	zassert_equal(ACE_STATUS_OK, aceAlloc_initWithAllocator(&allocator, 1));
+
+	p = aceAlloc_alloc(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_NETWORK, 8);
+	zassert_equal_ptr(test_allocator_ctx.buf, p);
+	aceAlloc_free(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_NETWORK, p);
+	zassert_equal(1, test_allocator_ctx.alloc_cnt);
+	zassert_equal(1, test_allocator_ctx.free_cnt);
+
+	/* Other buffer types keep the default allocator. */
+	p = aceAlloc_alloc(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_GENERIC, 8);
+	zassert_not_null(p);
+	zassert_not_equal(test_allocator_ctx.buf, p);
+	aceAlloc_free(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_GENERIC, p);
+	zassert_equal(1, test_allocator_ctx.alloc_cnt);
+
+	zassert_equal(ACE_STATUS_OK, aceAlloc_deInit());
+	p = aceAlloc_alloc(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_NETWORK, 8);
+	zassert_not_null(p);
+	aceAlloc_free(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_NETWORK, p);
+	zassert_equal(1, test_allocator_ctx.alloc_cnt);
+}
+
+ZTEST(sid_ace_alloc, test_ace_alloc_network_pool)
+{
+	zassert_equal(ACE_STATUS_OK, aceAlloc_init());
+
+	size_t chunk_size = 4;
+	int mem_i_max = 0;
+	void *p;
+
+	for (mem_i_max = 0; mem_i_max < (CONFIG_SIDEWALK_HEAP_SIZE / chunk_size); mem_i_max++) {
+		mem[mem_i_max] =
+			aceAlloc_alloc(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_GENERIC, chunk_size);
+		if (!mem[mem_i_max]) {
+			break;
+		}
+	}
+
+	/* Generic heap is full, network buffers come from their own heap. */
+	p = aceAlloc_alloc(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_NETWORK, chunk_size);
+	zassert_not_null(p);
+	aceAlloc_free(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_NETWORK, p);
+
+	for (int i = 0; i < mem_i_max; i++) {
+		aceAlloc_free(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_GENERIC, mem[i]);
+	}
+
+	zassert_equal(ACE_STATUS_OK, aceAlloc_deInit());
 }
 
 ZTEST(sid_ace_alloc, test_ace_alloc_and_free)
@@ -171,6 +271,51 @@ ZTEST(sid_ace_alloc, test_ace_calloc_full)
 	zassert_equal(ACE_STATUS_OK, aceAlloc_deInit());
 }
 
+ZTEST(sid_ace_alloc, test_ace_alloc_stats)
+{
+	struct sid_memory_stats before;
+	struct sid_memory_stats stats;
+	aceAlloc_allocator_t allocator = { .buf_type = ACE_ALLOC_BUFFER_NETWORK,
+					   .alloc = test_alloc,
+					   .free = test_free,
+					   .ctx = &test_allocator_ctx };
+	void *p;
+
+	zassert_equal(ACE_STATUS_OK, aceAlloc_init());
+	zassert_equal(0, sid_ace_alloc_stats_get(ACE_ALLOC_BUFFER_GENERIC, &before));
+	zassert_equal(CONFIG_SIDEWALK_HEAP_SIZE, before.size);
+	zassert_true(before.largest_free > 0);
+
+	p = aceAlloc_alloc(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_GENERIC, 32);
+	zassert_not_null(p);
+	zassert_equal(0, sid_ace_alloc_stats_get(ACE_ALLOC_BUFFER_GENERIC, &stats));
+	zassert_true(stats.current_bytes >= before.current_bytes + 32);
+	zassert_true(stats.peak_bytes >= stats.current_bytes);
+	zassert_equal(before.alloc_count + 1, stats.alloc_count);
+	zassert_true(stats.largest_free < before.largest_free);
+
+	aceAlloc_free(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_GENERIC, p);
+	zassert_equal(0, sid_ace_alloc_stats_get(ACE_ALLOC_BUFFER_GENERIC, &stats));
+	zassert_equal(before.current_bytes, stats.current_bytes);
+	zassert_equal(before.largest_free, stats.largest_free);
+
+	zassert_is_null(aceAlloc_alloc(ACE_MODULE_GROUP, ACE_ALLOC_BUFFER_GENERIC,
+				       2 * CONFIG_SIDEWALK_HEAP_SIZE));
+	zassert_equal(0, sid_ace_alloc_stats_get(ACE_ALLOC_BUFFER_GENERIC, &stats));
+	zassert_equal(before.failed_count + 1, stats.failed_count);
+
+	/* Network buffers have their own heap. */
+	zassert_equal(0, sid_ace_alloc_stats_get(ACE_ALLOC_BUFFER_NETWORK, &stats));
+	zassert_equal(CONFIG_SIDEWALK_HEAP_NETWORK_SIZE, stats.size);
+
+	zassert_equal(ACE_STATUS_OK, aceAlloc_initWithAllocator(&allocator, 1));
+	zassert_equal(-ENOTSUP, sid_ace_alloc_stats_get(ACE_ALLOC_BUFFER_NETWORK, &stats));
+	zassert_equal(-EINVAL, sid_ace_alloc_stats_get(ACE_ALLOC_BUFFER_MAX, &stats));
+	zassert_equal(-EINVAL, sid_ace_alloc_stats_get(ACE_ALLOC_BUFFER_GENERIC, NULL));
+
+	zassert_equal(ACE_STATUS_OK, aceAlloc_deInit());
+}
+
 ZTEST(sid_ace_alloc, test_sanity)
 {
 	zassert_true(true);
@@ -23,6 +23,7 @@ static int ble_notify_callback_call_cnt = 0;
 static int ble_write_data_callback_call_cnt = 0;
 static int ble_mtu_callback_call_cnt = 0;
 static int ble_adv_start_callback_call_cnt = 0;
+static const sid_ble_link_params_t *ble_link_params;
 
 void setUp(void)
 {
@@ -57,6 +58,11 @@ static void ble_adv_start_callback(void)
 	++ble_adv_start_callback_call_cnt;
 }
 
+static void ble_link_params_callback(const sid_ble_link_params_t *params)
+{
+	ble_link_params = params;
+}
+
 static void ble_connection_callback(bool state, uint8_t *addr)
 {
 	++ble_connection_callback_test.call_cnt;
@@ -207,6 +213,19 @@ void test_sid_ble_adapter_adv_started_pass(void)
 	TEST_ASSERT_EQUAL(1, ble_adv_start_callback_call_cnt);
 }
 
+void test_sid_ble_adapter_link_params_changed(void)
+{
+	sid_ble_link_params_t params = { .interval = 24, .mtu = 247 };
+
+	sid_ble_adapter_link_params_changed(&params);
+	TEST_ASSERT_NULL(ble_link_params);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS, sid_ble_adapter_link_params_cb_set(NULL));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_ble_adapter_link_params_cb_set(ble_link_params_callback));
+	sid_ble_adapter_link_params_changed(&params);
+	TEST_ASSERT_EQUAL_PTR(&params, ble_link_params);
+}
+
 extern int unity_main(void);
 
 int main(void)
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION 30
+#define CONFIG_SIDEWALK_BLE_ADV_POLICY 1
+#define CONFIG_SIDEWALK_BLE_ADV_POLICY_FAST_MIN 5
+#define CONFIG_SIDEWALK_BLE_ADV_POLICY_FAST_MAX 120
+#define CONFIG_SIDEWALK_BLE_ADV_POLICY_BURST 2000
+#define CONFIG_SIDEWALK_BLE_ADV_POLICY_BURST_DUTY 10
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include "kconfig_mock.h"
+
+#include <sid_ble_adv_policy.h>
+
+#define WINDOW_DEFAULT_MS (CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION * 1000)
+#define WINDOW_MIN_MS (CONFIG_SIDEWALK_BLE_ADV_POLICY_FAST_MIN * 1000)
+#define WINDOW_MAX_MS (CONFIG_SIDEWALK_BLE_ADV_POLICY_FAST_MAX * 1000)
+#define BURST_MS (CONFIG_SIDEWALK_BLE_ADV_POLICY_BURST)
+#define BURST_PERIOD_MS (BURST_MS * 100 / CONFIG_SIDEWALK_BLE_ADV_POLICY_BURST_DUTY)
+
+void setUp(void)
+{
+	sid_ble_adv_policy_reset();
+}
+
+/******************************************************************
+* sid_ble_adv_policy
+* ****************************************************************/
+
+void test_adv_policy_default_window(void)
+{
+	struct sid_ble_adv_policy_stats stats;
+
+	TEST_ASSERT_EQUAL(WINDOW_DEFAULT_MS, sid_ble_adv_policy_start(0));
+	sid_ble_adv_policy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.sessions);
+	TEST_ASSERT_EQUAL(WINDOW_DEFAULT_MS, stats.fast_window_ms);
+}
+
+void test_adv_policy_window_follows_connections(void)
+{
+	struct sid_ble_adv_policy_stats stats;
+	uint32_t now = 1000;
+
+	sid_ble_adv_policy_start(now);
+	sid_ble_adv_policy_connected(now + 4000);
+
+	/* The first sample, deviation is half of it. */
+	sid_ble_adv_policy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.fast_connections);
+	TEST_ASSERT_EQUAL(4000, stats.ttc_avg_ms);
+	TEST_ASSERT_EQUAL(2000, stats.ttc_dev_ms);
+	TEST_ASSERT_EQUAL(4000 + 4 * 2000, sid_ble_adv_policy_start(now + 10000));
+
+	/* Stable connections shrink the window down to the minimum. */
+	for (int i = 0; i < 32; i++) {
+		now += 20000;
+		sid_ble_adv_policy_start(now);
+		sid_ble_adv_policy_connected(now + 1000);
+	}
+	TEST_ASSERT_EQUAL(WINDOW_MIN_MS, sid_ble_adv_policy_start(now + 20000));
+}
+
+void test_adv_policy_window_shrinks_without_connections(void)
+{
+	uint32_t window = sid_ble_adv_policy_start(0);
+	uint32_t now = 0;
+
+	for (int i = 0; i < 32; i++) {
+		now += 600000;
+		sid_ble_adv_policy_stopped(now);
+
+		uint32_t next = sid_ble_adv_policy_start(now);
+
+		TEST_ASSERT_LESS_OR_EQUAL(window, next);
+		window = next;
+	}
+	TEST_ASSERT_EQUAL(WINDOW_MIN_MS, window);
+}
+
+void test_adv_policy_late_connection(void)
+{
+	struct sid_ble_adv_policy_stats stats;
+
+	sid_ble_adv_policy_start(0);
+	sid_ble_adv_policy_connected(WINDOW_MAX_MS + 1);
+
+	/* Not a sample of the time-to-connect, but a miss. */
+	sid_ble_adv_policy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.connections);
+	TEST_ASSERT_EQUAL(0, stats.fast_connections);
+	TEST_ASSERT_EQUAL(0, stats.ttc_avg_ms);
+	TEST_ASSERT_LESS_THAN(1000, stats.hit_rate);
+	TEST_ASSERT_LESS_THAN(WINDOW_DEFAULT_MS, sid_ble_adv_policy_start(WINDOW_MAX_MS + 10000));
+}
+
+void test_adv_policy_burst(void)
+{
+	struct sid_ble_adv_policy_stats stats;
+	uint32_t slow = WINDOW_DEFAULT_MS + 1000;
+
+	sid_ble_adv_policy_start(0);
+
+	/* No burst in the fast window and during a burst. */
+	TEST_ASSERT_EQUAL(0, sid_ble_adv_policy_data_updated(1000));
+	TEST_ASSERT_EQUAL(BURST_MS, sid_ble_adv_policy_data_updated(slow));
+	TEST_ASSERT_EQUAL(0, sid_ble_adv_policy_data_updated(slow + BURST_MS / 2));
+
+	/* Duty cycle budget. */
+	TEST_ASSERT_EQUAL(0, sid_ble_adv_policy_data_updated(slow + BURST_PERIOD_MS - 1));
+	TEST_ASSERT_EQUAL(BURST_MS, sid_ble_adv_policy_data_updated(slow + BURST_PERIOD_MS));
+
+	/* A connection in a burst does not size the window. */
+	sid_ble_adv_policy_connected(slow + BURST_PERIOD_MS + 100);
+
+	sid_ble_adv_policy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(5, stats.data_updates);
+	TEST_ASSERT_EQUAL(2, stats.bursts);
+	TEST_ASSERT_EQUAL(1, stats.bursts_suppressed);
+	TEST_ASSERT_EQUAL(1, stats.fast_connections);
+	TEST_ASSERT_EQUAL(0, stats.ttc_avg_ms);
+	TEST_ASSERT_EQUAL(1000, stats.hit_rate);
+
+	/* Not advertising. */
+	TEST_ASSERT_EQUAL(0, sid_ble_adv_policy_data_updated(slow + 2 * BURST_PERIOD_MS));
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
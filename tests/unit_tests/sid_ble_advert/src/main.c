@@ -11,6 +11,7 @@
 
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/conn.h>
+#include <zephyr/kernel.h>
 #include <errno.h>
 
 DEFINE_FFF_GLOBALS;
@@ -187,6 +188,26 @@ void test_sid_ble_advert_update_value(void)
 	check_sid_ble_advert_update(test_data_very_long, sizeof(test_data_very_long));
 }
 
+void test_sid_ble_advert_slow_start_fail(void)
+{
+	uint8_t test_data[] = "Lorem ipsum.";
+	int start_results[] = { ESUCCESS, -ENOMEM, ESUCCESS };
+
+	SET_RETURN_SEQ(bt_le_adv_start, start_results, ARRAY_SIZE(start_results));
+	bt_le_adv_stop_fake.return_val = ESUCCESS;
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+
+	/* The fast advertising is restarted and remains enabled. */
+	k_sleep(K_SECONDS(CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION + 1));
+	TEST_ASSERT_EQUAL(1, bt_le_adv_stop_fake.call_count);
+	TEST_ASSERT_EQUAL(3, bt_le_adv_start_fake.call_count);
+
+	bt_le_adv_update_data_fake.return_val = ESUCCESS;
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_update(test_data, sizeof(test_data)));
+	TEST_ASSERT_EQUAL(1, bt_le_adv_update_data_fake.call_count);
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+}
+
 extern int unity_main(void);
 
 int main(void)
@@ -0,0 +1,8 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define CONFIG_SIDEWALK_BLE_ADV_EXT 1
+#define CONFIG_BT_EXT_ADV_MAX_ADV_SET 2
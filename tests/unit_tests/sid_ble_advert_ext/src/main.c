@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <zephyr/fff.h>
+#include "kconfig_mock.h"
+
+#include <sid_ble_advert.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/kernel.h>
+#include <errno.h>
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, bt_le_ext_adv_create, const struct bt_le_adv_param *,
+		const struct bt_le_ext_adv_cb *, struct bt_le_ext_adv **);
+FAKE_VALUE_FUNC(int, bt_le_ext_adv_start, struct bt_le_ext_adv *,
+		struct bt_le_ext_adv_start_param *);
+FAKE_VALUE_FUNC(int, bt_le_ext_adv_stop, struct bt_le_ext_adv *);
+FAKE_VALUE_FUNC(int, bt_le_ext_adv_delete, struct bt_le_ext_adv *);
+FAKE_VALUE_FUNC(int, bt_le_ext_adv_set_data, struct bt_le_ext_adv *, const struct bt_data *,
+		size_t, const struct bt_data *, size_t);
+
+#define FFF_FAKES_LIST(FAKE)                                                                       \
+	FAKE(bt_le_ext_adv_create)                                                                 \
+	FAKE(bt_le_ext_adv_start)                                                                  \
+	FAKE(bt_le_ext_adv_stop)                                                                   \
+	FAKE(bt_le_ext_adv_delete)                                                                 \
+	FAKE(bt_le_ext_adv_set_data)
+
+#define ESUCCESS (0)
+#define TRANSITION_TIMEOUT K_SECONDS(CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION + 1)
+
+struct bt_le_ext_adv {
+	uint8_t dummy;
+};
+
+/* Sets are created on start, the fast one first, and deleted on stop. */
+static struct bt_le_ext_adv test_sets[2];
+static size_t test_sets_created;
+static const struct bt_le_ext_adv_cb *test_adv_cb;
+
+static int test_adv_create(const struct bt_le_adv_param *param, const struct bt_le_ext_adv_cb *cb,
+			   struct bt_le_ext_adv **adv)
+{
+	TEST_ASSERT_LESS_THAN(ARRAY_SIZE(test_sets), test_sets_created);
+	*adv = &test_sets[test_sets_created++];
+	test_adv_cb = cb;
+
+	return ESUCCESS;
+}
+
+void setUp(void)
+{
+	FFF_FAKES_LIST(RESET_FAKE);
+	FFF_RESET_HISTORY();
+	bt_le_ext_adv_create_fake.custom_fake = test_adv_create;
+}
+
+void tearDown(void)
+{
+	/* The sets are released, the next test creates them again. */
+	FFF_FAKES_LIST(RESET_FAKE);
+	sid_ble_advert_deinit();
+	test_sets_created = 0;
+}
+
+void test_sid_ble_advert_ext_start(void)
+{
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(test_sets), test_sets_created);
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(test_sets), bt_le_ext_adv_set_data_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_start_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(&test_sets[0], bt_le_ext_adv_start_fake.arg0_val);
+
+	/* The sets are reused while advertising. */
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(test_sets), test_sets_created);
+
+	/* The host forgets the sets on bt_disable(), they are deleted on stop. */
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(test_sets), bt_le_ext_adv_delete_fake.call_count);
+
+	test_sets_created = 0;
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(test_sets), test_sets_created);
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+}
+
+void test_sid_ble_advert_ext_start_fail(void)
+{
+	bt_le_ext_adv_start_fake.return_val = -ENOMEM;
+	TEST_ASSERT_EQUAL(-ENOMEM, sid_ble_advert_start());
+
+	k_sleep(TRANSITION_TIMEOUT);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_start_fake.call_count);
+}
+
+void test_sid_ble_advert_ext_interval_change(void)
+{
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	RESET_FAKE(bt_le_ext_adv_stop);
+	FFF_RESET_HISTORY();
+
+	/* The slow set starts before the fast one stops. */
+	k_sleep(TRANSITION_TIMEOUT);
+	TEST_ASSERT_EQUAL(2, fff.call_history_idx);
+	TEST_ASSERT_EQUAL_PTR(bt_le_ext_adv_start, fff.call_history[0]);
+	TEST_ASSERT_EQUAL_PTR(&test_sets[1], bt_le_ext_adv_start_fake.arg0_val);
+	TEST_ASSERT_EQUAL_PTR(bt_le_ext_adv_stop, fff.call_history[1]);
+	TEST_ASSERT_EQUAL_PTR(&test_sets[0], bt_le_ext_adv_stop_fake.arg0_val);
+
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+	TEST_ASSERT_EQUAL(3, bt_le_ext_adv_stop_fake.call_count);
+}
+
+void test_sid_ble_advert_ext_interval_change_fail(void)
+{
+	int start_results[] = { ESUCCESS, -ENOMEM, ESUCCESS };
+
+	SET_RETURN_SEQ(bt_le_ext_adv_start, start_results, ARRAY_SIZE(start_results));
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	RESET_FAKE(bt_le_ext_adv_stop);
+
+	/* The fast set keeps advertising, the change is retried. */
+	k_sleep(TRANSITION_TIMEOUT);
+	TEST_ASSERT_EQUAL(2, bt_le_ext_adv_start_fake.call_count);
+	TEST_ASSERT_EQUAL(0, bt_le_ext_adv_stop_fake.call_count);
+
+	k_sleep(TRANSITION_TIMEOUT);
+	TEST_ASSERT_EQUAL(3, bt_le_ext_adv_start_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_stop_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(&test_sets[0], bt_le_ext_adv_stop_fake.arg0_val);
+
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+}
+
+void test_sid_ble_advert_ext_connected(void)
+{
+	struct bt_le_ext_adv_connected_info info = { 0 };
+	uint8_t test_data[] = "Lorem ipsum.";
+
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	TEST_ASSERT_NOT_NULL(test_adv_cb);
+	RESET_FAKE(bt_le_ext_adv_stop);
+	RESET_FAKE(bt_le_ext_adv_set_data);
+
+	/* The other set is stopped and the interval change is cancelled. */
+	test_adv_cb->connected(&test_sets[0], &info);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_stop_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(&test_sets[1], bt_le_ext_adv_stop_fake.arg0_val);
+
+	k_sleep(TRANSITION_TIMEOUT);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_start_fake.call_count);
+
+	/* The data is applied at the next start. */
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_update(test_data, sizeof(test_data)));
+	TEST_ASSERT_EQUAL(0, bt_le_ext_adv_set_data_fake.call_count);
+}
+
+static int start_connected_fake(struct bt_le_ext_adv *adv, struct bt_le_ext_adv_start_param *param)
+{
+	struct bt_le_ext_adv_connected_info info = { 0 };
+
+	/* The fast set gets connected while the slow one is started. */
+	if (adv == &test_sets[1]) {
+		test_adv_cb->connected(&test_sets[0], &info);
+	}
+
+	return ESUCCESS;
+}
+
+void test_sid_ble_advert_ext_connected_during_change(void)
+{
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	RESET_FAKE(bt_le_ext_adv_stop);
+	bt_le_ext_adv_start_fake.custom_fake = start_connected_fake;
+
+	/* The slow set started by the interval change is stopped again, the connected set is
+	 * left to the host.
+	 */
+	k_sleep(TRANSITION_TIMEOUT);
+	TEST_ASSERT_EQUAL(2, bt_le_ext_adv_start_fake.call_count);
+	TEST_ASSERT_EQUAL(2, bt_le_ext_adv_stop_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(&test_sets[1], bt_le_ext_adv_stop_fake.arg0_history[0]);
+	TEST_ASSERT_EQUAL_PTR(&test_sets[1], bt_le_ext_adv_stop_fake.arg0_history[1]);
+}
+
+void test_sid_ble_advert_ext_update(void)
+{
+	uint8_t test_data[] = "Lorem ipsum.";
+
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	RESET_FAKE(bt_le_ext_adv_set_data);
+
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_update(test_data, sizeof(test_data)));
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(test_sets), bt_le_ext_adv_set_data_fake.call_count);
+
+	bt_le_ext_adv_set_data_fake.return_val = -EIO;
+	TEST_ASSERT_EQUAL(-EIO, sid_ble_advert_update(test_data, sizeof(test_data)));
+	TEST_ASSERT_EQUAL(-EINVAL, sid_ble_advert_update(NULL, sizeof(test_data)));
+
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+}
+
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define CONFIG_BT_USER_DATA_LEN_UPDATE 1
+#define CONFIG_BT_USER_PHY_UPDATE 1
+#define CONFIG_BT_GATT_CLIENT 1
+#define CONFIG_SIDEWALK_BLE_LINK_DATA_LEN 1
+#define CONFIG_SIDEWALK_BLE_LINK_PHY_2M 1
+#define CONFIG_SIDEWALK_BLE_LINK_MTU 1
+#define CONFIG_SIDEWALK_BLE_LINK_INTERVAL_MIN 6
+#define CONFIG_SIDEWALK_BLE_LINK_INTERVAL_MAX 12
+#define CONFIG_SIDEWALK_BLE_LINK_LATENCY 0
+#define CONFIG_SIDEWALK_BLE_LINK_TIMEOUT 400
+#define CONFIG_SIDEWALK_BLE_LINK_STEP_TIMEOUT_MS 50
+#define CONFIG_BT_MAX_CONN 2
+#define CONFIG_SIDEWALK_BLE_CONN_SWITCH_HOLDOFF_MS 20
+#define CONFIG_SIDEWALK_BLE_RX_DEFERRED 1
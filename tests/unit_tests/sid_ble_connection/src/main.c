@@ -5,13 +5,16 @@
  */
 #include <unity.h>
 #include <zephyr/fff.h>
+#include "kconfig_mock.h"
 
 #include <sid_ble_connection.h>
+#include <sid_ble_rx.h>
 
 #include <cmock_sid_ble_adapter_callbacks.h>
 
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/gatt.h>
+#include <zephyr/kernel.h>
 
 #include <stdbool.h>
 #include <errno.h>
@@ -24,6 +27,15 @@ FAKE_VALUE_FUNC(struct bt_conn *, bt_conn_ref, struct bt_conn *);
 FAKE_VOID_FUNC(bt_conn_unref, struct bt_conn *);
 FAKE_VALUE_FUNC(const bt_addr_le_t *, bt_conn_get_dst, const struct bt_conn *);
 FAKE_VALUE_FUNC(int, bt_conn_disconnect, struct bt_conn *, uint8_t);
+FAKE_VALUE_FUNC(int, bt_conn_get_info, const struct bt_conn *, struct bt_conn_info *);
+FAKE_VALUE_FUNC(int, bt_conn_le_data_len_update, struct bt_conn *,
+		const struct bt_conn_le_data_len_param *);
+FAKE_VALUE_FUNC(int, bt_conn_le_phy_update, struct bt_conn *, const struct bt_conn_le_phy_param *);
+FAKE_VALUE_FUNC(int, bt_conn_le_param_update, struct bt_conn *, const struct bt_le_conn_param *);
+FAKE_VALUE_FUNC(int, bt_gatt_exchange_mtu, struct bt_conn *, struct bt_gatt_exchange_params *);
+FAKE_VALUE_FUNC(uint16_t, bt_gatt_get_mtu, struct bt_conn *);
+FAKE_VALUE_FUNC(uint8_t, bt_conn_index, const struct bt_conn *);
+FAKE_VOID_FUNC(sid_ble_rx_conn_flush, struct bt_conn *);
 
 #define FFF_FAKES_LIST(FAKE)                                                                       \
 	FAKE(bt_conn_cb_register)                                                                  \
@@ -31,11 +43,21 @@ FAKE_VALUE_FUNC(int, bt_conn_disconnect, struct bt_conn *, uint8_t);
 	FAKE(bt_conn_ref)                                                                          \
 	FAKE(bt_conn_unref)                                                                        \
 	FAKE(bt_conn_get_dst)                                                                      \
-	FAKE(bt_conn_disconnect)
+	FAKE(bt_conn_disconnect)                                                                   \
+	FAKE(bt_conn_get_info)                                                                     \
+	FAKE(bt_conn_le_data_len_update)                                                           \
+	FAKE(bt_conn_le_phy_update)                                                                \
+	FAKE(bt_conn_le_param_update)                                                              \
+	FAKE(bt_gatt_exchange_mtu)                                                                 \
+	FAKE(bt_gatt_get_mtu)                                                                      \
+	FAKE(bt_conn_index)                                                                        \
+	FAKE(sid_ble_rx_conn_flush)
 
 #define CONNECTED (true)
 #define DISCONNECTED (false)
 #define ESUCCESS (0)
+#define LINK_STEP_TIMEOUT K_MSEC(CONFIG_SIDEWALK_BLE_LINK_STEP_TIMEOUT_MS + 10)
+#define SWITCH_HOLDOFF K_MSEC(CONFIG_SIDEWALK_BLE_CONN_SWITCH_HOLDOFF_MS + 1)
 
 struct bt_conn {
 	uint8_t dummy;
@@ -50,12 +72,14 @@ typedef struct {
 static connection_callback_test_t conn_cb_test;
 static struct bt_conn_cb *sid_bt_conn_cb;
 static struct bt_gatt_cb *sid_bt_gatt_cb;
+static sid_ble_link_params_t link_params_reported;
 
 void setUp(void)
 {
 	FFF_FAKES_LIST(RESET_FAKE);
 	FFF_RESET_HISTORY();
 	memset(&conn_cb_test, 0x00, sizeof(conn_cb_test));
+	memset(&link_params_reported, 0x00, sizeof(link_params_reported));
 	cmock_sid_ble_adapter_callbacks_Init();
 }
 
@@ -70,6 +94,22 @@ static void connection_callback(const uint8_t *ble_addr, int cmock_num_calls)
 	conn_cb_test.addr = (uint8_t *)ble_addr;
 }
 
+static void link_params_callback(const sid_ble_link_params_t *params, int cmock_num_calls)
+{
+	link_params_reported = *params;
+}
+
+static void link_connect(struct bt_conn *conn)
+{
+	bt_conn_ref_fake.return_val = conn;
+	bt_gatt_get_mtu_fake.return_val = 247;
+
+	sid_ble_conn_init();
+	__cmock_sid_ble_adapter_conn_connected_ExpectAnyArgs();
+	sid_bt_conn_cb->connected(conn, BT_HCI_ERR_SUCCESS);
+	k_sleep(K_MSEC(1));
+}
+
 void test_sid_ble_conn_init(void)
 {
 	sid_ble_conn_init();
@@ -290,6 +330,401 @@ void test_sid_ble_conn_disconnect(void)
 	TEST_ASSERT_NOT_EQUAL(ESUCCESS, sid_ble_conn_disconnect());
 }
 
+void test_sid_ble_conn_disconnect_not_connected(void)
+{
+	struct bt_conn test_conn = { .dummy = 0xDC };
+
+	link_connect(&test_conn);
+	__cmock_sid_ble_adapter_conn_disconnected_ExpectAnyArgs();
+	sid_bt_conn_cb->disconnected(&test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+
+	TEST_ASSERT_EQUAL(-ENOENT, sid_ble_conn_disconnect());
+	TEST_ASSERT_EQUAL(0, bt_conn_disconnect_fake.call_count);
+}
+
+void test_sid_ble_conn_link_negotiation(void)
+{
+	struct bt_conn test_conn = { .dummy = 0xDC };
+	struct bt_conn_le_data_len_info data_len = {
+		.tx_max_len = 251, .tx_max_time = 2120, .rx_max_len = 251, .rx_max_time = 2120
+	};
+	struct bt_conn_le_phy_info phy = { .tx_phy = BT_GAP_LE_PHY_2M, .rx_phy = BT_GAP_LE_PHY_2M };
+
+	bt_conn_get_info_fake.return_val = -ENOTCONN;
+	link_connect(&test_conn);
+	TEST_ASSERT_EQUAL(1, bt_conn_le_data_len_update_fake.call_count);
+	TEST_ASSERT_EQUAL(0, bt_conn_le_phy_update_fake.call_count);
+
+	/* Events of an other connection are ignored. */
+	sid_bt_conn_cb->le_data_len_updated(NULL, &data_len);
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(0, bt_conn_le_phy_update_fake.call_count);
+
+	sid_bt_conn_cb->le_data_len_updated(&test_conn, &data_len);
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(1, bt_conn_le_phy_update_fake.call_count);
+	TEST_ASSERT_EQUAL(0, bt_gatt_exchange_mtu_fake.call_count);
+
+	sid_bt_conn_cb->le_phy_updated(&test_conn, &phy);
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(1, bt_gatt_exchange_mtu_fake.call_count);
+	TEST_ASSERT_EQUAL(0, bt_conn_le_param_update_fake.call_count);
+
+	bt_gatt_exchange_mtu_fake.arg1_val->func(&test_conn, 0, bt_gatt_exchange_mtu_fake.arg1_val);
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(1, bt_conn_le_param_update_fake.call_count);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_LINK_INTERVAL_MIN,
+			  bt_conn_le_param_update_fake.arg1_val->interval_min);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_LINK_INTERVAL_MAX,
+			  bt_conn_le_param_update_fake.arg1_val->interval_max);
+
+	__cmock_sid_ble_adapter_link_params_changed_StubWithCallback(link_params_callback);
+	__cmock_sid_ble_adapter_link_params_changed_ExpectAnyArgs();
+	sid_bt_conn_cb->le_param_updated(&test_conn, 9, 0, 400);
+	k_sleep(K_MSEC(1));
+
+	TEST_ASSERT_EQUAL(9, link_params_reported.interval);
+	TEST_ASSERT_EQUAL(400, link_params_reported.timeout);
+	TEST_ASSERT_EQUAL(247, link_params_reported.mtu);
+	TEST_ASSERT_EQUAL(251, link_params_reported.tx_max_len);
+	TEST_ASSERT_EQUAL(251, link_params_reported.rx_max_len);
+	TEST_ASSERT_EQUAL(BT_GAP_LE_PHY_2M, link_params_reported.tx_phy);
+	TEST_ASSERT_EQUAL(BT_GAP_LE_PHY_2M, link_params_reported.rx_phy);
+
+	__cmock_sid_ble_adapter_conn_disconnected_ExpectAnyArgs();
+	sid_bt_conn_cb->disconnected(&test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+}
+
+void test_sid_ble_conn_link_negotiation_skip(void)
+{
+	struct bt_conn test_conn = { .dummy = 0xDC };
+
+	bt_conn_get_info_fake.return_val = -ENOTCONN;
+	bt_conn_le_data_len_update_fake.return_val = -EIO;
+	bt_conn_le_phy_update_fake.return_val = -ENOTSUP;
+	bt_conn_le_param_update_fake.return_val = -EALREADY;
+
+	/* Rejected procedures are skipped, the MTU exchange does not complete. */
+	link_connect(&test_conn);
+	TEST_ASSERT_EQUAL(1, bt_conn_le_data_len_update_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_conn_le_phy_update_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_gatt_exchange_mtu_fake.call_count);
+	TEST_ASSERT_EQUAL(0, bt_conn_le_param_update_fake.call_count);
+
+	__cmock_sid_ble_adapter_link_params_changed_ExpectAnyArgs();
+	k_sleep(LINK_STEP_TIMEOUT);
+	TEST_ASSERT_EQUAL(1, bt_conn_le_param_update_fake.call_count);
+
+	__cmock_sid_ble_adapter_conn_disconnected_ExpectAnyArgs();
+	sid_bt_conn_cb->disconnected(&test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+}
+
+void test_sid_ble_conn_link_negotiation_disconnected(void)
+{
+	struct bt_conn test_conn = { .dummy = 0xDC };
+
+	bt_conn_get_info_fake.return_val = -ENOTCONN;
+	link_connect(&test_conn);
+	TEST_ASSERT_EQUAL(1, bt_conn_le_data_len_update_fake.call_count);
+
+	__cmock_sid_ble_adapter_conn_disconnected_ExpectAnyArgs();
+	sid_bt_conn_cb->disconnected(&test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+
+	k_sleep(LINK_STEP_TIMEOUT);
+	TEST_ASSERT_EQUAL(0, bt_conn_le_phy_update_fake.call_count);
+	TEST_ASSERT_EQUAL(0, bt_conn_le_param_update_fake.call_count);
+}
+
+static struct bt_conn test_conns[2];
+
+static uint8_t test_conn_index(const struct bt_conn *conn)
+{
+	return (uint8_t)(conn - test_conns);
+}
+
+static struct bt_conn *test_conn_ref(struct bt_conn *conn)
+{
+	return conn;
+}
+
+void test_sid_ble_conn_multiple(void)
+{
+	const sid_ble_conn_params_t *params;
+
+	sid_ble_conn_init();
+	bt_conn_index_fake.custom_fake = test_conn_index;
+	bt_conn_ref_fake.custom_fake = test_conn_ref;
+	bt_conn_get_info_fake.return_val = -ENOTCONN;
+	bt_conn_le_data_len_update_fake.return_val = -ENOTSUP;
+	bt_gatt_exchange_mtu_fake.return_val = -ENOTSUP;
+	bt_conn_le_phy_update_fake.return_val = -ENOTSUP;
+	bt_conn_le_param_update_fake.return_val = -ENOTSUP;
+	__cmock_sid_ble_adapter_link_params_changed_Ignore();
+
+	__cmock_sid_ble_adapter_conn_connected_ExpectAnyArgs();
+	sid_bt_conn_cb->connected(&test_conns[0], BT_HCI_ERR_SUCCESS);
+	__cmock_sid_ble_adapter_mtu_changed_Expect(100);
+	sid_bt_gatt_cb->att_mtu_updated(&test_conns[0], 100, 100);
+
+	/* The second peer does not take over the active connection, it is not reported. */
+	sid_bt_conn_cb->connected(&test_conns[1], BT_HCI_ERR_SUCCESS);
+	sid_bt_gatt_cb->att_mtu_updated(&test_conns[1], 200, 247);
+	k_sleep(K_MSEC(1));
+
+	params = sid_ble_conn_params_get();
+	TEST_ASSERT_EQUAL_PTR(&test_conns[0], params->conn);
+	TEST_ASSERT_EQUAL(200, sid_ble_conn_params_find(&test_conns[1])->mtu);
+	TEST_ASSERT_NULL(sid_ble_conn_params_find(NULL));
+
+	/* The first peer is not idle yet, data from the second one is refused. */
+	TEST_ASSERT_TRUE(sid_ble_conn_rx(&test_conns[0]));
+	TEST_ASSERT_FALSE(sid_ble_conn_rx(&test_conns[1]));
+	TEST_ASSERT_EQUAL_PTR(&test_conns[0], sid_ble_conn_params_get()->conn);
+
+	/* Data from the second peer after the hold-off routes the Sidewalk data to it, the
+	 * protocol sees the first link closed and the second one opened.
+	 */
+	k_sleep(SWITCH_HOLDOFF);
+	__cmock_sid_ble_adapter_conn_disconnected_ExpectAnyArgs();
+	__cmock_sid_ble_adapter_conn_connected_ExpectAnyArgs();
+	__cmock_sid_ble_adapter_mtu_changed_Expect(200);
+	TEST_ASSERT_TRUE(sid_ble_conn_rx(&test_conns[1]));
+	TEST_ASSERT_EQUAL_PTR(&test_conns[1], sid_ble_conn_params_get()->conn);
+	TEST_ASSERT_TRUE(sid_ble_conn_rx(&test_conns[1]));
+	TEST_ASSERT_FALSE(sid_ble_conn_rx(&test_conns[0]));
+
+	bt_conn_disconnect_fake.return_val = ESUCCESS;
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_conn_disconnect());
+	TEST_ASSERT_EQUAL_PTR(&test_conns[1], bt_conn_disconnect_fake.arg0_val);
+
+	/* The remaining connection becomes active. */
+	__cmock_sid_ble_adapter_conn_disconnected_ExpectAnyArgs();
+	__cmock_sid_ble_adapter_conn_connected_ExpectAnyArgs();
+	__cmock_sid_ble_adapter_mtu_changed_Expect(100);
+	sid_bt_conn_cb->disconnected(&test_conns[1], BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	TEST_ASSERT_EQUAL_PTR(&test_conns[0], sid_ble_conn_params_get()->conn);
+	TEST_ASSERT_NULL(sid_ble_conn_params_find(&test_conns[1]));
+
+	__cmock_sid_ble_adapter_conn_disconnected_ExpectAnyArgs();
+	sid_bt_conn_cb->disconnected(&test_conns[0], BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	TEST_ASSERT_NULL(sid_ble_conn_params_get()->conn);
+}
+
+void test_sid_ble_conn_multiple_inactive_disconnect(void)
+{
+	sid_ble_conn_init();
+	bt_conn_index_fake.custom_fake = test_conn_index;
+	bt_conn_ref_fake.custom_fake = test_conn_ref;
+	bt_conn_get_info_fake.return_val = -ENOTCONN;
+	bt_conn_le_data_len_update_fake.return_val = -ENOTSUP;
+	bt_gatt_exchange_mtu_fake.return_val = -ENOTSUP;
+	bt_conn_le_phy_update_fake.return_val = -ENOTSUP;
+	bt_conn_le_param_update_fake.return_val = -ENOTSUP;
+	__cmock_sid_ble_adapter_link_params_changed_Ignore();
+
+	__cmock_sid_ble_adapter_conn_connected_ExpectAnyArgs();
+	sid_bt_conn_cb->connected(&test_conns[0], BT_HCI_ERR_SUCCESS);
+	sid_bt_conn_cb->connected(&test_conns[1], BT_HCI_ERR_SUCCESS);
+	k_sleep(K_MSEC(1));
+
+	/* The protocol does not see the other peer leave, the active link stays. */
+	sid_bt_conn_cb->disconnected(&test_conns[1], BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	TEST_ASSERT_EQUAL_PTR(&test_conns[0], sid_ble_conn_params_get()->conn);
+	TEST_ASSERT_NULL(sid_ble_conn_params_find(&test_conns[1]));
+
+	__cmock_sid_ble_adapter_conn_disconnected_ExpectAnyArgs();
+	sid_bt_conn_cb->disconnected(&test_conns[0], BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	TEST_ASSERT_NULL(sid_ble_conn_params_get()->conn);
+}
+
+static unsigned int flushed_before_disconnected;
+
+static void flush_check_callback(const uint8_t *ble_addr, int cmock_num_calls)
+{
+	flushed_before_disconnected = sid_ble_rx_conn_flush_fake.call_count;
+}
+
+void test_sid_ble_conn_switch_flushes_pending_rx(void)
+{
+	sid_ble_conn_init();
+	bt_conn_index_fake.custom_fake = test_conn_index;
+	bt_conn_ref_fake.custom_fake = test_conn_ref;
+	bt_conn_get_info_fake.return_val = -ENOTCONN;
+	bt_conn_le_data_len_update_fake.return_val = -ENOTSUP;
+	bt_gatt_exchange_mtu_fake.return_val = -ENOTSUP;
+	bt_conn_le_phy_update_fake.return_val = -ENOTSUP;
+	bt_conn_le_param_update_fake.return_val = -ENOTSUP;
+	__cmock_sid_ble_adapter_link_params_changed_Ignore();
+	__cmock_sid_ble_adapter_mtu_changed_Ignore();
+
+	__cmock_sid_ble_adapter_conn_connected_ExpectAnyArgs();
+	sid_bt_conn_cb->connected(&test_conns[0], BT_HCI_ERR_SUCCESS);
+	sid_bt_conn_cb->connected(&test_conns[1], BT_HCI_ERR_SUCCESS);
+	TEST_ASSERT_TRUE(sid_ble_conn_rx(&test_conns[0]));
+	TEST_ASSERT_EQUAL(0, sid_ble_rx_conn_flush_fake.call_count);
+
+	/* Records of the first peer still queued are flushed before it is reported closed. */
+	k_sleep(SWITCH_HOLDOFF);
+	flushed_before_disconnected = 0;
+	__cmock_sid_ble_adapter_conn_disconnected_StubWithCallback(flush_check_callback);
+	__cmock_sid_ble_adapter_conn_connected_ExpectAnyArgs();
+	TEST_ASSERT_TRUE(sid_ble_conn_rx(&test_conns[1]));
+	TEST_ASSERT_EQUAL(1, flushed_before_disconnected);
+	TEST_ASSERT_EQUAL_PTR(&test_conns[0], sid_ble_rx_conn_flush_fake.arg0_val);
+	TEST_ASSERT_EQUAL(bt_conn_ref_fake.call_count - 2, bt_conn_unref_fake.call_count);
+
+	sid_bt_conn_cb->disconnected(&test_conns[0], BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	sid_bt_conn_cb->disconnected(&test_conns[1], BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	TEST_ASSERT_NULL(sid_ble_conn_params_get()->conn);
+}
+
+#define STRESS_CYCLES (200)
+#define STRESS_SENDS (1000)
+#define STRESS_STACK_SIZE (2048)
+
+K_THREAD_STACK_DEFINE(stress_stack, STRESS_STACK_SIZE);
+static struct k_thread stress_thread;
+
+/* References of the test connections as the host counts them. */
+static atomic_t stress_refs[ARRAY_SIZE(test_conns)];
+/* Incremented when a connection object is reused for a new connection. */
+static atomic_t stress_generation[ARRAY_SIZE(test_conns)];
+static atomic_t stress_errors;
+
+static struct bt_conn *stress_conn_ref(struct bt_conn *conn)
+{
+	atomic_t *ref = &stress_refs[test_conn_index(conn)];
+	atomic_val_t old;
+
+	/* Let the other thread run between the load of the connection and its reference. */
+	k_yield();
+
+	/* As the host does, a released connection is not referenced again. */
+	do {
+		old = atomic_get(ref);
+		if (!old) {
+			return NULL;
+		}
+	} while (!atomic_cas(ref, old, old + 1));
+
+	return conn;
+}
+
+static void stress_conn_unref(struct bt_conn *conn)
+{
+	if (atomic_dec(&stress_refs[test_conn_index(conn)]) <= 0) {
+		atomic_inc(&stress_errors);
+	}
+}
+
+static void stress_connect(struct bt_conn *conn)
+{
+	uint8_t index = test_conn_index(conn);
+
+	/* The host reuses a connection object only when it is released. */
+	while (atomic_get(&stress_refs[index])) {
+		k_yield();
+	}
+	atomic_inc(&stress_generation[index]);
+	atomic_inc(&stress_refs[index]);
+
+	sid_bt_conn_cb->connected(conn, BT_HCI_ERR_SUCCESS);
+}
+
+static void stress_disconnect(struct bt_conn *conn)
+{
+	sid_bt_conn_cb->disconnected(conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	/* The host drops its reference when the callbacks return. */
+	stress_conn_unref(conn);
+}
+
+static void stress_thread_fn(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < STRESS_CYCLES; i++) {
+		if (i % 2) {
+			stress_connect(&test_conns[1]);
+			k_yield();
+			stress_disconnect(&test_conns[1]);
+			k_yield();
+			continue;
+		}
+
+		/* Both peers connected, the active one is replaced on its disconnection. */
+		stress_connect(&test_conns[0]);
+		k_yield();
+		stress_connect(&test_conns[1]);
+		k_yield();
+		stress_disconnect(&test_conns[0]);
+		k_yield();
+		stress_disconnect(&test_conns[1]);
+		k_yield();
+	}
+}
+
+void test_sid_ble_conn_active_ref_stress(void)
+{
+	uint32_t sends = 0;
+	uint32_t not_connected = 0;
+
+	sid_ble_conn_init();
+	TEST_ASSERT_NULL(sid_ble_conn_active_ref());
+
+	bt_conn_index_fake.custom_fake = test_conn_index;
+	bt_conn_ref_fake.custom_fake = stress_conn_ref;
+	bt_conn_unref_fake.custom_fake = stress_conn_unref;
+	bt_conn_get_info_fake.return_val = -ENOTCONN;
+	bt_conn_le_data_len_update_fake.return_val = -ENOTSUP;
+	bt_gatt_exchange_mtu_fake.return_val = -ENOTSUP;
+	bt_conn_le_phy_update_fake.return_val = -ENOTSUP;
+	bt_conn_le_param_update_fake.return_val = -ENOTSUP;
+	__cmock_sid_ble_adapter_conn_connected_Ignore();
+	__cmock_sid_ble_adapter_conn_disconnected_Ignore();
+	__cmock_sid_ble_adapter_mtu_changed_Ignore();
+	__cmock_sid_ble_adapter_link_params_changed_Ignore();
+	atomic_clear(&stress_errors);
+	for (size_t i = 0; i < ARRAY_SIZE(test_conns); i++) {
+		atomic_clear(&stress_refs[i]);
+	}
+
+	k_thread_create(&stress_thread, stress_stack, K_THREAD_STACK_SIZEOF(stress_stack),
+			stress_thread_fn, NULL, NULL, NULL, k_thread_priority_get(k_current_get()),
+			0, K_NO_WAIT);
+
+	/* Sends race with the connections and disconnections. */
+	for (int i = 0; i < STRESS_SENDS; i++) {
+		struct bt_conn *conn = sid_ble_conn_active_ref();
+		uint8_t index;
+		atomic_val_t generation;
+
+		if (!conn) {
+			not_connected++;
+			k_yield();
+			continue;
+		}
+
+		index = test_conn_index(conn);
+		generation = atomic_get(&stress_generation[index]);
+		TEST_ASSERT_GREATER_THAN(0, atomic_get(&stress_refs[index]));
+
+		/* The connection is not reused while the send holds it. */
+		k_yield();
+		TEST_ASSERT_EQUAL(generation, atomic_get(&stress_generation[index]));
+		bt_conn_unref(conn);
+		sends++;
+	}
+
+	TEST_ASSERT_EQUAL(0, k_thread_join(&stress_thread, K_FOREVER));
+	k_sleep(K_MSEC(1));
+
+	TEST_ASSERT_GREATER_THAN(0, sends);
+	TEST_ASSERT_GREATER_THAN(0, not_connected);
+	TEST_ASSERT_EQUAL(0, atomic_get(&stress_errors));
+	TEST_ASSERT_NULL(sid_ble_conn_active_ref());
+	for (size_t i = 0; i < ARRAY_SIZE(test_conns); i++) {
+		TEST_ASSERT_EQUAL(0, atomic_get(&stress_refs[i]));
+	}
+}
+
 extern int unity_main(void);
 
 int main(void)
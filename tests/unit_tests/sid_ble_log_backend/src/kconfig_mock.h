@@ -0,0 +1,9 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define CONFIG_BT_L2CAP_TX_MTU 247
+#define CONFIG_SIDEWALK_LOG_BACKEND_BLE_RECORD_SIZE 96
+#define CONFIG_SIDEWALK_LOG_BACKEND_BLE_TX_CREDITS 2
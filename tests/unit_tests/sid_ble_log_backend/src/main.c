@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <zephyr/fff.h>
+#include "kconfig_mock.h"
+
+#include <sid_ble_log_backend.h>
+#include <sid_ble_log_service.h>
+#include <sid_ble_connection.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <string.h>
+
+LOG_MODULE_REGISTER(test_ble_log, LOG_LEVEL_INF);
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(uint16_t, bt_gatt_get_mtu, struct bt_conn *);
+FAKE_VALUE_FUNC(bool, bt_gatt_is_subscribed, struct bt_conn *, const struct bt_gatt_attr *,
+		uint16_t);
+FAKE_VALUE_FUNC(int, bt_gatt_notify_cb, struct bt_conn *, struct bt_gatt_notify_params *);
+FAKE_VALUE_FUNC(struct bt_gatt_attr *, bt_gatt_find_by_uuid, const struct bt_gatt_attr *, uint16_t,
+		const struct bt_uuid *);
+FAKE_VALUE_FUNC(struct bt_conn *, sid_ble_conn_active_ref);
+FAKE_VOID_FUNC(bt_conn_unref, struct bt_conn *);
+FAKE_VALUE_FUNC(const struct bt_gatt_service_static *, sid_ble_get_log_service);
+
+#define FFF_FAKES_LIST(FAKE)                                                                       \
+	FAKE(bt_gatt_get_mtu)                                                                      \
+	FAKE(bt_gatt_is_subscribed)                                                                \
+	FAKE(bt_gatt_notify_cb)                                                                    \
+	FAKE(bt_gatt_find_by_uuid)                                                                 \
+	FAKE(sid_ble_conn_active_ref)                                                              \
+	FAKE(bt_conn_unref)                                                                        \
+	FAKE(sid_ble_get_log_service)
+
+#define TEST_MTU (128)
+#define NOTIFICATIONS_MAX (8)
+
+struct bt_conn {
+	uint8_t dummy;
+};
+
+struct notification {
+	uint8_t data[TEST_MTU];
+	uint16_t len;
+	bt_gatt_complete_func_t func;
+};
+
+static struct bt_conn conn;
+static struct bt_gatt_attr notify_attr;
+static struct bt_gatt_service_static log_service;
+
+static struct notification notifications[NOTIFICATIONS_MAX];
+static size_t notifications_cnt;
+static size_t notifications_done;
+
+static int notify_cb_fake(struct bt_conn *conn, struct bt_gatt_notify_params *params)
+{
+	struct notification *notification = &notifications[notifications_cnt++];
+
+	TEST_ASSERT_LESS_OR_EQUAL(NOTIFICATIONS_MAX, notifications_cnt);
+	TEST_ASSERT_LESS_OR_EQUAL(TEST_MTU - 3, params->len);
+	memcpy(notification->data, params->data, params->len);
+	notification->len = params->len;
+	notification->func = params->func;
+
+	return 0;
+}
+
+static void notifications_complete(void)
+{
+	while (notifications_done < notifications_cnt) {
+		notifications[notifications_done++].func(&conn, NULL);
+		/* Let the flush work run. */
+		k_sleep(K_MSEC(1));
+	}
+}
+
+static size_t records_count(const struct notification *notification, uint8_t type)
+{
+	size_t count = 0;
+
+	for (size_t offset = 0; offset < notification->len;) {
+		uint8_t len = notification->data[offset];
+
+		TEST_ASSERT_LESS_OR_EQUAL(notification->len,
+					  offset + SID_BLE_LOG_RECORD_HDR_SIZE + len);
+		if (notification->data[offset + 1] == type) {
+			count++;
+		}
+		offset += SID_BLE_LOG_RECORD_HDR_SIZE + len;
+	}
+
+	return count;
+}
+
+void setUp(void)
+{
+	FFF_FAKES_LIST(RESET_FAKE);
+	FFF_RESET_HISTORY();
+
+	memset(notifications, 0, sizeof(notifications));
+	notifications_cnt = 0;
+	notifications_done = 0;
+
+	bt_gatt_get_mtu_fake.return_val = TEST_MTU;
+	bt_gatt_is_subscribed_fake.return_val = true;
+	bt_gatt_notify_cb_fake.custom_fake = notify_cb_fake;
+	bt_gatt_find_by_uuid_fake.return_val = &notify_attr;
+	sid_ble_conn_active_ref_fake.return_val = &conn;
+	sid_ble_get_log_service_fake.return_val = &log_service;
+}
+
+void tearDown(void)
+{
+	while (log_process()) {
+	}
+	notifications_complete();
+
+	/* Every taken connection reference is released. */
+	TEST_ASSERT_EQUAL(sid_ble_conn_active_ref_fake.call_count, bt_conn_unref_fake.call_count);
+}
+
+void test_sid_ble_log_backend_not_subscribed(void)
+{
+	bt_gatt_is_subscribed_fake.return_val = false;
+
+	LOG_INF("not sent");
+	while (log_process()) {
+	}
+
+	TEST_ASSERT_EQUAL(0, bt_gatt_notify_cb_fake.call_count);
+	TEST_ASSERT_EQUAL(0, sid_ble_log_backend_dropped());
+}
+
+void test_sid_ble_log_backend_batching(void)
+{
+	char text[TEST_MTU];
+
+	LOG_INF("msg 0");
+	LOG_INF("msg 1");
+	while (log_process()) {
+	}
+
+	/* Both records are sent in one notification when the log buffer is empty. */
+	TEST_ASSERT_EQUAL(1, notifications_cnt);
+	TEST_ASSERT_EQUAL(2, records_count(&notifications[0], SID_BLE_LOG_RECORD_MSG));
+
+	memcpy(text, &notifications[0].data[SID_BLE_LOG_RECORD_HDR_SIZE], notifications[0].data[0]);
+	text[notifications[0].data[0]] = '\0';
+	TEST_ASSERT_NOT_NULL(strstr(text, "msg 0"));
+}
+
+void test_sid_ble_log_backend_back_pressure(void)
+{
+	struct notification *last;
+	uint32_t dropped;
+
+	for (int i = 0; i < 20; i++) {
+		LOG_INF("back pressure test message %d", i);
+	}
+	while (log_process()) {
+	}
+
+	/* Notifications are not confirmed, only the credits are used. */
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_LOG_BACKEND_BLE_TX_CREDITS, notifications_cnt);
+	dropped = sid_ble_log_backend_dropped();
+	TEST_ASSERT_GREATER_THAN(0, dropped);
+
+	/* Pending batch and drop report are sent when credits return. */
+	notifications_complete();
+	TEST_ASSERT_EQUAL(0, sid_ble_log_backend_dropped());
+
+	last = &notifications[notifications_cnt - 1];
+	TEST_ASSERT_EQUAL(1, records_count(last, SID_BLE_LOG_RECORD_DROPPED));
+	TEST_ASSERT_EQUAL(SID_BLE_LOG_RECORD_DROPPED, last->data[1]);
+	TEST_ASSERT_EQUAL(dropped, sys_get_le16(&last->data[SID_BLE_LOG_RECORD_HDR_SIZE]));
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define CONFIG_BT_MAX_CONN 2
+#define CONFIG_SIDEWALK_BLE_RX_DEFERRED 1
+#define CONFIG_SIDEWALK_BLE_RX_RING_SIZE 256
+#define CONFIG_SIDEWALK_BLE_RX_HIGH_WATERMARK 75
+#define CONFIG_SIDEWALK_BLE_RX_STACK_SIZE 2048
+#define CONFIG_SIDEWALK_BLE_RX_PRIORITY 1
@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <zephyr/fff.h>
+#include "kconfig_mock.h"
+
+#include <sid_ble_rx.h>
+#include <sid_ble_connection.h>
+#include <sid_ble_ama_service.h>
+#include <cmock_sid_ble_adapter_callbacks.h>
+
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(uint8_t, bt_conn_index, const struct bt_conn *);
+FAKE_VALUE_FUNC(bool, sid_ble_conn_rx, struct bt_conn *);
+
+FAKE_VALUE_FUNC(ssize_t, bt_gatt_attr_read_service, struct bt_conn *, const struct bt_gatt_attr *,
+		void *, uint16_t, uint16_t);
+
+FAKE_VALUE_FUNC(ssize_t, bt_gatt_attr_read_chrc, struct bt_conn *, const struct bt_gatt_attr *,
+		void *, uint16_t, uint16_t);
+
+FAKE_VALUE_FUNC(ssize_t, bt_gatt_attr_read_ccc, struct bt_conn *, const struct bt_gatt_attr *,
+		void *, uint16_t, uint16_t);
+
+FAKE_VALUE_FUNC(ssize_t, bt_gatt_attr_write_ccc, struct bt_conn *, const struct bt_gatt_attr *,
+		const void *, uint16_t, uint16_t, uint8_t);
+
+#define FFF_FAKES_LIST(FAKE)                                                                       \
+	FAKE(bt_conn_index)                                                                        \
+	FAKE(sid_ble_conn_rx)                                                                      \
+	FAKE(bt_gatt_attr_read_service)                                                            \
+	FAKE(bt_gatt_attr_read_chrc)                                                               \
+	FAKE(bt_gatt_attr_read_ccc)                                                                \
+	FAKE(bt_gatt_attr_write_ccc)
+
+#define TEST_WRITE_MAX (60)
+#define TEST_WRITES (500)
+/* A write does not wait for the protocol, the bound only allows for preemption. */
+#define TEST_WRITE_WAIT_MAX_MS (2)
+#define TEST_SLOW_PROTOCOL_MS (20)
+#define TEST_DELIVERY_TIMEOUT K_SECONDS(5)
+
+struct bt_conn {
+	uint8_t index;
+};
+
+static struct bt_conn test_conn[CONFIG_BT_MAX_CONN] = { { .index = 0 }, { .index = 1 } };
+
+static struct {
+	k_tid_t thread;
+	uint32_t count;
+	uint32_t seq_next;
+	uint32_t seq_errors;
+	uint32_t data_errors;
+	uint8_t conn_mask;
+	/* Protocol processing time, without and with yielding the CPU. */
+	uint32_t busy_us;
+	k_timeout_t sleep;
+	struct k_sem *hold;
+} rx;
+
+static uint8_t conn_index_get(const struct bt_conn *conn)
+{
+	return conn->index;
+}
+
+void setUp(void)
+{
+	FFF_FAKES_LIST(RESET_FAKE);
+	FFF_RESET_HISTORY();
+	bt_conn_index_fake.custom_fake = conn_index_get;
+	sid_ble_conn_rx_fake.return_val = true;
+
+	memset(&rx, 0, sizeof(rx));
+	rx.sleep = K_NO_WAIT;
+	sid_ble_rx_init();
+}
+
+/* Write payload: conn index, sequence number, then a pattern derived from both. */
+static uint16_t payload_make(uint8_t *buf, uint8_t conn, uint32_t seq, uint16_t length)
+{
+	buf[0] = conn;
+	memcpy(&buf[1], &seq, sizeof(seq));
+	for (uint16_t i = 1 + sizeof(seq); i < length; i++) {
+		buf[i] = (uint8_t)(seq + i + conn);
+	}
+	return length;
+}
+
+static void data_write_cb(sid_ble_cfg_service_identifier_t id, uint8_t *data, uint16_t length,
+			  int cmock_num_calls)
+{
+	uint32_t seq;
+
+	rx.thread = k_current_get();
+	rx.count++;
+	if (id != AMA_SERVICE || length < 1 + sizeof(seq)) {
+		rx.data_errors++;
+		return;
+	}
+
+	memcpy(&seq, &data[1], sizeof(seq));
+	rx.conn_mask |= BIT(data[0]);
+	if (seq != rx.seq_next) {
+		rx.seq_errors++;
+	}
+	rx.seq_next = seq + 1;
+	for (uint16_t i = 1 + sizeof(seq); i < length; i++) {
+		if (data[i] != (uint8_t)(seq + i + data[0])) {
+			rx.data_errors++;
+			break;
+		}
+	}
+
+	if (rx.hold) {
+		k_sem_take(rx.hold, K_FOREVER);
+	}
+	k_busy_wait(rx.busy_us);
+	k_sleep(rx.sleep);
+}
+
+static const struct bt_gatt_attr *write_attr_get(void)
+{
+	const struct bt_gatt_service_static *srv = sid_ble_get_ama_service();
+
+	for (size_t i = 0; i < srv->attr_count; i++) {
+		if (srv->attrs[i].write && srv->attrs[i].write != bt_gatt_attr_write_ccc) {
+			return &srv->attrs[i];
+		}
+	}
+	return NULL;
+}
+
+/* Write without response, as the Bluetooth host calls it. */
+static ssize_t gatt_write(struct bt_conn *conn, const uint8_t *buf, uint16_t length)
+{
+	const struct bt_gatt_attr *attr = write_attr_get();
+
+	TEST_ASSERT_NOT_NULL(attr);
+	return attr->write(conn, attr, buf, length, 0, BT_GATT_WRITE_FLAG_CMD);
+}
+
+static void delivery_wait(void)
+{
+	struct sid_ble_rx_stats stats;
+	int64_t end = k_uptime_get() + k_ticks_to_ms_ceil64(TEST_DELIVERY_TIMEOUT.ticks);
+
+	do {
+		k_sleep(K_MSEC(1));
+		sid_ble_rx_stats_get(&stats);
+	} while (stats.delivered + stats.flushed < stats.received && k_uptime_get() < end);
+}
+
+/******************************************************************
+* sid_ble_rx
+* ****************************************************************/
+
+void test_sid_ble_rx_deferred(void)
+{
+	struct sid_ble_rx_stats stats;
+	uint8_t buf[TEST_WRITE_MAX];
+
+	__cmock_sid_ble_adapter_data_write_StubWithCallback(data_write_cb);
+
+	for (uint32_t seq = 0; seq < 3; seq++) {
+		uint16_t length = payload_make(buf, 0, seq, 20 + seq);
+
+		TEST_ASSERT_EQUAL(length, gatt_write(&test_conn[0], buf, length));
+	}
+	TEST_ASSERT_EQUAL(3, sid_ble_conn_rx_fake.call_count);
+	delivery_wait();
+
+	TEST_ASSERT_EQUAL(3, rx.count);
+	TEST_ASSERT_EQUAL(0, rx.seq_errors);
+	TEST_ASSERT_EQUAL(0, rx.data_errors);
+	TEST_ASSERT_NOT_EQUAL(k_current_get(), rx.thread);
+
+	sid_ble_rx_stats_get(&stats);
+	TEST_ASSERT_EQUAL(3, stats.received);
+	TEST_ASSERT_EQUAL(3, stats.delivered);
+	TEST_ASSERT_EQUAL(0, stats.dropped);
+}
+
+void test_sid_ble_rx_too_long(void)
+{
+	struct sid_ble_rx_stats stats;
+	uint8_t buf[CONFIG_SIDEWALK_BLE_RX_RING_SIZE] = { 0 };
+
+	__cmock_sid_ble_adapter_data_write_StubWithCallback(data_write_cb);
+
+	TEST_ASSERT_EQUAL(BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES),
+			  gatt_write(&test_conn[0], buf, sizeof(buf)));
+	delivery_wait();
+
+	TEST_ASSERT_EQUAL(0, rx.count);
+	sid_ble_rx_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.received);
+	TEST_ASSERT_EQUAL(1, stats.dropped);
+}
+
+void test_sid_ble_rx_conn_flush(void)
+{
+	struct sid_ble_rx_stats stats;
+	struct k_sem hold;
+	uint8_t buf[TEST_WRITE_MAX];
+	uint32_t seq = 0;
+
+	k_sem_init(&hold, 0, K_SEM_MAX_LIMIT);
+	rx.hold = &hold;
+	__cmock_sid_ble_adapter_data_write_StubWithCallback(data_write_cb);
+
+	/* The first write is held in the callback, the rest waits in the ring. */
+	gatt_write(&test_conn[0], buf, payload_make(buf, 0, seq++, 16));
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(1, rx.count);
+	gatt_write(&test_conn[0], buf, payload_make(buf, 0, seq++, 16));
+	gatt_write(&test_conn[1], buf, payload_make(buf, 1, seq++, 16));
+	gatt_write(&test_conn[0], buf, payload_make(buf, 0, seq++, 16));
+	gatt_write(&test_conn[1], buf, payload_make(buf, 1, seq++, 16));
+
+	sid_ble_rx_conn_flush(&test_conn[0]);
+	rx.hold = NULL;
+	k_sem_give(&hold);
+	delivery_wait();
+
+	/* The held write and the writes of the other connection. */
+	TEST_ASSERT_EQUAL(3, rx.count);
+	TEST_ASSERT_EQUAL(BIT(0) | BIT(1), rx.conn_mask);
+	TEST_ASSERT_EQUAL(0, rx.data_errors);
+	sid_ble_rx_stats_get(&stats);
+	TEST_ASSERT_EQUAL(5, stats.received);
+	TEST_ASSERT_EQUAL(3, stats.delivered);
+	TEST_ASSERT_EQUAL(2, stats.flushed);
+}
+
+void test_sid_ble_rx_deinit_flush(void)
+{
+	struct sid_ble_rx_stats stats;
+	struct k_sem hold;
+	uint8_t buf[TEST_WRITE_MAX];
+
+	k_sem_init(&hold, 0, K_SEM_MAX_LIMIT);
+	rx.hold = &hold;
+	__cmock_sid_ble_adapter_data_write_StubWithCallback(data_write_cb);
+
+	for (uint32_t seq = 0; seq < 4; seq++) {
+		gatt_write(&test_conn[seq % 2], buf, payload_make(buf, seq % 2, seq, 32));
+		k_sleep(K_MSEC(1));
+	}
+	sid_ble_rx_deinit();
+	rx.hold = NULL;
+	k_sem_give(&hold);
+	delivery_wait();
+
+	TEST_ASSERT_EQUAL(1, rx.count);
+	sid_ble_rx_stats_get(&stats);
+	TEST_ASSERT_EQUAL(4, stats.received);
+	TEST_ASSERT_EQUAL(1, stats.delivered);
+	TEST_ASSERT_EQUAL(3, stats.flushed);
+
+	/* Init forgets the statistics. */
+	sid_ble_rx_init();
+	sid_ble_rx_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.received);
+	TEST_ASSERT_EQUAL(0, stats.flushed);
+}
+
+static K_SEM_DEFINE(space_sem, 0, K_SEM_MAX_LIMIT);
+
+static void space_cb(void)
+{
+	k_sem_give(&space_sem);
+}
+
+void test_sid_ble_rx_try_put_held(void)
+{
+	struct sid_ble_rx_stats stats;
+	struct k_sem hold;
+	uint8_t buf[TEST_WRITE_MAX];
+	uint32_t seq = 0;
+	int err;
+
+	k_sem_init(&hold, 0, K_SEM_MAX_LIMIT);
+	k_sem_reset(&space_sem);
+	rx.hold = &hold;
+	__cmock_sid_ble_adapter_data_write_StubWithCallback(data_write_cb);
+
+	/* The first write is held in the callback, the rest fills the ring. */
+	do {
+		err = sid_ble_rx_try_put(&test_conn[0], AMA_SERVICE, buf,
+					 payload_make(buf, 0, seq, TEST_WRITE_MAX), space_cb);
+		if (!err) {
+			seq++;
+		}
+		k_sleep(K_MSEC(1));
+	} while (!err);
+	TEST_ASSERT_EQUAL(-EAGAIN, err);
+	TEST_ASSERT_EQUAL(-EINVAL, sid_ble_rx_try_put(&test_conn[0], AMA_SERVICE, buf,
+						      TEST_WRITE_MAX, NULL));
+	TEST_ASSERT_EQUAL(0, k_sem_count_get(&space_sem));
+
+	/* Releasing the held write calls the callback once, the data is not lost. */
+	rx.hold = NULL;
+	k_sem_give(&hold);
+	TEST_ASSERT_EQUAL(0, k_sem_take(&space_sem, TEST_DELIVERY_TIMEOUT));
+	TEST_ASSERT_EQUAL(0, sid_ble_rx_try_put(&test_conn[0], AMA_SERVICE, buf,
+						payload_make(buf, 0, seq++, TEST_WRITE_MAX),
+						space_cb));
+	delivery_wait();
+	TEST_ASSERT_EQUAL(0, k_sem_count_get(&space_sem));
+
+	TEST_ASSERT_EQUAL(seq, rx.count);
+	TEST_ASSERT_EQUAL(0, rx.seq_errors);
+	TEST_ASSERT_EQUAL(0, rx.data_errors);
+	sid_ble_rx_stats_get(&stats);
+	TEST_ASSERT_EQUAL(seq, stats.delivered);
+	TEST_ASSERT_EQUAL(0, stats.dropped);
+	TEST_ASSERT_GREATER_THAN(0, stats.throttled);
+}
+
+static void flood(uint32_t *accepted, int64_t *write_max_ms)
+{
+	uint8_t buf[TEST_WRITE_MAX];
+
+	*accepted = 0;
+	*write_max_ms = 0;
+	__cmock_sid_ble_adapter_data_write_StubWithCallback(data_write_cb);
+
+	for (uint32_t i = 0; i < TEST_WRITES; i++) {
+		uint8_t conn = i % CONFIG_BT_MAX_CONN;
+		/* Lengths from a few bytes up to a quarter of the ring. */
+		uint16_t length = 8 + (i * 37) % (TEST_WRITE_MAX - 8);
+		int64_t start = k_uptime_get();
+		ssize_t ret;
+
+		/* Accepted writes get consecutive sequence numbers, so gaps show loss. */
+		ret = gatt_write(&test_conn[conn], buf, payload_make(buf, conn, *accepted, length));
+		*write_max_ms = MAX(*write_max_ms, k_uptime_get() - start);
+		if (ret == length) {
+			(*accepted)++;
+		} else {
+			TEST_ASSERT_EQUAL(BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES), ret);
+		}
+	}
+	delivery_wait();
+}
+
+void test_sid_ble_rx_flood(void)
+{
+	struct sid_ble_rx_stats stats;
+	uint32_t accepted;
+	int64_t write_max_ms;
+
+	/* The protocol keeps up, writes above the high watermark are dropped. */
+	rx.busy_us = 100;
+	flood(&accepted, &write_max_ms);
+
+	sid_ble_rx_stats_get(&stats);
+	TEST_ASSERT_EQUAL(TEST_WRITES, stats.received + stats.dropped);
+	TEST_ASSERT_EQUAL(accepted, stats.received);
+	TEST_ASSERT_EQUAL(stats.received, stats.delivered);
+	TEST_ASSERT_EQUAL(accepted, rx.count);
+	TEST_ASSERT_EQUAL(stats.throttled, stats.dropped);
+	TEST_ASSERT_LESS_OR_EQUAL(CONFIG_SIDEWALK_BLE_RX_RING_SIZE, stats.peak_fill);
+	TEST_ASSERT_LESS_OR_EQUAL(TEST_WRITE_WAIT_MAX_MS, write_max_ms);
+	TEST_ASSERT_EQUAL(0, rx.seq_errors);
+	TEST_ASSERT_EQUAL(0, rx.data_errors);
+}
+
+void test_sid_ble_rx_flood_slow_protocol(void)
+{
+	struct sid_ble_rx_stats stats;
+	uint32_t accepted;
+	int64_t write_max_ms;
+
+	/* The protocol is slow, writes are dropped but the writer is never blocked and the
+	 * accepted data stays intact.
+	 */
+	rx.sleep = K_MSEC(TEST_SLOW_PROTOCOL_MS);
+	flood(&accepted, &write_max_ms);
+
+	sid_ble_rx_stats_get(&stats);
+	TEST_ASSERT_EQUAL(TEST_WRITES, stats.received + stats.dropped);
+	TEST_ASSERT_EQUAL(accepted, stats.received);
+	TEST_ASSERT_EQUAL(stats.received, stats.delivered);
+	TEST_ASSERT_EQUAL(accepted, rx.count);
+	TEST_ASSERT_GREATER_THAN(0, stats.dropped);
+	TEST_ASSERT_EQUAL(stats.throttled, stats.dropped);
+	TEST_ASSERT_LESS_OR_EQUAL(CONFIG_SIDEWALK_BLE_RX_RING_SIZE, stats.peak_fill);
+	TEST_ASSERT_LESS_OR_EQUAL(TEST_WRITE_WAIT_MAX_MS, write_max_ms);
+	TEST_ASSERT_EQUAL(0, rx.seq_errors);
+	TEST_ASSERT_EQUAL(0, rx.data_errors);
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
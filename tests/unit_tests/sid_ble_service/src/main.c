@@ -5,6 +5,7 @@
  */
 #include <unity.h>
 #include <zephyr/fff.h>
+#include "kconfig_mock.h"
 
 #include <sid_ble_service.h>
 #include <sid_ble_connection.h>
@@ -12,6 +13,7 @@
 #include <cmock_sid_ble_adapter_callbacks.h>
 
 #include <zephyr/bluetooth/conn.h>
+#include <zephyr/kernel.h>
 
 #include <stdbool.h>
 
@@ -23,6 +25,9 @@ FAKE_VALUE_FUNC(bool, bt_gatt_is_subscribed, struct bt_conn *, const struct bt_g
 FAKE_VALUE_FUNC(int, bt_gatt_notify_cb, struct bt_conn *, struct bt_gatt_notify_params *);
 FAKE_VALUE_FUNC(struct bt_gatt_attr *, bt_gatt_find_by_uuid, const struct bt_gatt_attr *, uint16_t,
 		const struct bt_uuid *);
+FAKE_VOID_FUNC(bt_conn_cb_register, struct bt_conn_cb *);
+FAKE_VALUE_FUNC(uint8_t, bt_conn_index, const struct bt_conn *);
+FAKE_VALUE_FUNC(bool, sid_ble_conn_rx, struct bt_conn *);
 
 FAKE_VALUE_FUNC(ssize_t, bt_gatt_attr_read_service, struct bt_conn *, const struct bt_gatt_attr *,
 		void *, uint16_t, uint16_t);
@@ -41,6 +46,9 @@ FAKE_VALUE_FUNC(ssize_t, bt_gatt_attr_write_ccc, struct bt_conn *, const struct
 	FAKE(bt_gatt_is_subscribed)                                                                \
 	FAKE(bt_gatt_notify_cb)                                                                    \
 	FAKE(bt_gatt_find_by_uuid)                                                                 \
+	FAKE(bt_conn_cb_register)                                                                  \
+	FAKE(bt_conn_index)                                                                        \
+	FAKE(sid_ble_conn_rx)                                                                      \
 	FAKE(bt_gatt_attr_read_service)                                                            \
 	FAKE(bt_gatt_attr_read_chrc)                                                               \
 	FAKE(bt_gatt_attr_read_ccc)                                                                \
@@ -52,12 +60,32 @@ struct bt_conn {
 	uint8_t dummy;
 };
 
+static struct bt_conn_cb *conn_cb;
+
 void setUp(void)
 {
 	FFF_FAKES_LIST(RESET_FAKE);
 	FFF_RESET_HISTORY();
 }
 
+static void notification_complete(struct bt_conn *conn, int call)
+{
+	struct bt_gatt_notify_params *notify_params = bt_gatt_notify_cb_fake.arg1_history[call];
+
+	notify_params->func(conn, notify_params->user_data);
+}
+
+static void notify_attr_init(struct bt_gatt_attr *attr)
+{
+	bt_gatt_find_by_uuid_fake.return_val = attr;
+	TEST_ASSERT_EQUAL(0, sid_ble_service_init());
+	if (bt_conn_cb_register_fake.call_count) {
+		conn_cb = bt_conn_cb_register_fake.arg0_val;
+	}
+	TEST_ASSERT_EQUAL(1, bt_gatt_find_by_uuid_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(sid_ble_get_ama_service()->attrs, bt_gatt_find_by_uuid_fake.arg0_val);
+}
+
 void test_sid_ble_send_data_null_ptr(void)
 {
 	uint8_t data[TEST_DATA_CHUNK];
@@ -68,7 +96,6 @@ void test_sid_ble_send_data_null_ptr(void)
 void test_sid_ble_send_data_pass(void)
 {
 	struct bt_gatt_notify_params *notify_params;
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	struct bt_gatt_attr attr;
@@ -77,34 +104,35 @@ void test_sid_ble_send_data_pass(void)
 	__cmock_sid_ble_adapter_notification_sent_Expect();
 
 	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
+	params.id = AMA_SERVICE;
 
-	bt_gatt_find_by_uuid_fake.return_val = &attr;
+	notify_attr_init(&attr);
 	bt_gatt_get_mtu_fake.return_val = sizeof(data);
 	bt_gatt_is_subscribed_fake.return_val = true;
 	bt_gatt_notify_cb_fake.return_val = 0;
 	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	k_sleep(K_MSEC(1));
 
 	TEST_ASSERT_NOT_NULL(bt_gatt_notify_cb_fake.arg1_val);
 	if (NULL != bt_gatt_notify_cb_fake.arg1_val) {
 		notify_params = (struct bt_gatt_notify_params *)bt_gatt_notify_cb_fake.arg1_val;
-		notify_params->func(&conn, NULL);
+		TEST_ASSERT_EQUAL_PTR(data, notify_params->data);
+		TEST_ASSERT_EQUAL(sizeof(data), notify_params->len);
+		notify_params->func(&conn, notify_params->user_data);
 	}
 }
 
 void test_sid_ble_send_data_attr_fail(void)
 {
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	uint8_t data[TEST_DATA_CHUNK];
 
 	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
+	params.id = AMA_SERVICE;
 
 	bt_gatt_find_by_uuid_fake.return_val = NULL;
+	TEST_ASSERT_EQUAL(-ENOENT, sid_ble_service_init());
 	bt_gatt_get_mtu_fake.return_val = sizeof(data);
 	bt_gatt_is_subscribed_fake.return_val = true;
 	bt_gatt_notify_cb_fake.return_val = 0;
@@ -113,17 +141,15 @@ void test_sid_ble_send_data_attr_fail(void)
 
 void test_sid_ble_send_data_wo_subscription(void)
 {
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	struct bt_gatt_attr attr;
 	uint8_t data[TEST_DATA_CHUNK];
 
 	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
+	params.id = AMA_SERVICE;
 
-	bt_gatt_find_by_uuid_fake.return_val = &attr;
+	notify_attr_init(&attr);
 	bt_gatt_get_mtu_fake.return_val = sizeof(data);
 	bt_gatt_is_subscribed_fake.return_val = false;
 	bt_gatt_notify_cb_fake.return_val = 0;
@@ -132,17 +158,15 @@ void test_sid_ble_send_data_wo_subscription(void)
 
 void test_sid_ble_send_data_incorrect_data_len(void)
 {
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	struct bt_gatt_attr attr;
 	uint8_t data[TEST_DATA_CHUNK];
 
 	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
+	params.id = AMA_SERVICE;
 
-	bt_gatt_find_by_uuid_fake.return_val = &attr;
+	notify_attr_init(&attr);
 	bt_gatt_get_mtu_fake.return_val = sizeof(data) - 5;
 	bt_gatt_is_subscribed_fake.return_val = false;
 	bt_gatt_notify_cb_fake.return_val = 0;
@@ -154,7 +178,6 @@ void test_sid_ble_send_data_incorrect_data_len(void)
 
 void test_sid_ble_send_data_fail(void)
 {
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	struct bt_gatt_attr attr;
@@ -162,10 +185,9 @@ void test_sid_ble_send_data_fail(void)
 	uint8_t data[TEST_DATA_CHUNK];
 
 	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
+	params.id = AMA_SERVICE;
 
-	bt_gatt_find_by_uuid_fake.return_val = &attr;
+	notify_attr_init(&attr);
 	bt_gatt_get_mtu_fake.return_val = sizeof(data);
 	bt_gatt_is_subscribed_fake.return_val = true;
 	bt_gatt_notify_cb_fake.return_val = test_error_code;
@@ -174,17 +196,15 @@ void test_sid_ble_send_data_fail(void)
 
 void test_sid_ble_send_data_incorrect_arguments(void)
 {
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	struct bt_gatt_attr attr;
 	uint8_t data[TEST_DATA_CHUNK];
 
 	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
+	params.id = AMA_SERVICE;
 
-	bt_gatt_find_by_uuid_fake.return_val = &attr;
+	notify_attr_init(&attr);
 	bt_gatt_get_mtu_fake.return_val = sizeof(data);
 	bt_gatt_is_subscribed_fake.return_val = false;
 	bt_gatt_notify_cb_fake.return_val = 0;
@@ -193,6 +213,173 @@ void test_sid_ble_send_data_incorrect_arguments(void)
 	TEST_ASSERT_EQUAL(-EINVAL, sid_ble_send_data(&params, NULL, sizeof(data)));
 }
 
+void test_sid_ble_send_data_no_lookup(void)
+{
+	struct bt_gatt_notify_params *notify_params;
+	struct bt_conn conn;
+	sid_ble_srv_params_t params;
+	struct bt_gatt_attr attr;
+	uint8_t data[TEST_DATA_CHUNK];
+
+	params.conn = &conn;
+	params.id = AMA_SERVICE;
+
+	__cmock_sid_ble_adapter_notification_sent_Ignore();
+
+	notify_attr_init(&attr);
+	RESET_FAKE(bt_gatt_find_by_uuid);
+	bt_gatt_get_mtu_fake.return_val = sizeof(data);
+	bt_gatt_is_subscribed_fake.return_val = true;
+	bt_gatt_notify_cb_fake.return_val = 0;
+
+	for (int i = 0; i < 3; i++) {
+		TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+		notification_complete(&conn, i);
+	}
+	k_sleep(K_MSEC(1));
+
+	TEST_ASSERT_EQUAL(0, bt_gatt_find_by_uuid_fake.call_count);
+	TEST_ASSERT_EQUAL(3, bt_gatt_notify_cb_fake.call_count);
+	notify_params = (struct bt_gatt_notify_params *)bt_gatt_notify_cb_fake.arg1_val;
+	TEST_ASSERT_EQUAL_PTR(&attr, notify_params->attr);
+	TEST_ASSERT_EQUAL_PTR(&attr, bt_gatt_is_subscribed_fake.arg1_val);
+}
+
+void test_sid_ble_send_data_unknown_service(void)
+{
+	struct bt_conn conn;
+	sid_ble_srv_params_t params;
+	struct bt_gatt_attr attr;
+	uint8_t data[TEST_DATA_CHUNK];
+
+	params.conn = &conn;
+	params.id = LOGGING_SERVICE + 1;
+
+	notify_attr_init(&attr);
+	bt_gatt_get_mtu_fake.return_val = sizeof(data);
+	bt_gatt_is_subscribed_fake.return_val = true;
+	TEST_ASSERT_EQUAL(-ENOENT, sid_ble_send_data(&params, data, sizeof(data)));
+	TEST_ASSERT_EQUAL(0, bt_gatt_notify_cb_fake.call_count);
+}
+
+void test_sid_ble_send_data_pipelined(void)
+{
+	struct bt_conn conn;
+	sid_ble_srv_params_t params;
+	struct bt_gatt_attr attr;
+	uint8_t data[TEST_DATA_CHUNK];
+
+	params.conn = &conn;
+	params.id = AMA_SERVICE;
+
+	notify_attr_init(&attr);
+	bt_gatt_get_mtu_fake.return_val = sizeof(data);
+	bt_gatt_is_subscribed_fake.return_val = true;
+	bt_gatt_notify_cb_fake.return_val = 0;
+
+	/* A credit is left, the first notification is acknowledged before it is sent. */
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	k_sleep(K_MSEC(1));
+
+	/* The last credit is taken, the acknowledge waits for a completion. */
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(-EBUSY, sid_ble_send_data(&params, data, sizeof(data)));
+	TEST_ASSERT_EQUAL(2, bt_gatt_notify_cb_fake.call_count);
+
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	notification_complete(&conn, 0);
+
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	notification_complete(&conn, 1);
+	notification_complete(&conn, 2);
+	k_sleep(K_MSEC(1));
+}
+
+void test_sid_ble_send_data_disconnected(void)
+{
+	struct bt_conn conn;
+	sid_ble_srv_params_t params;
+	struct bt_gatt_attr attr;
+	uint8_t data[TEST_DATA_CHUNK];
+
+	params.conn = &conn;
+	params.id = AMA_SERVICE;
+
+	notify_attr_init(&attr);
+	TEST_ASSERT_NOT_NULL(conn_cb);
+	bt_gatt_get_mtu_fake.return_val = sizeof(data);
+	bt_gatt_is_subscribed_fake.return_val = true;
+	bt_gatt_notify_cb_fake.return_val = 0;
+
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	TEST_ASSERT_EQUAL(-EBUSY, sid_ble_send_data(&params, data, sizeof(data)));
+
+	/* Credits are restored, late completions are ignored. */
+	conn_cb->disconnected(&conn, 0);
+	notification_complete(&conn, 0);
+	notification_complete(&conn, 1);
+
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	TEST_ASSERT_EQUAL(-EBUSY, sid_ble_send_data(&params, data, sizeof(data)));
+	conn_cb->disconnected(&conn, 0);
+}
+
+static struct bt_conn test_conns[2];
+
+static uint8_t test_conn_index(const struct bt_conn *conn)
+{
+	return (uint8_t)(conn - test_conns);
+}
+
+void test_sid_ble_send_data_per_connection(void)
+{
+	sid_ble_srv_params_t params[] = {
+		{ .conn = &test_conns[0], .id = AMA_SERVICE },
+		{ .conn = &test_conns[1], .id = AMA_SERVICE },
+	};
+	struct bt_gatt_attr attr;
+	uint8_t data[TEST_DATA_CHUNK];
+
+	notify_attr_init(&attr);
+	bt_conn_index_fake.custom_fake = test_conn_index;
+	bt_gatt_get_mtu_fake.return_val = sizeof(data);
+	bt_gatt_is_subscribed_fake.return_val = true;
+	bt_gatt_notify_cb_fake.return_val = 0;
+
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params[1], data, sizeof(data)));
+	k_sleep(K_MSEC(1));
+
+	/* The credits of the first connection are used up, the second one keeps its own. */
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params[0], data, sizeof(data)));
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params[0], data, sizeof(data)));
+	TEST_ASSERT_EQUAL(-EBUSY, sid_ble_send_data(&params[0], data, sizeof(data)));
+
+	/* Completion and disconnection of the second connection do not touch the first one. */
+	notification_complete(&test_conns[1], 0);
+	conn_cb->disconnected(&test_conns[1], 0);
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(-EBUSY, sid_ble_send_data(&params[0], data, sizeof(data)));
+
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	notification_complete(&test_conns[0], 1);
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params[0], data, sizeof(data)));
+	TEST_ASSERT_EQUAL(4, bt_gatt_notify_cb_fake.call_count);
+
+	conn_cb->disconnected(&test_conns[0], 0);
+}
+
 extern int unity_main(void);
 
 int main(void)
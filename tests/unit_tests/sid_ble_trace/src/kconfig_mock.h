@@ -0,0 +1,9 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define CONFIG_BT_MAX_CONN 2
+#define CONFIG_SIDEWALK_BLE_TRACE 1
+#define CONFIG_SIDEWALK_BLE_NOTIFY_TX_CREDITS 3
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <zephyr/fff.h>
+#include "kconfig_mock.h"
+
+#include <sid_ble_trace.h>
+
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/kernel.h>
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(uint8_t, bt_conn_index, const struct bt_conn *);
+
+#define TEST_LATENCY_US (100)
+/* Longer than the gap between completions of one connection event. */
+#define TEST_EVENT_INTERVAL_US (7500)
+
+struct bt_conn {
+	uint8_t index;
+};
+
+static struct bt_conn test_conn[CONFIG_BT_MAX_CONN] = { { .index = 0 }, { .index = 1 } };
+
+static uint8_t conn_index_get(const struct bt_conn *conn)
+{
+	return conn->index;
+}
+
+void setUp(void)
+{
+	RESET_FAKE(bt_conn_index);
+	FFF_RESET_HISTORY();
+	bt_conn_index_fake.custom_fake = conn_index_get;
+
+	for (size_t i = 0; i < ARRAY_SIZE(test_conn); i++) {
+		sid_ble_trace_conn_reset(&test_conn[i]);
+	}
+	sid_ble_trace_reset();
+}
+
+/******************************************************************
+* sid_ble_trace
+* ****************************************************************/
+
+void test_sid_ble_trace_rx_dispatch(void)
+{
+	struct sid_ble_trace_stats stats;
+	const struct sid_ble_trace_latency_stats *rx = &stats.latency[SID_BLE_TRACE_RX_DISPATCH];
+
+	sid_ble_trace_rx_write();
+	k_busy_wait(TEST_LATENCY_US);
+	sid_ble_trace_rx_dispatch();
+
+	sid_ble_trace_snapshot(&stats);
+	TEST_ASSERT_EQUAL(1, rx->count);
+	TEST_ASSERT_GREATER_OR_EQUAL(TEST_LATENCY_US, rx->max_us);
+	TEST_ASSERT_EQUAL(rx->max_us, rx->total_us);
+	/* 100 us is in [64, 128) us. */
+	TEST_ASSERT_EQUAL(1, rx->hist[6]);
+	TEST_ASSERT_EQUAL(0, stats.latency[SID_BLE_TRACE_TX_SENT].count);
+}
+
+void test_sid_ble_trace_rx_deferred(void)
+{
+	struct sid_ble_trace_stats stats;
+	uint32_t stamp;
+
+	/* The stamp of a write travels with the data to the thread calling the protocol. */
+	sid_ble_trace_rx_write();
+	stamp = sid_ble_trace_rx_stamp();
+	k_busy_wait(TEST_LATENCY_US);
+	sid_ble_trace_rx_write();
+
+	sid_ble_trace_rx_deliver(stamp);
+	sid_ble_trace_rx_dispatch();
+
+	sid_ble_trace_snapshot(&stats);
+	TEST_ASSERT_EQUAL(1, stats.latency[SID_BLE_TRACE_RX_DISPATCH].count);
+	TEST_ASSERT_GREATER_OR_EQUAL(TEST_LATENCY_US,
+				     stats.latency[SID_BLE_TRACE_RX_DISPATCH].max_us);
+}
+
+void test_sid_ble_trace_tx_sent(void)
+{
+	struct sid_ble_trace_stats stats;
+	const struct sid_ble_trace_latency_stats *tx = &stats.latency[SID_BLE_TRACE_TX_SENT];
+
+	sid_ble_trace_tx_submit(&test_conn[0], SID_BLE_TRACE_GATT);
+	k_busy_wait(TEST_LATENCY_US);
+	sid_ble_trace_tx_submit(&test_conn[0], SID_BLE_TRACE_GATT);
+	sid_ble_trace_tx_submit(&test_conn[0], SID_BLE_TRACE_GATT);
+	sid_ble_trace_tx_cancel(&test_conn[0], SID_BLE_TRACE_GATT);
+
+	/* Completed in order, the first waited longest. */
+	sid_ble_trace_tx_sent(&test_conn[0], SID_BLE_TRACE_GATT);
+	sid_ble_trace_tx_sent(&test_conn[0], SID_BLE_TRACE_GATT);
+	/* Nothing in flight. */
+	sid_ble_trace_tx_sent(&test_conn[0], SID_BLE_TRACE_GATT);
+
+	sid_ble_trace_snapshot(&stats);
+	TEST_ASSERT_EQUAL(2, tx->count);
+	TEST_ASSERT_GREATER_OR_EQUAL(TEST_LATENCY_US, tx->max_us);
+	TEST_ASSERT_LESS_THAN(2 * TEST_LATENCY_US, tx->total_us);
+	TEST_ASSERT_EQUAL(0, stats.events);
+}
+
+void test_sid_ble_trace_tx_transports(void)
+{
+	struct sid_ble_trace_stats stats;
+	const struct sid_ble_trace_latency_stats *tx = &stats.latency[SID_BLE_TRACE_TX_SENT];
+
+	/* The SDU is submitted later but completes first, it is matched with its own stamp. */
+	sid_ble_trace_tx_submit(&test_conn[0], SID_BLE_TRACE_GATT);
+	k_busy_wait(TEST_LATENCY_US);
+	sid_ble_trace_tx_submit(&test_conn[0], SID_BLE_TRACE_L2CAP);
+	sid_ble_trace_tx_sent(&test_conn[0], SID_BLE_TRACE_L2CAP);
+
+	sid_ble_trace_snapshot(&stats);
+	TEST_ASSERT_EQUAL(1, tx->count);
+	TEST_ASSERT_LESS_THAN(TEST_LATENCY_US, tx->max_us);
+
+	sid_ble_trace_tx_sent(&test_conn[0], SID_BLE_TRACE_GATT);
+	sid_ble_trace_snapshot(&stats);
+	TEST_ASSERT_EQUAL(2, tx->count);
+	TEST_ASSERT_GREATER_OR_EQUAL(TEST_LATENCY_US, tx->max_us);
+
+	/* A cancel only takes back a packet of its transport. */
+	sid_ble_trace_tx_submit(&test_conn[0], SID_BLE_TRACE_GATT);
+	sid_ble_trace_tx_cancel(&test_conn[0], SID_BLE_TRACE_L2CAP);
+	sid_ble_trace_tx_sent(&test_conn[0], SID_BLE_TRACE_GATT);
+	sid_ble_trace_snapshot(&stats);
+	TEST_ASSERT_EQUAL(3, tx->count);
+}
+
+void test_sid_ble_trace_notify_per_event(void)
+{
+	struct sid_ble_trace_stats stats;
+
+	/* Three notifications in one event, one in the next. */
+	for (int i = 0; i < 3; i++) {
+		sid_ble_trace_tx_submit(&test_conn[0], SID_BLE_TRACE_GATT);
+	}
+	for (int i = 0; i < 3; i++) {
+		sid_ble_trace_tx_sent(&test_conn[0], SID_BLE_TRACE_GATT);
+	}
+	k_busy_wait(TEST_EVENT_INTERVAL_US);
+	sid_ble_trace_tx_submit(&test_conn[0], SID_BLE_TRACE_GATT);
+	sid_ble_trace_tx_sent(&test_conn[0], SID_BLE_TRACE_GATT);
+
+	/* The other connection has its own events. */
+	sid_ble_trace_tx_submit(&test_conn[1], SID_BLE_TRACE_GATT);
+	sid_ble_trace_tx_sent(&test_conn[1], SID_BLE_TRACE_GATT);
+
+	sid_ble_trace_snapshot(&stats);
+	TEST_ASSERT_EQUAL(1, stats.events);
+	TEST_ASSERT_EQUAL(1, stats.notify_per_event[2]);
+
+	/* Open events are closed on disconnection. */
+	sid_ble_trace_conn_reset(&test_conn[0]);
+	sid_ble_trace_conn_reset(&test_conn[1]);
+	sid_ble_trace_snapshot(&stats);
+	TEST_ASSERT_EQUAL(3, stats.events);
+	TEST_ASSERT_EQUAL(2, stats.notify_per_event[0]);
+	TEST_ASSERT_EQUAL(1, stats.notify_per_event[2]);
+	TEST_ASSERT_EQUAL(5, stats.latency[SID_BLE_TRACE_TX_SENT].count);
+}
+
+void test_sid_ble_trace_conn_reset(void)
+{
+	struct sid_ble_trace_stats stats;
+
+	sid_ble_trace_tx_submit(&test_conn[0], SID_BLE_TRACE_GATT);
+	sid_ble_trace_tx_submit(&test_conn[0], SID_BLE_TRACE_GATT);
+	sid_ble_trace_conn_reset(&test_conn[0]);
+
+	/* Completions of the old connection are not matched with new notifications. */
+	sid_ble_trace_tx_sent(&test_conn[0], SID_BLE_TRACE_GATT);
+	sid_ble_trace_snapshot(&stats);
+	TEST_ASSERT_EQUAL(0, stats.latency[SID_BLE_TRACE_TX_SENT].count);
+
+	sid_ble_trace_reset();
+	sid_ble_trace_conn_reset(&test_conn[0]);
+	sid_ble_trace_snapshot(&stats);
+	TEST_ASSERT_EQUAL(0, stats.events);
+}
+
+void test_sid_ble_trace_latency_name(void)
+{
+	TEST_ASSERT_EQUAL_STRING("rx_dispatch", sid_ble_trace_latency_name(SID_BLE_TRACE_RX_DISPATCH));
+	TEST_ASSERT_EQUAL_STRING("tx_sent", sid_ble_trace_latency_name(SID_BLE_TRACE_TX_SENT));
+	TEST_ASSERT_EQUAL_STRING("unknown", sid_ble_trace_latency_name(SID_BLE_TRACE_LATENCY_COUNT));
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
@@ -9,4 +9,16 @@
 
 int nordic_dfu_ble_start(void);
 
+#if defined(CONFIG_SIDEWALK_DFU_ADV_SET)
+/**
+ * @brief Advertise the DFU service on its own set while Sidewalk runs.
+ *
+ * Does not enter DFU mode and does not arm the DFU timeouts. Bluetooth has to be enabled,
+ * the set is lost when it is disabled, so call it again after Sidewalk is started.
+ *
+ * @return 0 on success, negative error code otherwise.
+ */
+int nordic_dfu_ble_adv_start(void);
+#endif /* CONFIG_SIDEWALK_DFU_ADV_SET */
+
 #endif /* NORDIC_DFU_H */
@@ -100,6 +100,52 @@ static struct mgmt_callback dfu_mode_mgmt_cb = {
 		    MGMT_EVT_OP_IMG_MGMT_DFU_PENDING | MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK,
 };
 
+#if defined(CONFIG_SIDEWALK_DFU_ADV_SET)
+/* A set of its own, so the DFU service advertises together with Sidewalk. */
+static int dfu_adv_start(void)
+{
+	static struct bt_le_ext_adv *adv;
+	int err;
+
+	/* The host forgets its sets on bt_disable(), the set is created again on every start. */
+	if (adv) {
+		(void)bt_le_ext_adv_stop(adv);
+		(void)bt_le_ext_adv_delete(adv);
+		adv = NULL;
+	}
+
+	err = bt_le_ext_adv_create(BT_LE_ADV_CONN_NAME, NULL, &adv);
+	if (err) {
+		return err;
+	}
+
+	err = bt_le_ext_adv_set_data(adv, ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err) {
+		return err;
+	}
+
+	return bt_le_ext_adv_start(adv, BT_LE_EXT_ADV_START_DEFAULT);
+}
+
+int nordic_dfu_ble_adv_start(void)
+{
+	int err = dfu_adv_start();
+
+	if (err) {
+		LOG_ERR("DFU advertising start failed (err %d)", err);
+		return err;
+	}
+
+	LOG_INF("DFU advertising started");
+	return 0;
+}
+#else
+static int dfu_adv_start(void)
+{
+	return bt_le_adv_start(BT_LE_ADV_CONN_NAME, ad, ARRAY_SIZE(ad), NULL, 0);
+}
+#endif /* CONFIG_SIDEWALK_DFU_ADV_SET */
+
 int nordic_dfu_ble_start(void)
 {
 	LOG_INF("Entering into DFU mode");
@@ -119,7 +165,7 @@ int nordic_dfu_ble_start(void)
 		return err;
 	}
 
-	err = bt_le_adv_start(BT_LE_ADV_CONN_NAME, ad, ARRAY_SIZE(ad), NULL, 0);
+	err = dfu_adv_start();
 	if (err) {
 		LOG_ERR("Bluetooth advertising start failed (err %d)", err);
 		return err;